@@ -0,0 +1,68 @@
+#ifndef RMW_INTROSPECT_COMPONENT_HOST__COMPONENT_HOST_HPP_
+#define RMW_INTROSPECT_COMPONENT_HOST__COMPONENT_HOST_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace rmw_introspect_component_host {
+
+/// An rclcpp component: its class name and the library registering it
+struct ComponentSpec {
+  std::string plugin;  // e.g. "demo_nodes_cpp::Talker"
+  std::string library; // Absolute path of the shared library
+};
+
+/// How components are instantiated and where their interfaces are written
+struct HostOptions {
+  std::string output_dir = ".";
+  /// json, yaml, csv or binary, like RMW_INTROSPECT_FORMAT
+  std::string format = "json";
+  /// Spin each component this long before exporting, for entities created
+  /// by timers or callbacks after construction
+  std::chrono::milliseconds spin{0};
+  /// Node arguments, e.g. {"--ros-args", "-r", "__ns:=/robot"}
+  std::vector<std::string> node_arguments;
+};
+
+/// Outcome of introspecting one component
+struct ComponentReport {
+  std::string plugin;
+  bool success = false;
+  std::string error;       // Empty on success
+  std::string output_path; // Empty if nothing was written
+  size_t nodes = 0;
+  size_t publishers = 0;
+  size_t subscriptions = 0;
+  size_t services = 0;
+  size_t clients = 0;
+  double elapsed_ms = 0.0;
+};
+
+/// Components `package` registers in the ament index (rclcpp_components)
+/// @throws std::runtime_error if the package registers none
+std::vector<ComponentSpec> find_components(const std::string &package);
+
+/// Output file of a component: "demo_nodes_cpp::Talker" ->
+/// "<output_dir>/demo_nodes_cpp__Talker.json" (".yaml", ".bin" by format)
+std::string component_output_path(const HostOptions &options,
+                                  const std::string &plugin);
+
+/// Whether the process runs under rmw_introspect_cpp
+bool under_introspect_rmw();
+
+/// Instantiate each component in turn under the introspect RMW and export
+/// its interfaces, clearing IntrospectionData in between
+///
+/// rclcpp must be initialized with RMW_IMPLEMENTATION=rmw_introspect_cpp.
+/// Libraries stay loaded until the call returns, so components sharing one
+/// are loaded once. A component that fails to load or throws from its
+/// constructor is reported and the others still run.
+std::vector<ComponentReport>
+introspect_components(const std::vector<ComponentSpec> &components,
+                      const HostOptions &options);
+
+} // namespace rmw_introspect_component_host
+
+#endif // RMW_INTROSPECT_COMPONENT_HOST__COMPONENT_HOST_HPP_
@@ -0,0 +1,156 @@
+#include "rmw_introspect_component_host/component_host.hpp"
+#include "ament_index_cpp/get_resource.hpp"
+#include "class_loader/class_loader.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_components/node_factory.hpp"
+#include "rmw/rmw.h"
+#include "rmw_introspect/data.hpp"
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace rmw_introspect_component_host {
+
+namespace {
+
+/// Write the recorded interfaces in `format`
+bool export_component(rmw_introspect::IntrospectionData &data,
+                      const std::string &format, const std::string &path) {
+  if (format == "binary") {
+    return data.export_to_binary(path);
+  } else if (format == "yaml") {
+    return data.export_to_yaml(path);
+  } else if (format == "csv") {
+    return data.export_to_csv(path);
+  }
+  return data.export_to_json(path);
+}
+
+/// Spin a component's node so timers and callbacks can create entities
+void spin_for(
+    const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr &node,
+    std::chrono::milliseconds duration) {
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  for (auto now = std::chrono::steady_clock::now();
+       now < deadline && rclcpp::ok(); now = std::chrono::steady_clock::now()) {
+    executor.spin_once(deadline - now);
+  }
+  executor.remove_node(node);
+}
+
+} // namespace
+
+std::vector<ComponentSpec> find_components(const std::string &package) {
+  std::string content;
+  std::string base_path;
+  if (!ament_index_cpp::get_resource("rclcpp_components", package, content,
+                                     &base_path)) {
+    throw std::runtime_error("package '" + package +
+                             "' does not register any rclcpp components");
+  }
+
+  // One "<plugin>;<library>" line per component, the library relative to
+  // the package prefix unless absolute
+  std::vector<ComponentSpec> components;
+  std::istringstream lines(content);
+  std::string line;
+  while (std::getline(lines, line)) {
+    const size_t separator = line.find(';');
+    if (separator == std::string::npos) {
+      continue;
+    }
+    ComponentSpec spec;
+    spec.plugin = line.substr(0, separator);
+    spec.library = line.substr(separator + 1);
+    if (!spec.library.empty() && spec.library.front() != '/') {
+      spec.library = base_path + "/" + spec.library;
+    }
+    components.push_back(std::move(spec));
+  }
+  return components;
+}
+
+std::string component_output_path(const HostOptions &options,
+                                  const std::string &plugin) {
+  std::string name = plugin;
+  for (size_t pos = name.find("::"); pos != std::string::npos;
+       pos = name.find("::", pos)) {
+    name.replace(pos, 2, "__");
+  }
+  const char *extension = ".json";
+  if (options.format == "yaml") {
+    extension = ".yaml";
+  } else if (options.format == "binary") {
+    extension = ".bin";
+  }
+  return options.output_dir + "/" + name + extension;
+}
+
+bool under_introspect_rmw() {
+  const char *identifier = rmw_get_implementation_identifier();
+  return identifier && std::string(identifier) == "rmw_introspect_cpp";
+}
+
+std::vector<ComponentReport>
+introspect_components(const std::vector<ComponentSpec> &components,
+                      const HostOptions &options) {
+  auto &data = rmw_introspect::IntrospectionData::instance();
+  std::map<std::string, std::unique_ptr<class_loader::ClassLoader>> loaders;
+  std::vector<ComponentReport> reports;
+  reports.reserve(components.size());
+
+  rclcpp::NodeOptions node_options;
+  node_options.arguments(options.node_arguments);
+
+  for (const ComponentSpec &spec : components) {
+    ComponentReport report;
+    report.plugin = spec.plugin;
+    const auto start = std::chrono::steady_clock::now();
+    data.clear();
+
+    try {
+      auto &loader = loaders[spec.library];
+      if (!loader) {
+        loader = std::make_unique<class_loader::ClassLoader>(spec.library);
+      }
+      auto factory = loader->createInstance<rclcpp_components::NodeFactory>(
+          "rclcpp_components::NodeFactoryTemplate<" + spec.plugin + ">");
+
+      // The node is destroyed before the next component is created
+      auto wrapper = factory->create_node_instance(node_options);
+      if (options.spin.count() > 0) {
+        spin_for(wrapper.get_node_base_interface(), options.spin);
+      }
+
+      const auto snapshot = data.snapshot();
+      report.nodes = snapshot.nodes.size();
+      report.publishers = snapshot.publishers.size();
+      report.subscriptions = snapshot.subscriptions.size();
+      report.services = snapshot.services.size();
+      report.clients = snapshot.clients.size();
+
+      const std::string path = component_output_path(options, spec.plugin);
+      if (export_component(data, options.format, path)) {
+        report.output_path = path;
+        report.success = true;
+      } else {
+        report.error = "cannot write " + path;
+      }
+    } catch (const std::exception &e) {
+      report.error = e.what();
+    }
+
+    report.elapsed_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    reports.push_back(std::move(report));
+  }
+
+  data.clear();
+  return reports;
+}
+
+} // namespace rmw_introspect_component_host
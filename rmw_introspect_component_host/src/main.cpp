@@ -0,0 +1,150 @@
+#include "rclcpp/rclcpp.hpp"
+#include "rmw_introspect_component_host/component_host.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+using rmw_introspect_component_host::ComponentReport;
+using rmw_introspect_component_host::ComponentSpec;
+using rmw_introspect_component_host::HostOptions;
+
+namespace {
+
+void print_usage(const char *program) {
+  std::fprintf(
+      stderr,
+      "Usage: %s [options] <package> [<plugin>...] [-- <node arguments>]\n"
+      "       %s [options] --library <path> <plugin>... [-- <node "
+      "arguments>]\n"
+      "\n"
+      "Instantiates rclcpp components under rmw_introspect_cpp, one at a\n"
+      "time in this process, and writes the interfaces of each to its own\n"
+      "file. Without plugins, every component of the package is used.\n"
+      "\n"
+      "Options:\n"
+      "  -o, --output-dir DIR  Directory for the exports (default: .)\n"
+      "  -f, --format FORMAT   json, yaml, csv or binary (default: json)\n"
+      "  --spin-ms N           Spin each component N ms before exporting\n"
+      "  --library PATH        Load plugins from PATH instead of the index\n"
+      "  --list                List the package's components and exit\n",
+      program, program);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  HostOptions options;
+  std::string package;
+  std::string library;
+  std::vector<std::string> plugins;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--") {
+      options.node_arguments.assign(argv + i + 1, argv + argc);
+      break;
+    } else if ((arg == "-o" || arg == "--output-dir") && has_value) {
+      options.output_dir = argv[++i];
+    } else if ((arg == "-f" || arg == "--format") && has_value) {
+      options.format = argv[++i];
+    } else if (arg == "--spin-ms" && has_value) {
+      options.spin = std::chrono::milliseconds(std::atoll(argv[++i]));
+    } else if (arg == "--library" && has_value) {
+      library = argv[++i];
+    } else if (arg == "--list") {
+      list = true;
+    } else if (arg == "-h" || arg == "--help") {
+      print_usage(argv[0]);
+      return 0;
+    } else if (!arg.empty() && arg[0] == '-') {
+      print_usage(argv[0]);
+      return 2;
+    } else if (package.empty() && library.empty()) {
+      package = arg;
+    } else {
+      plugins.push_back(arg);
+    }
+  }
+  if (package.empty() == library.empty() || (list && package.empty()) ||
+      (!library.empty() && plugins.empty())) {
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<ComponentSpec> components;
+  if (!library.empty()) {
+    for (const std::string &plugin : plugins) {
+      components.push_back({plugin, library});
+    }
+  } else {
+    try {
+      components = rmw_introspect_component_host::find_components(package);
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "Error: %s\n", e.what());
+      return 1;
+    }
+    if (list) {
+      for (const ComponentSpec &spec : components) {
+        std::printf("%s\t%s\n", spec.plugin.c_str(), spec.library.c_str());
+      }
+      return 0;
+    }
+    if (!plugins.empty()) {
+      for (const std::string &plugin : plugins) {
+        if (std::none_of(components.begin(), components.end(),
+                         [&plugin](const ComponentSpec &spec) {
+                           return spec.plugin == plugin;
+                         })) {
+          std::fprintf(stderr, "Error: %s does not register %s\n",
+                       package.c_str(), plugin.c_str());
+          return 1;
+        }
+      }
+      components.erase(
+          std::remove_if(components.begin(), components.end(),
+                         [&plugins](const ComponentSpec &spec) {
+                           return std::find(plugins.begin(), plugins.end(),
+                                            spec.plugin) == plugins.end();
+                         }),
+          components.end());
+    }
+  }
+
+  // Record with the introspect RMW, and export per component rather than
+  // at shutdown
+  setenv("RMW_IMPLEMENTATION", "rmw_introspect_cpp", 1);
+  setenv("RMW_INTROSPECT_AUTO_EXPORT", "0", 1);
+  unsetenv("RMW_INTROSPECT_OUTPUT");
+  rclcpp::init(1, argv);
+  if (!rmw_introspect_component_host::under_introspect_rmw()) {
+    std::fprintf(stderr, "Error: rmw_introspect_cpp could not be loaded\n");
+    rclcpp::shutdown();
+    return 1;
+  }
+
+  const auto reports =
+      rmw_introspect_component_host::introspect_components(components,
+                                                           options);
+  rclcpp::shutdown();
+
+  int failed = 0;
+  for (const ComponentReport &report : reports) {
+    if (!report.success) {
+      std::fprintf(stderr, "%s: FAILED: %s\n", report.plugin.c_str(),
+                   report.error.c_str());
+      ++failed;
+      continue;
+    }
+    std::printf("%s: %zu nodes, %zu publishers, %zu subscriptions, "
+                "%zu services, %zu clients (%.1f ms) -> %s\n",
+                report.plugin.c_str(), report.nodes, report.publishers,
+                report.subscriptions, report.services, report.clients,
+                report.elapsed_ms, report.output_path.c_str());
+  }
+  return failed == 0 ? 0 : 1;
+}
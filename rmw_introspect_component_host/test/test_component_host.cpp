@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "rclcpp/rclcpp.hpp"
+#include "rmw_introspect_component_host/component_host.hpp"
+
+using rmw_introspect_component_host::ComponentReport;
+using rmw_introspect_component_host::ComponentSpec;
+using rmw_introspect_component_host::HostOptions;
+
+namespace {
+
+std::string read_file(const std::string & path) {
+  std::ifstream file(path);
+  return std::string((std::istreambuf_iterator<char>(file)),
+    std::istreambuf_iterator<char>());
+}
+
+std::vector<ComponentSpec> test_components(
+  const std::vector<std::string> & plugins)
+{
+  const char * library = std::getenv("TEST_COMPONENTS_LIBRARY");
+  std::vector<ComponentSpec> components;
+  for (const auto & plugin : plugins) {
+    components.push_back({"test_components::" + plugin,
+        library ? library : ""});
+  }
+  return components;
+}
+
+}  // namespace
+
+class TestComponentHost : public ::testing::Test {
+protected:
+  static void SetUpTestSuite()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestSuite()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(TestComponentHost, RunsUnderIntrospectRmw) {
+  EXPECT_TRUE(rmw_introspect_component_host::under_introspect_rmw());
+}
+
+// Each component is exported alone, one bad component does not stop the rest
+TEST_F(TestComponentHost, ExportsEachComponent) {
+  HostOptions options;
+  options.output_dir = "/tmp";
+  const auto reports = rmw_introspect_component_host::introspect_components(
+    test_components({"Talker", "Broken", "Listener"}), options);
+  ASSERT_EQ(reports.size(), 3u);
+
+  const ComponentReport & talker = reports[0];
+  ASSERT_TRUE(talker.success) << talker.error;
+  EXPECT_EQ(talker.nodes, 1u);
+  EXPECT_EQ(talker.output_path, "/tmp/test_components__Talker.json");
+  const std::string talker_json = read_file(talker.output_path);
+  EXPECT_NE(talker_json.find("\"/chatter\""), std::string::npos);
+  EXPECT_NE(talker_json.find("\"/reset\""), std::string::npos);
+  EXPECT_EQ(talker_json.find("listener"), std::string::npos);
+
+  EXPECT_FALSE(reports[1].success);
+  EXPECT_NE(reports[1].error.find("missing required parameter"),
+    std::string::npos);
+
+  const ComponentReport & listener = reports[2];
+  ASSERT_TRUE(listener.success) << listener.error;
+  const std::string listener_json = read_file(listener.output_path);
+  EXPECT_NE(listener_json.find("\"/chatter\""), std::string::npos);
+  EXPECT_EQ(listener_json.find("\"/reset\""), std::string::npos);
+  EXPECT_EQ(listener_json.find("\"/late\""), std::string::npos);
+
+  std::remove(talker.output_path.c_str());
+  std::remove(listener.output_path.c_str());
+}
+
+// Spinning picks up entities created after construction; node arguments
+// apply to every component
+TEST_F(TestComponentHost, SpinAndArguments) {
+  HostOptions options;
+  options.output_dir = "/tmp";
+  options.format = "yaml";
+  options.spin = std::chrono::milliseconds(200);
+  options.node_arguments = {"--ros-args", "-r", "__ns:=/robot"};
+  const auto reports = rmw_introspect_component_host::introspect_components(
+    test_components({"Listener"}), options);
+  ASSERT_EQ(reports.size(), 1u);
+  ASSERT_TRUE(reports[0].success) << reports[0].error;
+  EXPECT_EQ(reports[0].output_path, "/tmp/test_components__Listener.yaml");
+
+  const std::string yaml = read_file(reports[0].output_path);
+  EXPECT_NE(yaml.find("\"/robot/late\""), std::string::npos);
+  EXPECT_NE(yaml.find("\"/robot/listener\""), std::string::npos);
+  std::remove(reports[0].output_path.c_str());
+}
+
+TEST_F(TestComponentHost, UnknownPlugin) {
+  const auto reports = rmw_introspect_component_host::introspect_components(
+    test_components({"Missing"}), HostOptions());
+  ASSERT_EQ(reports.size(), 1u);
+  EXPECT_FALSE(reports[0].success);
+  EXPECT_TRUE(reports[0].output_path.empty());
+}
+
+TEST(TestComponentHostPaths, OutputPath) {
+  HostOptions options;
+  options.output_dir = "out";
+  EXPECT_EQ(rmw_introspect_component_host::component_output_path(options,
+    "demo_nodes_cpp::Talker"), "out/demo_nodes_cpp__Talker.json");
+  options.format = "binary";
+  EXPECT_EQ(rmw_introspect_component_host::component_output_path(options,
+    "a::b::C"), "out/a__b__C.bin");
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,64 @@
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "std_srvs/srv/empty.hpp"
+
+namespace test_components {
+
+// Publisher and service created in the constructor
+class Talker : public rclcpp::Node {
+public:
+  explicit Talker(const rclcpp::NodeOptions & options)
+  : Node("talker", options)
+  {
+    publisher_ = create_publisher<std_msgs::msg::String>("chatter", 10);
+    service_ = create_service<std_srvs::srv::Empty>("reset",
+        [](const std::shared_ptr<std_srvs::srv::Empty::Request>,
+        std::shared_ptr<std_srvs::srv::Empty::Response>) {});
+  }
+
+private:
+  rclcpp::Publisher<std_msgs::msg::String>::SharedPtr publisher_;
+  rclcpp::Service<std_srvs::srv::Empty>::SharedPtr service_;
+};
+
+// Subscription created in the constructor, publisher from a timer
+class Listener : public rclcpp::Node {
+public:
+  explicit Listener(const rclcpp::NodeOptions & options)
+  : Node("listener", options)
+  {
+    subscription_ = create_subscription<std_msgs::msg::String>("chatter", 10,
+        [](std_msgs::msg::String::ConstSharedPtr) {});
+    timer_ = create_wall_timer(std::chrono::milliseconds(1), [this]() {
+          if (!late_publisher_) {
+            late_publisher_ =
+            create_publisher<std_msgs::msg::String>("late", 10);
+          }
+        });
+  }
+
+private:
+  rclcpp::Subscription<std_msgs::msg::String>::SharedPtr subscription_;
+  rclcpp::TimerBase::SharedPtr timer_;
+  rclcpp::Publisher<std_msgs::msg::String>::SharedPtr late_publisher_;
+};
+
+// Fails to construct
+class Broken : public rclcpp::Node {
+public:
+  explicit Broken(const rclcpp::NodeOptions & options)
+  : Node("broken", options)
+  {
+    throw std::runtime_error("missing required parameter");
+  }
+};
+
+}  // namespace test_components
+
+RCLCPP_COMPONENTS_REGISTER_NODE(test_components::Talker)
+RCLCPP_COMPONENTS_REGISTER_NODE(test_components::Listener)
+RCLCPP_COMPONENTS_REGISTER_NODE(test_components::Broken)
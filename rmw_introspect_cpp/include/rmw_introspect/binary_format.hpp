@@ -0,0 +1,150 @@
+#ifndef RMW_INTROSPECT__BINARY_FORMAT_HPP_
+#define RMW_INTROSPECT__BINARY_FORMAT_HPP_
+
+#include "rmw_introspect/data.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Binary introspection format, version 1.0
+///
+/// Little-endian, written in one pass and laid out for mmap:
+///
+///   BinaryHeader
+///   BinaryString[string_count]       offset/length into the string data
+///   char[string_data_size]           NUL-terminated strings, id 0 is ""
+///   BinaryNode[node_count]
+///   BinaryEndpoint[endpoint_count]   publishers, subscriptions, services,
+///                                    then clients, each in creation order
+///   BinaryTopicIndex[topic_index_count]  sorted by name
+///   uint32_t[topic_ref_count]        endpoint indices, grouped per name
+///
+/// Every section starts 8-byte aligned. A reader accepts any minor version
+/// of its major version; records may grow at the end, so readers step by
+/// the record sizes in the header rather than sizeof.
+constexpr char kBinaryMagic[8] = {'R', 'M', 'W', 'I', 'N', 'T', 'R', 'O'};
+constexpr uint16_t kBinaryVersionMajor = 1;
+constexpr uint16_t kBinaryVersionMinor = 0;
+
+struct BinaryHeader {
+  char magic[8];
+  uint16_t version_major;
+  uint16_t version_minor;
+  uint32_t header_size;
+  int64_t created_unix; // Export time, seconds since the epoch
+  uint64_t strings_offset;
+  uint64_t string_data_offset;
+  uint64_t nodes_offset;
+  uint64_t endpoints_offset;
+  uint64_t topic_index_offset;
+  uint64_t topic_refs_offset;
+  uint32_t string_count;
+  uint32_t string_data_size;
+  uint32_t node_count;
+  uint32_t node_record_size;
+  uint32_t endpoint_count;
+  uint32_t endpoint_record_size;
+  uint32_t topic_index_count;
+  uint32_t topic_ref_count;
+};
+static_assert(sizeof(BinaryHeader) == 104, "BinaryHeader layout changed");
+
+struct BinaryString {
+  uint32_t offset; // Into the string data
+  uint32_t length; // Without the NUL
+};
+
+struct BinaryNode {
+  uint32_t name; // "namespace/name"
+  uint32_t reserved;
+};
+static_assert(sizeof(BinaryNode) == 8, "BinaryNode layout changed");
+
+struct BinaryEndpoint {
+  uint8_t kind; // EntityKind
+  uint8_t reliability; // QoSReliability
+  uint8_t durability; // QoSDurability
+  uint8_t history; // QoSHistory
+  uint32_t depth;
+  uint32_t node_name;
+  uint32_t node_namespace;
+  uint32_t name; // Topic or service name
+  uint32_t type; // Message or service type
+  double timestamp; // Creation time, seconds since the epoch
+};
+static_assert(sizeof(BinaryEndpoint) == 32, "BinaryEndpoint layout changed");
+
+struct BinaryTopicIndex {
+  uint32_t name;
+  uint32_t first_ref; // Into the topic refs
+  uint32_t ref_count;
+  uint32_t reserved;
+};
+static_assert(sizeof(BinaryTopicIndex) == 16,
+              "BinaryTopicIndex layout changed");
+
+/// Write `snapshot` to `path` in one buffered pass
+/// @return false if the file could not be written
+bool write_binary(const std::string &path,
+                  const IntrospectionSnapshot &snapshot);
+
+/// Read-only view of a binary introspection file through mmap
+///
+/// Nothing is copied; every accessor reads the mapping, which stays valid
+/// until close() or destruction. open() checks that all sections lie within
+/// the file, so accessors only need to check their index.
+class BinaryReader {
+public:
+  BinaryReader();
+  ~BinaryReader();
+
+  BinaryReader(const BinaryReader &) = delete;
+  BinaryReader &operator=(const BinaryReader &) = delete;
+
+  /// Map and validate `path`, see error() on failure
+  bool open(const std::string &path);
+
+  /// Unmap the file
+  void close();
+
+  /// Why the last open() failed
+  const std::string &error() const { return error_; }
+
+  const BinaryHeader &header() const { return *header_; }
+
+  /// String by id, empty for an invalid id
+  std::string_view string(uint32_t id) const;
+
+  size_t node_count() const { return header_->node_count; }
+  std::string_view node(size_t index) const;
+
+  size_t endpoint_count() const { return header_->endpoint_count; }
+  const BinaryEndpoint &endpoint(size_t index) const;
+
+  /// Endpoints on a topic or service name, binary searched in the index
+  std::vector<const BinaryEndpoint *>
+  endpoints_on(std::string_view name) const;
+
+private:
+  bool fail(const char *message);
+
+  /// Whether [offset, offset + count * size) lies within the file
+  bool section_fits(uint64_t offset, uint64_t count, uint64_t size) const;
+
+  template <typename T> const T *at(uint64_t offset) const {
+    return reinterpret_cast<const T *>(base_ + offset);
+  }
+
+  const char *base_;
+  size_t size_;
+  const BinaryHeader *header_;
+  std::string error_;
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__BINARY_FORMAT_HPP_
@@ -1,53 +1,132 @@
 #ifndef RMW_INTROSPECT__DATA_HPP_
 #define RMW_INTROSPECT__DATA_HPP_
 
+#include "rmw_introspect/segmented_log.hpp"
 #include "rmw_introspect/types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <mutex>
 #include <string>
 #include <vector>
 
 namespace rmw_introspect {
 
+/// Copy of every recorded entity, each list in creation order
+struct IntrospectionSnapshot {
+  std::vector<InternedString> nodes; // "namespace/name"
+  std::vector<PublisherInfo> publishers;
+  std::vector<SubscriptionInfo> subscriptions;
+  std::vector<ServiceInfo> services;
+  std::vector<ClientInfo> clients;
+};
+
 /// Singleton class for storing introspection data
+///
+/// Records are appended to lock-free SegmentedLogs, so entities created on
+/// parallel threads do not contend; the logs are merged in creation order
+/// when exported or read back.
 class IntrospectionData {
 public:
+  /// Read position of append_stream_events() in every log
+  struct StreamCursor {
+    uint64_t generation = 0; // clear() count the positions belong to
+    SegmentedLog<InternedString>::Cursor nodes;
+    SegmentedLog<PublisherInfo>::Cursor publishers;
+    SegmentedLog<SubscriptionInfo>::Cursor subscriptions;
+    SegmentedLog<ServiceInfo>::Cursor services;
+    SegmentedLog<ClientInfo>::Cursor clients;
+    SegmentedLog<LifecycleEvent>::Cursor lifecycle;
+  };
+
   /// Get singleton instance
   static IntrospectionData &instance();
 
   /// Record node creation
-  void record_node(const std::string &name, const std::string &ns);
+  /// @return Id to pass to record_destroy(), 0 if it could not be stored
+  RecordId record_node(const std::string &name, const std::string &ns);
 
   /// Record publisher creation
-  void record_publisher(const PublisherInfo &info);
+  RecordId record_publisher(const PublisherInfo &info);
 
   /// Record subscription creation
-  void record_subscription(const SubscriptionInfo &info);
+  RecordId record_subscription(const SubscriptionInfo &info);
 
   /// Record service creation
-  void record_service(const ServiceInfo &info);
+  RecordId record_service(const ServiceInfo &info);
 
   /// Record client creation
-  void record_client(const ClientInfo &info);
+  RecordId record_client(const ClientInfo &info);
+
+  /// Record destruction of an entity created with the given id
+  void record_destroy(EntityKind kind, RecordId id);
 
   /// Export data to JSON file
-  void export_to_json(const std::string &path);
+  /// @return false if the file could not be written
+  bool export_to_json(const std::string &path);
+
+  /// Export data to the binary format of binary_format.hpp
+  /// @return false if the file could not be written
+  bool export_to_binary(const std::string &path);
 
-  /// Export data to YAML file
-  void export_to_yaml(const std::string &path);
+  /// Export data to YAML file, the same document as the JSON export
+  /// @return false if the file could not be written
+  bool export_to_yaml(const std::string &path);
+
+  /// Export one CSV table per entity kind next to `path`, see
+  /// csv_output_path()
+  /// @return false if any table could not be written
+  bool export_to_csv(const std::string &path);
+
+  /// Export entity lifetimes, peak live counts and per-node churn as JSON
+  void export_timeline_to_json(const std::string &path);
+
+  /// Append one NDJSON line per record completed since `cursor` to `out`
+  ///
+  /// Lines carry the record's sequence number, since they come out in log
+  /// order rather than creation order. Stops once `out` holds `max_bytes`.
+  /// @return Whether every completed record was consumed
+  bool append_stream_events(StreamCursor &cursor, std::string &out,
+                            size_t max_bytes);
 
   /// Clear all recorded data (for testing)
   void clear();
 
-  /// Get recorded data (for testing)
-  const std::vector<std::string> &get_nodes() const { return nodes_; }
-  const std::vector<PublisherInfo> &get_publishers() const {
-    return publishers_;
+  /// Merge every log into one snapshot
+  IntrospectionSnapshot snapshot() const;
+
+  /// Get snapshots of recorded data in creation order (for testing)
+  std::vector<InternedString> get_nodes() const { return nodes_.snapshot(); }
+  std::vector<PublisherInfo> get_publishers() const {
+    return publishers_.snapshot();
+  }
+  std::vector<SubscriptionInfo> get_subscriptions() const {
+    return subscriptions_.snapshot();
+  }
+  std::vector<ServiceInfo> get_services() const {
+    return services_.snapshot();
+  }
+  std::vector<ClientInfo> get_clients() const { return clients_.snapshot(); }
+  std::vector<LifecycleEvent> get_lifecycle() const {
+    return lifecycle_.snapshot();
+  }
+
+  /// Number of nodes recorded since the last clear()
+  size_t node_count() const { return nodes_.size(); }
+
+  /// steady_time_ns() of the last entity creation or destruction, 0 if none
+  int64_t last_change_ns() const {
+    return last_change_ns_.load(std::memory_order_relaxed);
   }
-  const std::vector<SubscriptionInfo> &get_subscriptions() const {
-    return subscriptions_;
+
+  /// Number of entity creations and destructions since the last clear()
+  uint64_t change_count() const {
+    return change_count_.load(std::memory_order_relaxed);
   }
-  const std::vector<ServiceInfo> &get_services() const { return services_; }
-  const std::vector<ClientInfo> &get_clients() const { return clients_; }
+
+  /// Call `listener` once, on the recording thread, when change_count()
+  /// reaches `count`, replacing any earlier request
+  void notify_at_change(uint64_t count, void (*listener)());
 
 private:
   IntrospectionData() = default;
@@ -59,15 +138,39 @@ private:
   IntrospectionData(IntrospectionData &&) = delete;
   IntrospectionData &operator=(IntrospectionData &&) = delete;
 
-  std::vector<std::string> nodes_;
-  std::vector<PublisherInfo> publishers_;
-  std::vector<SubscriptionInfo> subscriptions_;
-  std::vector<ServiceInfo> services_;
-  std::vector<ClientInfo> clients_;
-
-  mutable std::mutex mutex_; // Thread safety
+  SegmentedLog<InternedString> nodes_; // "namespace/name"
+  SegmentedLog<PublisherInfo> publishers_;
+  SegmentedLog<SubscriptionInfo> subscriptions_;
+  SegmentedLog<ServiceInfo> services_;
+  SegmentedLog<ClientInfo> clients_;
+  SegmentedLog<LifecycleEvent> lifecycle_; // Creations and destructions
+
+  /// Append the creation event for a record stored under `id`
+  RecordId record_created(EntityKind kind, RecordId id,
+                          InternedString node_name,
+                          InternedString node_namespace, InternedString name);
+
+  /// Note a creation or destruction at `now_ns`, calling the change
+  /// listener when its count is reached
+  void record_change(int64_t now_ns);
+
+  std::atomic<int64_t> last_change_ns_{0};
+  std::atomic<uint64_t> change_count_{0};
+  // Disarmed by swapping in the maximum, so only one thread calls
+  std::atomic<uint64_t> notify_at_{std::numeric_limits<uint64_t>::max()};
+  std::atomic<void (*)()> change_listener_{nullptr};
+
+  std::mutex export_mutex_; // Serializes exports and clear()
+  uint64_t generation_ = 1; // Bumped by clear(), export_mutex_ held
 };
 
+/// Whether RMW_INTROSPECT_TIMELINE asks for the lifecycle timeline export
+bool timeline_enabled();
+
+/// Path of the timeline export that sits next to the introspection output
+/// ("graph.json" -> "graph.timeline.json")
+std::string timeline_output_path(const std::string &output_path);
+
 } // namespace rmw_introspect
 
 #endif // RMW_INTROSPECT__DATA_HPP_
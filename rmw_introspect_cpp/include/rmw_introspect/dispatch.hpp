@@ -0,0 +1,139 @@
+#ifndef RMW_INTROSPECT__DISPATCH_HPP_
+#define RMW_INTROSPECT__DISPATCH_HPP_
+
+#include "rmw/error_handling.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+#include "rmw/types.h"
+#include "rmw_introspect/identifier.hpp"
+#include <atomic>
+
+namespace rmw_introspect {
+
+/// Operating mode a dispatch table is specialized for
+enum class DispatchMode {
+  RecordingOnly,     ///< No real RMW, hot calls are no-ops
+  Loopback,          ///< No real RMW, messages delivered in-process
+  Intermediate,      ///< Forward to the real RMW
+  IntermediateStats, ///< Forward and record latency histograms
+};
+
+/// Implementations of the hot-path RMW calls
+///
+/// One table per DispatchMode is generated from templates in dispatch.cpp.
+/// rmw_init selects the table once, so each exported hot call performs its
+/// argument checks, check_dispatch_handle(), and then a single indirect call
+/// with no mode branching. Implementations trust the handle from there on.
+///
+/// The indirect call costs about what the mode branch it replaced did, so
+/// the table does not make a call cheaper. It keeps each mode in its own
+/// functions. Loopback delivery and latency timing are then added as tables,
+/// not as branches in every entry point, and IntermediateStats is the only
+/// table that touches a histogram.
+struct DispatchTable {
+  DispatchMode mode;
+
+  rmw_ret_t (*publish)(const rmw_publisher_t *publisher,
+                       const void *ros_message,
+                       rmw_publisher_allocation_t *allocation);
+  rmw_ret_t (*publish_serialized_message)(
+      const rmw_publisher_t *publisher,
+      const rmw_serialized_message_t *serialized_message,
+      rmw_publisher_allocation_t *allocation);
+
+  rmw_ret_t (*borrow_loaned_message)(
+      const rmw_publisher_t *publisher,
+      const rosidl_message_type_support_t *type_support, void **ros_message);
+  rmw_ret_t (*return_loaned_message_from_publisher)(
+      const rmw_publisher_t *publisher, void *loaned_message);
+  rmw_ret_t (*publish_loaned_message)(const rmw_publisher_t *publisher,
+                                      void *ros_message,
+                                      rmw_publisher_allocation_t *allocation);
+
+  rmw_ret_t (*take)(const rmw_subscription_t *subscription, void *ros_message,
+                    bool *taken, rmw_subscription_allocation_t *allocation);
+  rmw_ret_t (*take_with_info)(const rmw_subscription_t *subscription,
+                              void *ros_message, bool *taken,
+                              rmw_message_info_t *message_info,
+                              rmw_subscription_allocation_t *allocation);
+  rmw_ret_t (*take_serialized_message)(
+      const rmw_subscription_t *subscription,
+      rmw_serialized_message_t *serialized_message, bool *taken,
+      rmw_subscription_allocation_t *allocation);
+  rmw_ret_t (*take_serialized_message_with_info)(
+      const rmw_subscription_t *subscription,
+      rmw_serialized_message_t *serialized_message, bool *taken,
+      rmw_message_info_t *message_info,
+      rmw_subscription_allocation_t *allocation);
+
+  rmw_ret_t (*take_loaned_message)(const rmw_subscription_t *subscription,
+                                   void **loaned_message, bool *taken,
+                                   rmw_subscription_allocation_t *allocation);
+  rmw_ret_t (*take_loaned_message_with_info)(
+      const rmw_subscription_t *subscription, void **loaned_message,
+      bool *taken, rmw_message_info_t *message_info,
+      rmw_subscription_allocation_t *allocation);
+  rmw_ret_t (*return_loaned_message_from_subscription)(
+      const rmw_subscription_t *subscription, void *loaned_message);
+
+  rmw_ret_t (*take_request)(const rmw_service_t *service,
+                            rmw_service_info_t *request_header,
+                            void *ros_request, bool *taken);
+  rmw_ret_t (*send_response)(const rmw_service_t *service,
+                             rmw_request_id_t *request_header,
+                             void *ros_response);
+  rmw_ret_t (*send_request)(const rmw_client_t *client,
+                            const void *ros_request, int64_t *sequence_id);
+  rmw_ret_t (*take_response)(const rmw_client_t *client,
+                             rmw_service_info_t *request_header,
+                             void *ros_response, bool *taken);
+
+  rmw_ret_t (*wait)(rmw_subscriptions_t *subscriptions,
+                    rmw_guard_conditions_t *guard_conditions,
+                    rmw_services_t *services, rmw_clients_t *clients,
+                    rmw_events_t *events, rmw_wait_set_t *wait_set,
+                    const rmw_time_t *wait_timeout);
+  rmw_ret_t (*trigger_guard_condition)(
+      const rmw_guard_condition_t *guard_condition);
+};
+
+/// Get the table generated for `mode`
+const DispatchTable &dispatch_table(DispatchMode mode);
+
+namespace internal {
+
+// Active table - defined in dispatch.cpp, starts as recording-only
+extern std::atomic<const DispatchTable *> g_dispatch;
+
+/// Table for the current mode
+inline const DispatchTable &current_dispatch() {
+  return *g_dispatch.load(std::memory_order_acquire);
+}
+
+/// Install the table for `mode` (call with g_init_mutex held)
+void select_dispatch(DispatchMode mode);
+
+/// The one handle check of an exported hot call, made before the indirect
+/// call: the handle must come from this layer and carry its data
+/// @return RMW_RET_OK, or the error to return with the error message set
+template <typename Handle>
+inline rmw_ret_t check_dispatch_handle(const Handle *handle) {
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(handle, handle->implementation_identifier,
+                                   rmw_introspect_cpp_identifier,
+                                   return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (handle->data == nullptr) {
+    RMW_SET_ERROR_MSG("handle has no implementation data");
+    return RMW_RET_ERROR;
+  }
+  return RMW_RET_OK;
+}
+
+/// Whether recording-only publishers and subscriptions join the loopback
+inline bool is_loopback_mode() {
+  return current_dispatch().mode == DispatchMode::Loopback;
+}
+
+} // namespace internal
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__DISPATCH_HPP_
@@ -2,6 +2,7 @@
 #define RMW_INTROSPECT__FORWARDING_HPP_
 
 #include "rmw/rmw.h"
+#include "rmw_introspect/identifier.hpp"
 #include "rmw_introspect/wrappers.hpp"
 
 namespace rmw_introspect {
@@ -33,6 +34,62 @@ inline rmw_publisher_t *unwrap_publisher(const rmw_publisher_t *pub) {
   return wrapper->real_publisher;
 }
 
+/// Get publisher wrapper, or nullptr if the handle is not wrapped
+inline PublisherWrapper *get_publisher_wrapper(const rmw_publisher_t *pub) {
+  if (!pub || !pub->data)
+    return nullptr;
+  auto *wrapper = static_cast<PublisherWrapper *>(pub->data);
+  return wrapper->real_publisher ? wrapper : nullptr;
+}
+
+/// Get subscription wrapper, or nullptr if the handle is not wrapped
+inline SubscriptionWrapper *
+get_subscription_wrapper(const rmw_subscription_t *sub) {
+  if (!sub || !sub->data)
+    return nullptr;
+  auto *wrapper = static_cast<SubscriptionWrapper *>(sub->data);
+  return wrapper->real_subscription ? wrapper : nullptr;
+}
+
+/// Get service wrapper, or nullptr if the handle is not wrapped
+inline ServiceWrapper *get_service_wrapper(const rmw_service_t *srv) {
+  if (!srv || !srv->data)
+    return nullptr;
+  auto *wrapper = static_cast<ServiceWrapper *>(srv->data);
+  return wrapper->real_service ? wrapper : nullptr;
+}
+
+/// Get client wrapper, or nullptr if the handle is not wrapped
+inline ClientWrapper *get_client_wrapper(const rmw_client_t *client) {
+  if (!client || !client->data)
+    return nullptr;
+  auto *wrapper = static_cast<ClientWrapper *>(client->data);
+  return wrapper->real_client ? wrapper : nullptr;
+}
+
+/// Unwrap publisher allocation to get the real RMW allocation
+/// Null and foreign allocations are passed through unchanged
+inline rmw_publisher_allocation_t *
+unwrap_publisher_allocation(rmw_publisher_allocation_t *allocation) {
+  if (!allocation || !allocation->data ||
+      allocation->implementation_identifier != rmw_introspect_cpp_identifier)
+    return allocation;
+  auto *wrapper = static_cast<PublisherAllocationWrapper *>(allocation->data);
+  return &wrapper->real_allocation;
+}
+
+/// Unwrap subscription allocation to get the real RMW allocation
+/// Null and foreign allocations are passed through unchanged
+inline rmw_subscription_allocation_t *
+unwrap_subscription_allocation(rmw_subscription_allocation_t *allocation) {
+  if (!allocation || !allocation->data ||
+      allocation->implementation_identifier != rmw_introspect_cpp_identifier)
+    return allocation;
+  auto *wrapper =
+      static_cast<SubscriptionAllocationWrapper *>(allocation->data);
+  return &wrapper->real_allocation;
+}
+
 /// Unwrap subscription to get real RMW subscription
 inline rmw_subscription_t *unwrap_subscription(const rmw_subscription_t *sub) {
   if (!sub || !sub->data)
@@ -66,6 +123,16 @@ unwrap_guard_condition(const rmw_guard_condition_t *gc) {
   return wrapper->real_guard_condition;
 }
 
+/// Unwrap event to get the real RMW event
+/// Null and foreign events are passed through unchanged
+inline rmw_event_t *unwrap_event(rmw_event_t *event) {
+  if (!event || !event->data ||
+      event->implementation_identifier != rmw_introspect_cpp_identifier)
+    return event;
+  auto *wrapper = static_cast<EventWrapper *>(event->data);
+  return &wrapper->real_event;
+}
+
 /// Unwrap wait set to get real RMW wait set
 inline rmw_wait_set_t *unwrap_wait_set(const rmw_wait_set_t *ws) {
   if (!ws || !ws->data)
@@ -74,6 +141,30 @@ inline rmw_wait_set_t *unwrap_wait_set(const rmw_wait_set_t *ws) {
   return wrapper->real_wait_set;
 }
 
+// --- Callback Forwarding ---
+
+/// Point the real RMW's callback for one entity at `trampoline`
+///
+/// The real RMW is detached first so it never invokes the trampoline while
+/// the application's callback is swapped; a null callback leaves it detached.
+template <typename RealHandleT>
+rmw_ret_t set_callback_trampoline(
+    rmw_ret_t (*real_set)(RealHandleT *, rmw_event_callback_t, const void *),
+    RealHandleT *real_handle, CallbackTrampoline &trampoline,
+    rmw_event_callback_t callback, const void *user_data) {
+  rmw_ret_t ret = real_set(real_handle, nullptr, nullptr);
+  if (ret != RMW_RET_OK) {
+    return ret;
+  }
+
+  trampoline.callback = callback;
+  trampoline.user_data = user_data;
+  if (!callback) {
+    return RMW_RET_OK;
+  }
+  return real_set(real_handle, &CallbackTrampoline::invoke, &trampoline);
+}
+
 } // namespace internal
 } // namespace rmw_introspect
 
@@ -0,0 +1,132 @@
+#ifndef RMW_INTROSPECT__HANDLE_POOL_HPP_
+#define RMW_INTROSPECT__HANDLE_POOL_HPP_
+
+#include "rmw/rmw.h"
+#include "rmw_introspect/wrappers.hpp"
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Slab allocator for an rmw handle and its wrapper
+///
+/// Each slot holds the handle and the wrapper side by side, and handle->data
+/// points into the same block, so an intermediate-mode create needs no heap
+/// allocation of its own. Released slots go on a free list and are handed to
+/// the next create. Slabs are only freed with the pool, and only once every
+/// slot is back: a handle destroyed late must not land in freed memory.
+template <typename HandleT, typename WrapperT, size_t SlotsPerSlab = 64>
+class HandlePool {
+public:
+  HandlePool() : free_(nullptr), in_use_(0) {}
+
+  ~HandlePool() {
+    // With slots still in use the slabs are leaked instead, so releasing
+    // those handles afterwards touches no freed memory
+    if (in_use_ != 0) {
+      return;
+    }
+    for (Slot *slab : slabs_) {
+      delete[] slab;
+    }
+  }
+
+  HandlePool(const HandlePool &) = delete;
+  HandlePool &operator=(const HandlePool &) = delete;
+
+  /// Construct a wrapper from `args` and return its zeroed handle
+  /// @return Handle with data set to the wrapper, or nullptr on allocation
+  ///         failure
+  template <typename... Args> HandleT *acquire(Args &&...args) {
+    Slot *slot = pop_free();
+    if (!slot) {
+      return nullptr;
+    }
+    slot->handle = HandleT{};
+    slot->handle.data =
+        new (slot->wrapper_storage) WrapperT(std::forward<Args>(args)...);
+    return &slot->handle;
+  }
+
+  /// Destroy the wrapper of a handle from acquire() and recycle its slot
+  void release(HandleT *handle) {
+    if (!handle) {
+      return;
+    }
+    // handle is the first member, so its address is the slot's
+    Slot *slot = reinterpret_cast<Slot *>(handle);
+    static_cast<WrapperT *>(slot->handle.data)->~WrapperT();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    slot->next_free = free_;
+    free_ = slot;
+    --in_use_;
+  }
+
+  /// Number of slots handed out and not yet released
+  size_t in_use() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_use_;
+  }
+
+  /// Number of slots allocated across all slabs
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slabs_.size() * SlotsPerSlab;
+  }
+
+private:
+  struct Slot {
+    HandleT handle; // Must stay first, see release()
+    alignas(WrapperT) unsigned char wrapper_storage[sizeof(WrapperT)];
+    Slot *next_free;
+  };
+
+  Slot *pop_free() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_ && !grow()) {
+      return nullptr;
+    }
+    Slot *slot = free_;
+    free_ = slot->next_free;
+    ++in_use_;
+    return slot;
+  }
+
+  /// Allocate one slab and put its slots on the free list (mutex held)
+  bool grow() {
+    Slot *slab = new (std::nothrow) Slot[SlotsPerSlab];
+    if (!slab) {
+      return false;
+    }
+    slabs_.push_back(slab);
+    for (size_t i = SlotsPerSlab; i > 0; --i) {
+      slab[i - 1].next_free = free_;
+      free_ = &slab[i - 1];
+    }
+    return true;
+  }
+
+  mutable std::mutex mutex_;
+  Slot *free_;
+  size_t in_use_;
+  std::vector<Slot *> slabs_;
+};
+
+namespace internal {
+
+// Process-wide pools for intermediate-mode handles - defined in
+// handle_pool.cpp. They are never destroyed: rcl and rclcpp globals can
+// destroy their handles after this library's statics are gone.
+HandlePool<rmw_publisher_t, PublisherWrapper> &publisher_pool();
+HandlePool<rmw_subscription_t, SubscriptionWrapper> &subscription_pool();
+HandlePool<rmw_service_t, ServiceWrapper> &service_pool();
+HandlePool<rmw_client_t, ClientWrapper> &client_pool();
+
+} // namespace internal
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__HANDLE_POOL_HPP_
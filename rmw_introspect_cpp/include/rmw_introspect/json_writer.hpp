@@ -0,0 +1,79 @@
+#ifndef RMW_INTROSPECT__JSON_WRITER_HPP_
+#define RMW_INTROSPECT__JSON_WRITER_HPP_
+
+#include "rmw_introspect/output_buffer.hpp"
+#include "rmw_introspect/string_table.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Append `str` to `out` as a quoted JSON string
+///
+/// Runs of characters that need no escape are appended in one piece, so a
+/// name without quotes, backslashes or control characters is a single copy.
+void append_json_string(OutputBuffer &out, std::string_view str);
+void append_json_string(std::string &out, std::string_view str);
+
+/// Pretty-printing JSON emitter into an OutputBuffer
+///
+/// Commas, newlines and two-space indentation are inserted automatically;
+/// call key() before each value inside an object. YamlWriter has the same
+/// interface, so serializer sinks are written once for both.
+class JsonWriter {
+public:
+  explicit JsonWriter(OutputBuffer &out);
+
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+
+  /// Start an object member, the next call writes its value
+  void key(std::string_view name);
+
+  void value(std::string_view str);
+  void value(const char *str) { value(std::string_view(str ? str : "")); }
+  void value(const std::string &str) { value(std::string_view(str)); }
+  void value(InternedString str) { value(std::string_view(str.str())); }
+  void value(bool b);
+  void value(double number); // null if not finite
+  template <typename T>
+  std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>
+  value(T number) {
+    next_element();
+    if constexpr (std::is_signed_v<T>) {
+      out_.write_signed(static_cast<int64_t>(number));
+    } else {
+      out_.write_unsigned(static_cast<uint64_t>(number));
+    }
+  }
+  void null();
+
+  /// key() followed by value()
+  template <typename T> void member(std::string_view name, const T &v) {
+    key(name);
+    value(v);
+  }
+
+private:
+  /// Separator and indentation before a new array element or object member
+  void next_element();
+  void begin(char bracket);
+  void end(char bracket);
+
+  struct Scope {
+    bool empty;
+  };
+
+  OutputBuffer &out_;
+  std::vector<Scope> scopes_;
+  bool after_key_;
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__JSON_WRITER_HPP_
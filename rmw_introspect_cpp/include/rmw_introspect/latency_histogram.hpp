@@ -0,0 +1,146 @@
+#ifndef RMW_INTROSPECT__LATENCY_HISTOGRAM_HPP_
+#define RMW_INTROSPECT__LATENCY_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Log-linear latency histogram for nanosecond samples
+///
+/// Each power-of-two range is split into 2^kSubBucketBits linear sub-buckets,
+/// bounding the relative error of a reported percentile to 1/8. Recording is
+/// wait-free: samples go to one of kShardCount cache-line aligned shards
+/// picked per thread, and shards are only merged when a snapshot is taken.
+class LatencyHistogram {
+public:
+  static constexpr unsigned kSubBucketBits = 3;
+  static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;
+  static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) *
+                                         kSubBucketCount;
+  static constexpr size_t kShardCount = 4;
+
+  /// Merged view of all shards
+  struct Snapshot {
+    std::array<uint64_t, kBucketCount> buckets{};
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+
+    /// Value at quantile `q` in [0, 1], clamped to the observed range
+    uint64_t percentile(double q) const;
+  };
+
+  LatencyHistogram() = default;
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  /// Record one sample
+  void record(uint64_t ns);
+
+  /// Merge all shards into a snapshot
+  Snapshot snapshot() const;
+
+  /// Bucket index for a value
+  static size_t bucket_index(uint64_t ns);
+
+  /// Smallest value that maps to bucket `index`
+  static uint64_t bucket_lower_bound(size_t index);
+
+private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum_ns{0};
+    std::atomic<uint64_t> min_ns{UINT64_MAX};
+    std::atomic<uint64_t> max_ns{0};
+  };
+
+  std::array<Shard, kShardCount> shards_;
+};
+
+/// Times a scope into a histogram; does nothing when the histogram is null
+class ScopedLatency {
+public:
+  explicit ScopedLatency(LatencyHistogram *histogram)
+      : histogram_(histogram) {
+    if (histogram_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedLatency() {
+    if (histogram_) {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      histogram_->record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()));
+    }
+  }
+
+  ScopedLatency(const ScopedLatency &) = delete;
+  ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+private:
+  LatencyHistogram *histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/// Process-wide registry of latency histograms, keyed by entity
+///
+/// Latency tracking is opt-in via RMW_INTROSPECT_LATENCY=1. When disabled,
+/// create() returns nullptr and the forwarding path only pays a null check.
+class LatencyRegistry {
+public:
+  static LatencyRegistry &instance();
+
+  /// Whether RMW_INTROSPECT_LATENCY enables tracking
+  bool enabled() const { return enabled_; }
+
+  /// Create and register a histogram, or nullptr when tracking is disabled
+  /// @param operation Forwarded call, e.g. "publish"
+  /// @param entity Human-readable entity label, e.g. "/ns/node /topic"
+  std::shared_ptr<LatencyHistogram> create(const std::string &operation,
+                                           const std::string &entity);
+
+  /// Export all histograms to a JSON file
+  void export_to_json(const std::string &path) const;
+
+  /// Drop all registered histograms (for testing)
+  void clear();
+
+private:
+  LatencyRegistry();
+
+  struct Entry {
+    std::string operation;
+    std::string entity;
+    std::shared_ptr<LatencyHistogram> histogram;
+  };
+
+  bool enabled_;
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+/// Entity label for a node endpoint, e.g. "/ns/node /chatter"
+std::string latency_entity_label(const std::string &node_namespace,
+                                 const std::string &node_name,
+                                 const std::string &endpoint);
+
+/// Path of the latency export that sits next to the introspection output
+/// ("graph.json" -> "graph.latency.json")
+std::string latency_output_path(const std::string &output_path);
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,150 @@
+#ifndef RMW_INTROSPECT__LOOPBACK_HPP_
+#define RMW_INTROSPECT__LOOPBACK_HPP_
+
+#include "rmw/types.h"
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// A message type the loopback can copy, through its C++ introspection data
+class LoopbackType {
+public:
+  /// nullptr if `type_support` has no C++ introspection data (e.g. types of
+  /// rclpy nodes, which only carry C type support)
+  static std::shared_ptr<const LoopbackType>
+  create(const rosidl_message_type_support_t *type_support);
+
+  explicit LoopbackType(
+      const rosidl_typesupport_introspection_cpp::MessageMembers *members);
+
+  /// "package/msg/Name"
+  const std::string &name() const { return name_; }
+
+  /// Deep copy of `message` in newly allocated storage, freed by destroy()
+  /// @throws std::bad_alloc
+  void *clone(const void *message) const;
+
+  /// Assign `from` to the already constructed `to`
+  void copy(const void *from, void *to) const;
+
+  void destroy(void *message) const;
+
+private:
+  const rosidl_typesupport_introspection_cpp::MessageMembers *members_;
+  std::string name_;
+};
+
+/// A published message, shared by every subscription that takes it
+struct LoopbackMessage {
+  std::shared_ptr<const LoopbackType> type;
+  void *data = nullptr;
+  uint64_t sequence = 0;
+  int64_t source_timestamp = 0; // System time, ns
+
+  LoopbackMessage() = default;
+  ~LoopbackMessage();
+
+  LoopbackMessage(const LoopbackMessage &) = delete;
+  LoopbackMessage &operator=(const LoopbackMessage &) = delete;
+};
+
+class LoopbackTopic;
+
+/// Loopback side of a recording-only publisher or subscription
+struct LoopbackEndpoint {
+  std::shared_ptr<LoopbackTopic> topic;
+  std::shared_ptr<const LoopbackType> type; // nullptr: never delivered
+  size_t depth = 1;                         // KEEP_LAST depth
+  uint64_t cursor = 0; // Subscriptions: next sequence to take, topic-locked
+};
+
+/// Ring buffer of the messages recently published on one topic
+///
+/// Sequence s lives in slot s % capacity, so publishing never moves older
+/// messages. Each subscription keeps its own cursor and sees at most its
+/// depth of the newest messages, like KEEP_LAST history. The mutex guards
+/// pointer moves only; messages are copied outside it.
+class LoopbackTopic {
+public:
+  /// Grow the ring to hold at least `depth` messages
+  void reserve(size_t depth);
+
+  /// Start a subscription at the next message, or at the retained ones for
+  /// transient local durability
+  void attach(LoopbackEndpoint &subscription, bool transient_local);
+
+  /// Append a message, stamping its sequence, and drop the oldest once the
+  /// ring is full
+  void publish(std::shared_ptr<LoopbackMessage> message);
+
+  /// Whether `subscription` has a message of its type to take
+  bool readable(const LoopbackEndpoint &subscription) const;
+
+  /// Next message of the subscription's type, advancing its cursor
+  std::shared_ptr<const LoopbackMessage> take(LoopbackEndpoint &subscription);
+
+private:
+  /// First sequence `subscription` may still take (mutex_ held)
+  uint64_t oldest_for(const LoopbackEndpoint &subscription) const;
+
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<const LoopbackMessage>> slots_{1};
+  uint64_t next_sequence_ = 1;
+};
+
+/// Loopback topics of the process, by name
+///
+/// A topic lives as long as one of its endpoints does.
+class LoopbackBus {
+public:
+  /// Get singleton instance
+  static LoopbackBus &instance();
+
+  /// Endpoint on `topic_name`, reserving its depth in the topic's ring
+  /// @return nullptr on allocation failure
+  std::unique_ptr<LoopbackEndpoint>
+  attach_publisher(const char *topic_name,
+                   const rosidl_message_type_support_t *type_support,
+                   const rmw_qos_profile_t &qos);
+  std::unique_ptr<LoopbackEndpoint>
+  attach_subscription(const char *topic_name,
+                      const rosidl_message_type_support_t *type_support,
+                      const rmw_qos_profile_t &qos);
+
+  /// Copy `message` to every subscription of the publisher's topic and wake
+  /// blocked waits; a no-op for types the loopback cannot copy
+  rmw_ret_t publish(const LoopbackEndpoint &publisher, const void *message);
+
+  /// Take the next message into `message`, filling `info` if set
+  rmw_ret_t take(LoopbackEndpoint &subscription, void *message, bool *taken,
+                 rmw_message_info_t *info);
+
+private:
+  LoopbackBus() = default;
+
+  LoopbackBus(const LoopbackBus &) = delete;
+  LoopbackBus &operator=(const LoopbackBus &) = delete;
+
+  std::unique_ptr<LoopbackEndpoint>
+  attach(const char *topic_name,
+         const rosidl_message_type_support_t *type_support,
+         const rmw_qos_profile_t &qos);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<LoopbackTopic>> topics_;
+};
+
+/// Whether RMW_INTROSPECT_LOOPBACK enables the loopback
+bool loopback_enabled();
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__LOOPBACK_HPP_
@@ -0,0 +1,72 @@
+#ifndef RMW_INTROSPECT__OUTPUT_BUFFER_HPP_
+#define RMW_INTROSPECT__OUTPUT_BUFFER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace rmw_introspect {
+
+/// Preallocated byte buffer that exporters format into
+///
+/// In memory mode the buffer is reserved once and grows only if the
+/// estimate was short. In file mode it is drained to the descriptor
+/// whenever it fills, so memory stays bounded by the capacity and an
+/// export that fits is written with one write(2).
+class OutputBuffer {
+public:
+  /// Memory mode, the contents are read back through view()
+  explicit OutputBuffer(size_t capacity);
+  /// File mode, call flush() to write what is still buffered
+  OutputBuffer(int fd, size_t capacity);
+
+  OutputBuffer(const OutputBuffer &) = delete;
+  OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+  void write(const char *data, size_t size) {
+    if (buffer_.size() + size > capacity_ && fd_ >= 0) {
+      drain(data, size);
+      return;
+    }
+    buffer_.append(data, size);
+  }
+  void write(std::string_view str) { write(str.data(), str.size()); }
+  void put(char c) {
+    if (buffer_.size() == capacity_ && fd_ >= 0) {
+      drain(nullptr, 0);
+    }
+    buffer_ += c;
+  }
+  void fill(size_t count, char c);
+  void write_unsigned(uint64_t number);
+  void write_signed(int64_t number);
+  /// Shortest exact decimal form, "null" if not finite
+  void write_double(double number);
+
+  /// Write buffered bytes to the descriptor, no-op in memory mode
+  /// @return false if any write to the descriptor failed
+  bool flush();
+  bool ok() const { return ok_; }
+
+  /// Buffered bytes, the whole output in memory mode
+  std::string_view view() const { return buffer_; }
+
+private:
+  /// Write the buffer and then `size` bytes of `data` to the descriptor
+  void drain(const char *data, size_t size);
+  bool write_fd(const char *data, size_t size);
+
+  int fd_;
+  size_t capacity_;
+  std::string buffer_;
+  bool ok_;
+};
+
+/// Open `path` for an export, truncating it
+/// @return the descriptor, or -1
+int open_export_file(const std::string &path);
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__OUTPUT_BUFFER_HPP_
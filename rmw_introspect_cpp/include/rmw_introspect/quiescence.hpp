@@ -0,0 +1,105 @@
+#ifndef RMW_INTROSPECT__QUIESCENCE_HPP_
+#define RMW_INTROSPECT__QUIESCENCE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace rmw_introspect {
+
+/// Process exit status with QuiescenceOptions::exit_after_export
+constexpr int kExitExported = 0;     ///< Node went quiet and was exported
+constexpr int kExitDeadline = 3;     ///< Deadline passed, partial export
+constexpr int kExitNoNode = 4;       ///< Deadline passed before any node
+constexpr int kExitExportFailed = 5; ///< The export could not be written
+
+/// Why the monitor ran its callback
+enum class QuietReason { Quiet, Deadline };
+
+/// When and how the monitor reports a node as finished
+struct QuiescenceOptions {
+  /// Quiet time after the first wait and the last change
+  std::chrono::milliseconds window{100};
+  /// Give up waiting for quiet this long after start(), 0 for never
+  std::chrono::milliseconds deadline{0};
+  /// Pipe to signal and close, -1 for none; anything else is ignored
+  int ready_fd = -1;
+  /// _exit() with a kExit* status once the callback has run
+  bool exit_after_export = false;
+};
+
+/// Detects that a node has finished creating its entities
+///
+/// Once armed, the first rmw_wait starts the watch: a node that waits has
+/// finished its constructor. When no entity has been created or destroyed
+/// for the window after that, or when the deadline passes first, the
+/// monitor runs its callback (the export) once and writes one byte to the
+/// ready descriptor, so a supervising process can stop the node right away
+/// instead of sleeping for a timeout. With exit_after_export it ends the
+/// process itself, skipping a shutdown the node may never reach.
+class QuiescenceMonitor {
+public:
+  /// Callback run once on the monitor thread, returning false on failure
+  using QuietCallback = std::function<bool(QuietReason)>;
+
+  /// Get singleton instance
+  static QuiescenceMonitor &instance();
+
+  /// Start the monitor thread
+  /// @param on_quiet Run once on the monitor thread before signalling
+  /// @return false if a monitor is already running
+  bool start(const QuiescenceOptions &options, QuietCallback on_quiet);
+
+  /// Called by every rmw_wait; only the first call after start() matters
+  void notify_wait() {
+    if (awaiting_wait_.load(std::memory_order_relaxed)) {
+      first_wait();
+    }
+  }
+
+  /// Stop the monitor thread without signalling, closing the descriptor
+  void stop();
+
+  /// Whether the quiet callback has run and the descriptor was signalled
+  bool signalled() const {
+    return signalled_.load(std::memory_order_acquire);
+  }
+
+private:
+  QuiescenceMonitor();
+  ~QuiescenceMonitor();
+
+  QuiescenceMonitor(const QuiescenceMonitor &) = delete;
+  QuiescenceMonitor &operator=(const QuiescenceMonitor &) = delete;
+
+  void first_wait();
+  void run();
+  int exit_status(QuietReason reason, bool exported) const;
+
+  std::atomic<bool> awaiting_wait_;
+  std::atomic<bool> signalled_;
+
+  std::mutex mutex_; // Guards everything below
+  std::condition_variable wake_;
+  std::thread thread_;
+  bool stop_;
+  int64_t first_wait_ns_; // 0 until the first rmw_wait
+  int64_t deadline_ns_;   // 0 for none
+  QuiescenceOptions options_;
+  QuietCallback on_quiet_;
+};
+
+/// Start the monitor if any of RMW_INTROSPECT_QUIESCENCE_MS,
+/// RMW_INTROSPECT_READY_FD, RMW_INTROSPECT_DEADLINE_MS or
+/// RMW_INTROSPECT_EXIT_ON_EXPORT is set, running `on_quiet` when the node is
+/// idle. RMW_INTROSPECT_EXIT_ON_EXPORT only applies in recording-only mode.
+/// @return true if the monitor was started
+bool start_quiescence_from_env(QuiescenceMonitor::QuietCallback on_quiet);
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__QUIESCENCE_HPP_
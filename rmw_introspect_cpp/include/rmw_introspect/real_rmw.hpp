@@ -154,6 +154,8 @@ public:
                                      void **);
   rmw_ret_t (*return_loaned_message_from_publisher)(const rmw_publisher_t *,
                                                     void *);
+  rmw_ret_t (*publish_loaned_message)(const rmw_publisher_t *, void *,
+                                      rmw_publisher_allocation_t *);
   rmw_ret_t (*take_loaned_message)(const rmw_subscription_t *, void **, bool *,
                                    rmw_subscription_allocation_t *);
   rmw_ret_t (*take_loaned_message_with_info)(const rmw_subscription_t *,
@@ -207,6 +209,30 @@ public:
                                        rmw_event_type_t);
   rmw_ret_t (*take_event)(const rmw_event_t *, void *, bool *);
   rmw_ret_t (*event_fini)(rmw_event_t *);
+  rmw_ret_t (*event_set_callback)(rmw_event_t *, rmw_event_callback_t,
+                                  const void *); // Optional
+
+  // Preallocation (optional, null if the implementation lacks them)
+  rmw_ret_t (*init_publisher_allocation)(
+      const rosidl_message_type_support_t *,
+      const rosidl_runtime_c__Sequence__bound *, rmw_publisher_allocation_t *);
+  rmw_ret_t (*fini_publisher_allocation)(rmw_publisher_allocation_t *);
+  rmw_ret_t (*init_subscription_allocation)(
+      const rosidl_message_type_support_t *,
+      const rosidl_runtime_c__Sequence__bound *,
+      rmw_subscription_allocation_t *);
+  rmw_ret_t (*fini_subscription_allocation)(rmw_subscription_allocation_t *);
+
+  // New-data callbacks (optional, null if the implementation lacks them)
+  rmw_ret_t (*subscription_set_on_new_message_callback)(rmw_subscription_t *,
+                                                        rmw_event_callback_t,
+                                                        const void *);
+  rmw_ret_t (*service_set_on_new_request_callback)(rmw_service_t *,
+                                                   rmw_event_callback_t,
+                                                   const void *);
+  rmw_ret_t (*client_set_on_new_response_callback)(rmw_client_t *,
+                                                   rmw_event_callback_t,
+                                                   const void *);
 
 private:
   void *lib_handle_;
@@ -0,0 +1,123 @@
+#ifndef RMW_INTROSPECT__RECORDED_GRAPH_HPP_
+#define RMW_INTROSPECT__RECORDED_GRAPH_HPP_
+
+#include "rmw_introspect/recording_wait.hpp"
+#include "rmw_introspect/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Handle of an entity in the RecordedGraph, 0 if it was not added
+using GraphEntryId = uint64_t;
+
+/// Topic or service names, each with its types, sorted by name
+using NamesAndTypes =
+    std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+/// The ROS graph of the live recording-only entities of this process
+///
+/// Answers the graph queries a real RMW answers from discovery: every lookup
+/// is a hash map access by topic, service or node name, and creating or
+/// destroying an entity updates only its own entries. Unlike the records of
+/// IntrospectionData, entries last exactly as long as their entity, so
+/// IntrospectionData::clear() leaves the graph alone.
+class RecordedGraph {
+public:
+  /// Get singleton instance
+  static RecordedGraph &instance();
+
+  /// Add a node; nodes may share a name, as they may in ROS
+  /// @return Id to pass to remove(), 0 on allocation failure
+  GraphEntryId add_node(const std::string &name, const std::string &ns);
+
+  /// Add a publisher or subscription on a topic, or a service or client
+  /// @return Id to pass to remove(), 0 on allocation failure
+  GraphEntryId add_endpoint(EntityKind kind, const std::string &node_name,
+                            const std::string &node_namespace,
+                            const std::string &name, const std::string &type);
+
+  /// Remove an added entity; a no-op for 0
+  void remove(GraphEntryId id);
+
+  /// Number of `kind` endpoints on topic or service `name`
+  size_t count(EntityKind kind, const std::string &name) const;
+
+  /// Names and namespaces of the nodes, one pair per node
+  std::vector<std::pair<std::string, std::string>> node_names() const;
+
+  /// Whether a node of that name lives
+  bool has_node(const std::string &name, const std::string &ns) const;
+
+  /// Topics with a publisher or subscription
+  NamesAndTypes topic_names_and_types() const;
+
+  /// Services with a server or client
+  NamesAndTypes service_names_and_types() const;
+
+  /// Topics or services of the node's `kind` endpoints
+  NamesAndTypes
+  names_and_types_by_node(EntityKind kind, const std::string &node_name,
+                          const std::string &node_namespace) const;
+
+  /// Triggered on every change, shared by the graph guard condition of
+  /// every recording-only node
+  RecordingGuardCondition &guard_condition() { return guard_condition_; }
+
+private:
+  RecordedGraph() = default;
+
+  RecordedGraph(const RecordedGraph &) = delete;
+  RecordedGraph &operator=(const RecordedGraph &) = delete;
+
+  /// Number of endpoints of each type, types sorted for the query results
+  using TypeCounts = std::map<std::string, size_t>;
+
+  /// Endpoints on one topic or service
+  struct NameEntry {
+    size_t counts[kEntityKindCount] = {};
+    TypeCounts types;
+  };
+
+  /// Nodes of one name, and their endpoints by kind and topic or service
+  struct NodeEntry {
+    std::string name;
+    std::string ns;
+    size_t instances = 0;
+    std::unordered_map<std::string, TypeCounts> endpoints[kEntityKindCount];
+  };
+
+  /// What remove() must undo
+  struct Entry {
+    EntityKind kind;
+    std::string node_key;
+    std::string name; // Endpoints only
+    std::string type;
+  };
+
+  /// Topics for publishers and subscriptions, services for the others
+  std::unordered_map<std::string, NameEntry> &names_for(EntityKind kind);
+  const std::unordered_map<std::string, NameEntry> &
+  names_for(EntityKind kind) const;
+
+  static NamesAndTypes
+  collect(const std::unordered_map<std::string, NameEntry> &names);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, NameEntry> topics_;
+  std::unordered_map<std::string, NameEntry> services_;
+  std::unordered_map<std::string, NodeEntry> nodes_; // By namespace and name
+  std::unordered_map<GraphEntryId, Entry> entries_;
+  GraphEntryId next_id_ = 1;
+  RecordingGuardCondition guard_condition_;
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__RECORDED_GRAPH_HPP_
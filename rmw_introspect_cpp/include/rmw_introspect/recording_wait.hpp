@@ -0,0 +1,88 @@
+#ifndef RMW_INTROSPECT__RECORDING_WAIT_HPP_
+#define RMW_INTROSPECT__RECORDING_WAIT_HPP_
+
+#include "rmw/rmw.h"
+#include "rmw/types.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace rmw_introspect {
+
+/// Wakes blocked recording-only waits
+///
+/// Every guard condition trigger bumps a process-wide generation. A wait
+/// reads the generation before checking its guard conditions and blocks
+/// only while it is unchanged, so a trigger racing the check is not lost.
+class WaitNotifier {
+public:
+  /// Get singleton instance
+  static WaitNotifier &instance();
+
+  uint64_t generation() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  /// Bump the generation and wake every blocked wait
+  void notify();
+
+  /// Block until the generation differs from `seen` or `timeout` passes
+  /// @param timeout nullptr to wait without limit
+  /// @return the generation on return
+  uint64_t wait(uint64_t seen, const std::chrono::nanoseconds *timeout);
+
+private:
+  WaitNotifier() = default;
+
+  WaitNotifier(const WaitNotifier &) = delete;
+  WaitNotifier &operator=(const WaitNotifier &) = delete;
+
+  std::atomic<uint64_t> generation_{1};
+  std::atomic<uint32_t> waiters_{0}; // Lets notify() skip the lock when idle
+  std::mutex mutex_;
+  std::condition_variable wake_;
+};
+
+/// Data of a recording-only guard condition
+///
+/// rcl hands rmw_wait the guard condition's data, so this is what a
+/// recording-only wait set holds.
+struct RecordingGuardCondition {
+  std::atomic<bool> triggered{false};
+
+  /// Set the flag and wake blocked waits
+  void trigger() {
+    triggered.store(true);
+    WaitNotifier::instance().notify();
+  }
+
+  /// Whether the guard condition was triggered since the last call
+  bool take() { return triggered.exchange(false); }
+};
+
+/// Parse RMW_INTROSPECT_TIME_SCALE: a positive factor wait timeouts are
+/// divided by, 1 if unset or invalid
+double parse_time_scale(const char *value);
+
+/// RMW_INTROSPECT_TIME_SCALE, read once
+double time_scale();
+
+/// rmw_wait in recording-only mode
+///
+/// Nothing ever arrives on services, clients or events, so those entries are
+/// always cleared, as are subscriptions unless the loopback delivered them a
+/// message. The call blocks for the scaled timeout, or until one of the
+/// guard conditions is triggered or a subscription becomes readable, without
+/// spinning. Triggered guard conditions are left set and reset, like a real
+/// RMW.
+rmw_ret_t recording_only_wait(rmw_subscriptions_t *subscriptions,
+                              rmw_guard_conditions_t *guard_conditions,
+                              rmw_services_t *services, rmw_clients_t *clients,
+                              rmw_events_t *events, rmw_wait_set_t *wait_set,
+                              const rmw_time_t *wait_timeout);
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__RECORDING_WAIT_HPP_
@@ -0,0 +1,232 @@
+#ifndef RMW_INTROSPECT__SEGMENTED_LOG_HPP_
+#define RMW_INTROSPECT__SEGMENTED_LOG_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Next process-wide record sequence number, starting at 1
+///
+/// Shared by every SegmentedLog so records of different kinds can be
+/// ordered against each other at export.
+uint64_t next_record_sequence();
+
+/// Shard used by the calling thread, assigned round-robin on first use
+size_t record_shard(size_t shard_count);
+
+/// Append-only log that never moves a record once written
+///
+/// Appends are lock-free: each thread appends to its own shard, claims a
+/// slot index with one atomic increment, and allocates a segment only when
+/// it is the first to reach it. Segments double in size, so a shard holds
+/// kFirstSegmentSize * (2^kMaxSegments - 1) records. Readers merge the
+/// shards by sequence number; a slot whose writer has not finished yet is
+/// skipped.
+template <typename T, size_t ShardCount = 16> class SegmentedLog {
+public:
+  /// Record and the sequence number it was appended with
+  struct Entry {
+    uint64_t sequence;
+    T value;
+  };
+
+  /// Read position of drain(), one slot index per shard
+  struct Cursor {
+    size_t next[ShardCount] = {};
+  };
+
+  SegmentedLog() = default;
+  ~SegmentedLog() { clear(); }
+
+  SegmentedLog(const SegmentedLog &) = delete;
+  SegmentedLog &operator=(const SegmentedLog &) = delete;
+
+  /// Append a copy of `value`
+  /// @return Sequence number of the record, 0 if it could not be stored
+  uint64_t append(const T &value) {
+    Shard &shard = shards_[record_shard(ShardCount)];
+    const size_t index = shard.next.fetch_add(1, std::memory_order_relaxed);
+
+    size_t segment_index;
+    size_t offset;
+    locate(index, segment_index, offset);
+    if (segment_index >= kMaxSegments) {
+      return 0;
+    }
+    Slot *segment = acquire_segment(shard, segment_index);
+    if (!segment) {
+      return 0;
+    }
+
+    Slot &slot = segment[offset];
+    slot.sequence = next_record_sequence();
+    new (slot.storage) T(value);
+    slot.ready.store(true, std::memory_order_release);
+    return slot.sequence;
+  }
+
+  /// Copy of all completed records, ordered by sequence number
+  std::vector<Entry> sequenced_snapshot() const {
+    std::vector<Entry> entries;
+    for (const Shard &shard : shards_) {
+      const size_t count = shard.next.load(std::memory_order_acquire);
+      for (size_t index = 0; index < count; ++index) {
+        size_t segment_index;
+        size_t offset;
+        locate(index, segment_index, offset);
+        if (segment_index >= kMaxSegments) {
+          break;
+        }
+        const Slot *segment =
+            shard.segments[segment_index].load(std::memory_order_acquire);
+        if (!segment ||
+            !segment[offset].ready.load(std::memory_order_acquire)) {
+          continue;
+        }
+        entries.push_back({segment[offset].sequence, *segment[offset].value()});
+      }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) {
+                return a.sequence < b.sequence;
+              });
+    return entries;
+  }
+
+  /// Copy of all completed records, ordered by sequence number
+  std::vector<T> snapshot() const {
+    std::vector<T> values;
+    for (auto &entry : sequenced_snapshot()) {
+      values.push_back(std::move(entry.value));
+    }
+    return values;
+  }
+
+  /// Pass each record completed since `cursor` to `fn(sequence, value)`
+  ///
+  /// Records come in shard order, not sequence order. A shard is only read
+  /// up to its first unfinished slot, so the cursor never skips a record.
+  /// `fn` returns false to stop early; the record it was given is consumed.
+  /// @return Whether every completed record was read
+  template <typename Fn> bool drain(Cursor &cursor, Fn &&fn) const {
+    for (size_t shard_index = 0; shard_index < ShardCount; ++shard_index) {
+      const Shard &shard = shards_[shard_index];
+      const size_t count = shard.next.load(std::memory_order_acquire);
+      size_t &index = cursor.next[shard_index];
+      while (index < count) {
+        size_t segment_index;
+        size_t offset;
+        locate(index, segment_index, offset);
+        if (segment_index >= kMaxSegments) {
+          break;
+        }
+        const Slot *segment =
+            shard.segments[segment_index].load(std::memory_order_acquire);
+        if (!segment ||
+            !segment[offset].ready.load(std::memory_order_acquire)) {
+          break;
+        }
+        ++index;
+        if (!fn(segment[offset].sequence, *segment[offset].value())) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /// Number of slots claimed so far, including ones still being written
+  size_t size() const {
+    size_t total = 0;
+    for (const Shard &shard : shards_) {
+      total += shard.next.load(std::memory_order_acquire);
+    }
+    return total;
+  }
+
+  /// Drop all records (must not race with append)
+  void clear() {
+    for (Shard &shard : shards_) {
+      for (size_t segment_index = 0; segment_index < kMaxSegments;
+           ++segment_index) {
+        Slot *segment = shard.segments[segment_index].exchange(
+            nullptr, std::memory_order_acq_rel);
+        if (!segment) {
+          continue;
+        }
+        const size_t capacity = kFirstSegmentSize << segment_index;
+        for (size_t offset = 0; offset < capacity; ++offset) {
+          if (segment[offset].ready.load(std::memory_order_relaxed)) {
+            segment[offset].value()->~T();
+          }
+        }
+        delete[] segment;
+      }
+      shard.next.store(0, std::memory_order_release);
+    }
+  }
+
+private:
+  static constexpr size_t kFirstSegmentSize = 64;
+  static constexpr size_t kMaxSegments = 32;
+
+  struct Slot {
+    std::atomic<bool> ready;
+    uint64_t sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    Slot() : ready(false), sequence(0) {}
+    T *value() { return std::launder(reinterpret_cast<T *>(storage)); }
+    const T *value() const {
+      return std::launder(reinterpret_cast<const T *>(storage));
+    }
+  };
+
+  // Cache-line aligned so appends on different shards do not false-share
+  struct alignas(64) Shard {
+    std::atomic<size_t> next{0};
+    std::atomic<Slot *> segments[kMaxSegments] = {};
+  };
+
+  /// Map a shard-local index to its segment and offset
+  static void locate(size_t index, size_t &segment_index, size_t &offset) {
+    // Segment k starts at kFirstSegmentSize * (2^k - 1)
+    const size_t block = index / kFirstSegmentSize + 1;
+    segment_index = 63u - static_cast<size_t>(__builtin_clzll(block));
+    offset = index - kFirstSegmentSize * ((size_t{1} << segment_index) - 1);
+  }
+
+  /// Get a segment, allocating it if this is the first writer to reach it
+  static Slot *acquire_segment(Shard &shard, size_t segment_index) {
+    Slot *segment =
+        shard.segments[segment_index].load(std::memory_order_acquire);
+    if (segment) {
+      return segment;
+    }
+    Slot *fresh =
+        new (std::nothrow) Slot[kFirstSegmentSize << segment_index];
+    if (!fresh) {
+      return nullptr;
+    }
+    if (shard.segments[segment_index].compare_exchange_strong(
+            segment, fresh, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+      return fresh;
+    }
+    // Another writer installed it first
+    delete[] fresh;
+    return segment;
+  }
+
+  Shard shards_[ShardCount];
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__SEGMENTED_LOG_HPP_
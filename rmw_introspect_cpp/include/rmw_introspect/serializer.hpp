@@ -0,0 +1,114 @@
+#ifndef RMW_INTROSPECT__SERIALIZER_HPP_
+#define RMW_INTROSPECT__SERIALIZER_HPP_
+
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/json_writer.hpp"
+#include "rmw_introspect/output_buffer.hpp"
+#include "rmw_introspect/yaml_writer.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+namespace rmw_introspect {
+
+/// Document-level fields of an export
+struct ExportHeader {
+  const char *format_version;
+  const char *timestamp; // UTC, ISO 8601
+  const char *rmw_implementation;
+};
+
+/// One publisher, subscription, service or client as the sinks see it
+///
+/// Points into the snapshot being serialized. At most one of the stats
+/// pointers is set, matching `kind`, and only in intermediate mode.
+struct EndpointView {
+  EntityKind kind;
+  InternedString node_name;
+  InternedString node_namespace;
+  InternedString name; // Topic or service name
+  InternedString type; // Message or service type
+  const QoSProfile *qos;
+  double timestamp;
+  const PublisherStats *publisher_stats;
+  const SubscriptionStats *subscription_stats;
+  const ServiceStats *service_stats;
+  const ClientStats *client_stats;
+};
+
+/// Receiver of one serializer walk
+///
+/// The serializer calls begin(), then for each entity kind in the order of
+/// EntityKind begin_section(), node() or endpoint() per record and
+/// end_section(), then end(). Sinks format straight into OutputBuffers.
+class ExportSink {
+public:
+  virtual ~ExportSink() = default;
+
+  virtual void begin(const ExportHeader &header) = 0;
+  virtual void begin_section(EntityKind kind) = 0;
+  virtual void node(InternedString name) = 0;
+  virtual void endpoint(const EndpointView &endpoint) = 0;
+  virtual void end_section(EntityKind kind) = 0;
+  virtual void end() = 0;
+};
+
+/// Walk `snapshot` once, feeding every record to each sink
+void serialize(const IntrospectionSnapshot &snapshot,
+               const ExportHeader &header,
+               std::initializer_list<ExportSink *> sinks);
+
+/// Key of an entity kind's section: "nodes", "publishers", ...
+const char *section_name(EntityKind kind);
+
+/// Expected size of the JSON or YAML document for `snapshot`
+size_t estimate_export_bytes(const IntrospectionSnapshot &snapshot);
+
+/// The JSON document or its YAML equivalent, through JsonWriter or YamlWriter
+template <typename Writer> class DocumentSink : public ExportSink {
+public:
+  explicit DocumentSink(OutputBuffer &out) : writer_(out) {}
+
+  void begin(const ExportHeader &header) override;
+  void begin_section(EntityKind kind) override;
+  void node(InternedString name) override;
+  void endpoint(const EndpointView &endpoint) override;
+  void end_section(EntityKind kind) override;
+  void end() override;
+
+private:
+  Writer writer_;
+};
+
+using JsonSink = DocumentSink<JsonWriter>;
+using YamlSink = DocumentSink<YamlWriter>;
+
+/// One CSV table per entity kind, each with a header row
+///
+/// Columns are the endpoint fields, QoS and timestamp, followed by the
+/// kind's stats counters, which are left empty in recording-only mode.
+/// Fields are quoted as RFC 4180 requires only when they contain a comma,
+/// quote or line break.
+class CsvSink : public ExportSink {
+public:
+  /// One output per EntityKind, indexed by its value; null skips the kind
+  explicit CsvSink(OutputBuffer *const (&outputs)[kEntityKindCount]);
+
+  void begin(const ExportHeader &header) override;
+  void begin_section(EntityKind kind) override;
+  void node(InternedString name) override;
+  void endpoint(const EndpointView &endpoint) override;
+  void end_section(EntityKind kind) override;
+  void end() override;
+
+private:
+  OutputBuffer *outputs_[kEntityKindCount];
+};
+
+/// Path of the CSV table of `kind` for an export to `output_path`
+/// "graph.json" -> "graph.publishers.csv"
+std::string csv_output_path(const std::string &output_path, EntityKind kind);
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__SERIALIZER_HPP_
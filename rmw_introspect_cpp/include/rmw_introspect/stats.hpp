@@ -0,0 +1,140 @@
+#ifndef RMW_INTROSPECT__STATS_HPP_
+#define RMW_INTROSPECT__STATS_HPP_
+
+#include "rmw/types.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace rmw_introspect {
+
+/// Wall-clock time in nanoseconds since the epoch
+inline int64_t wall_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Monotonic time in nanoseconds, for measuring intervals
+inline int64_t steady_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Counters for a new-data callback forwarded to the real RMW
+///
+/// The real RMW calls back when data becomes available; the time from the
+/// first pending delivery to the next successful take is how long the
+/// executor took to react.
+struct CallbackStats {
+  std::atomic<uint64_t> invocations{0};
+  std::atomic<uint64_t> events{0}; // Sum of reported number_of_events
+  std::atomic<int64_t> pending_since_ns{0}; // Steady time, 0 if none pending
+
+  std::atomic<uint64_t> take_delay_samples{0};
+  std::atomic<uint64_t> take_delay_total_ns{0};
+  std::atomic<uint64_t> take_delay_max_ns{0};
+
+  /// Record one callback delivered by the real RMW
+  void record_callback(size_t number_of_events) {
+    invocations.fetch_add(1, std::memory_order_relaxed);
+    events.fetch_add(number_of_events, std::memory_order_relaxed);
+    if (pending_since_ns.load(std::memory_order_relaxed) == 0) {
+      int64_t expected = 0;
+      pending_since_ns.compare_exchange_strong(expected, steady_time_ns(),
+                                               std::memory_order_relaxed);
+    }
+  }
+
+  /// Record a successful take, closing the pending delivery if any
+  void record_take() {
+    // Plain load first so takes without callbacks stay read-only
+    if (pending_since_ns.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    const int64_t since =
+        pending_since_ns.exchange(0, std::memory_order_relaxed);
+    if (since == 0) {
+      return;
+    }
+    const int64_t elapsed = steady_time_ns() - since;
+    const uint64_t delay = elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+    take_delay_samples.fetch_add(1, std::memory_order_relaxed);
+    take_delay_total_ns.fetch_add(delay, std::memory_order_relaxed);
+    uint64_t max = take_delay_max_ns.load(std::memory_order_relaxed);
+    while (delay > max && !take_delay_max_ns.compare_exchange_weak(
+                              max, delay, std::memory_order_relaxed)) {
+    }
+  }
+};
+
+/// QoS event counts for one endpoint, summed from each taken event's
+/// total_count_change
+struct QoSEventStats {
+  std::atomic<uint64_t> deadline_missed{0};
+  std::atomic<uint64_t> liveliness_lost{0};
+  std::atomic<uint64_t> messages_lost{0};
+  std::atomic<uint64_t> incompatible_qos{0};
+};
+
+/// Per-publisher traffic counters
+///
+/// Updated with relaxed atomics on the forwarding path. Cache-line aligned
+/// so that publishers hammered from different threads do not false-share.
+struct alignas(64) PublisherStats {
+  std::atomic<uint64_t> messages{0};
+  std::atomic<uint64_t> serialized_bytes{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<int64_t> first_publish_ns{0};
+  std::atomic<int64_t> last_publish_ns{0};
+
+  // Loan lifecycle, to confirm zero-copy is in use
+  std::atomic<uint64_t> loans_borrowed{0};
+  std::atomic<uint64_t> loans_published{0};
+  std::atomic<uint64_t> loans_returned{0};
+
+  QoSEventStats qos_events; // Offered deadline, liveliness, incompatible QoS
+
+  /// Record the outcome of one forwarded publish call
+  /// @param bytes Serialized payload size, 0 if unknown (typed publish)
+  void record_publish(rmw_ret_t ret, size_t bytes) {
+    if (ret != RMW_RET_OK) {
+      errors.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const int64_t now = wall_time_ns();
+    messages.fetch_add(1, std::memory_order_relaxed);
+    serialized_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (first_publish_ns.load(std::memory_order_relaxed) == 0) {
+      int64_t expected = 0;
+      first_publish_ns.compare_exchange_strong(expected, now,
+                                               std::memory_order_relaxed);
+    }
+    last_publish_ns.store(now, std::memory_order_relaxed);
+  }
+};
+
+/// Per-subscription counters, updated like PublisherStats
+struct alignas(64) SubscriptionStats {
+  std::atomic<uint64_t> loans_taken{0};
+  std::atomic<uint64_t> loans_returned{0};
+
+  CallbackStats callbacks; // rmw_subscription_set_on_new_message_callback
+  QoSEventStats qos_events; // Requested deadline, lost, incompatible QoS
+};
+
+/// Per-service counters, updated like PublisherStats
+struct alignas(64) ServiceStats {
+  CallbackStats callbacks; // rmw_service_set_on_new_request_callback
+};
+
+/// Per-client counters, updated like PublisherStats
+struct alignas(64) ClientStats {
+  CallbackStats callbacks; // rmw_client_set_on_new_response_callback
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__STATS_HPP_
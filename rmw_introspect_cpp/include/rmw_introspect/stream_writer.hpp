@@ -0,0 +1,88 @@
+#ifndef RMW_INTROSPECT__STREAM_WRITER_HPP_
+#define RMW_INTROSPECT__STREAM_WRITER_HPP_
+
+#include "rmw_introspect/data.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace rmw_introspect {
+
+/// Background writer of the NDJSON event stream
+///
+/// Creation paths only append to IntrospectionData's logs. Every interval,
+/// or as soon as about buffer_bytes worth of records are waiting, this
+/// thread picks up the new records and appends them to the stream file with
+/// write(2), so a process that crashes or is killed still leaves everything
+/// up to the last interval on disk. At most buffer_bytes of formatted lines
+/// are held before they are written out.
+class StreamWriter {
+public:
+  /// Get singleton instance
+  static StreamWriter &instance();
+
+  /// Create `path`, write the header line and start the writer thread
+  /// @return false if the file cannot be created or a stream is running
+  bool start(const std::string &path, std::chrono::milliseconds interval,
+             size_t buffer_bytes);
+
+  /// Write out every record completed so far
+  void flush();
+
+  /// Flush, stop the writer thread and close the file
+  void stop();
+
+  /// Whether a stream is open
+  bool running() const;
+
+private:
+  StreamWriter();
+  ~StreamWriter();
+
+  StreamWriter(const StreamWriter &) = delete;
+  StreamWriter &operator=(const StreamWriter &) = delete;
+
+  void run();
+
+  /// Change listener: wake the thread to drain before the interval is up
+  static void on_changes();
+
+  /// Drain the logs into the file (write_mutex_ held)
+  void drain_locked();
+
+  /// Write `buffer_` out and empty it (write_mutex_ held)
+  void write_buffer_locked();
+
+  mutable std::mutex mutex_; // Guards thread_, stop_ and drain_requested_
+  std::condition_variable wake_;
+  std::thread thread_;
+  bool stop_;
+  bool drain_requested_;
+
+  std::mutex write_mutex_; // Serializes drains from the thread and flush()
+  int fd_;
+  IntrospectionData::StreamCursor cursor_;
+  std::string buffer_;
+  std::chrono::milliseconds interval_;
+  size_t buffer_bytes_;
+  uint64_t drain_changes_; // Changes that trigger a drain before interval_
+};
+
+/// Whether RMW_INTROSPECT_STREAM asks for the event stream
+bool stream_enabled();
+
+/// Path of the event stream that sits next to the introspection output
+/// ("graph.json" -> "graph.ndjson")
+std::string stream_output_path(const std::string &output_path);
+
+/// Start the stream next to `output_path` with the interval and buffer size
+/// from RMW_INTROSPECT_STREAM_INTERVAL_MS and RMW_INTROSPECT_STREAM_BYTES
+bool start_stream_from_env(const std::string &output_path);
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__STREAM_WRITER_HPP_
@@ -0,0 +1,88 @@
+#ifndef RMW_INTROSPECT__STRING_TABLE_HPP_
+#define RMW_INTROSPECT__STRING_TABLE_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace rmw_introspect {
+
+/// Index of a string in the StringTable, 0 is the empty string
+using StringId = uint32_t;
+
+/// Process-wide table of interned node, topic and type names
+///
+/// Strings are only ever added, so an id and the reference returned by
+/// lookup() stay valid for the life of the process. Names repeat far more
+/// often than they are new, so lookups and hits share the lock and only a
+/// miss takes it exclusively.
+class StringTable {
+public:
+  /// Get singleton instance
+  static StringTable &instance();
+
+  /// Get the id of `str`, adding it on first use
+  StringId intern(std::string_view str);
+
+  /// Get the string for an id returned by intern()
+  const std::string &lookup(StringId id) const;
+
+  /// Number of distinct strings, including the empty string
+  size_t size() const;
+
+private:
+  StringTable();
+
+  StringTable(const StringTable &) = delete;
+  StringTable &operator=(const StringTable &) = delete;
+
+  std::deque<std::string> strings_; // Deque: elements never move
+  std::unordered_map<std::string_view, StringId> ids_; // Views into strings_
+  mutable std::shared_mutex mutex_;
+};
+
+/// Interned string handle, the size of a StringId
+///
+/// Converts implicitly from strings so records can be filled in as before;
+/// the text is only looked up again when exporting.
+class InternedString {
+public:
+  InternedString() : id_(0) {}
+  InternedString(const char *str)
+      : id_(str ? StringTable::instance().intern(str) : 0) {}
+  InternedString(const std::string &str)
+      : id_(StringTable::instance().intern(str)) {}
+
+  StringId id() const { return id_; }
+  const std::string &str() const { return StringTable::instance().lookup(id_); }
+  const char *c_str() const { return str().c_str(); }
+  bool empty() const { return id_ == 0; }
+
+  friend bool operator==(InternedString a, InternedString b) {
+    return a.id_ == b.id_;
+  }
+  friend bool operator!=(InternedString a, InternedString b) {
+    return a.id_ != b.id_;
+  }
+  friend bool operator==(InternedString a, const std::string &b) {
+    return a.str() == b;
+  }
+  friend bool operator==(InternedString a, const char *b) {
+    return std::strcmp(a.c_str(), b) == 0;
+  }
+  friend std::ostream &operator<<(std::ostream &os, InternedString s) {
+    return os << s.str();
+  }
+
+private:
+  StringId id_;
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__STRING_TABLE_HPP_
@@ -17,6 +17,15 @@ extract_message_type(const rosidl_message_type_support_t *type_support);
 std::string
 extract_service_type(const rosidl_service_type_support_t *type_support);
 
+/// Check whether a message has a fixed maximum size
+///
+/// A message is bounded when neither it nor any nested message contains an
+/// unbounded string or sequence. Uses C++ introspection, falling back to C.
+/// @param bounded Set on success
+/// @return false if the type support has no introspection data
+bool is_message_bounded(const rosidl_message_type_support_t *type_support,
+                        bool *bounded);
+
 } // namespace rmw_introspect
 
 #endif // RMW_INTROSPECT__TYPE_SUPPORT_HPP_
@@ -2,17 +2,68 @@
 #define RMW_INTROSPECT__TYPES_HPP_
 
 #include "rmw/types.h"
+#include "rmw_introspect/stats.hpp"
+#include "rmw_introspect/string_table.hpp"
+#include <cstddef>
 #include <cstdint>
-#include <string>
+#include <memory>
 
 namespace rmw_introspect {
 
+/// Sequence number of an entity's creation record, 0 if it was not recorded
+using RecordId = uint64_t;
+
+/// Kind of entity in the lifecycle timeline
+enum class EntityKind : uint8_t {
+  Node,
+  Publisher,
+  Subscription,
+  Service,
+  Client
+};
+
+/// Number of EntityKind values, for tables indexed by kind
+constexpr size_t kEntityKindCount = static_cast<size_t>(EntityKind::Client) + 1;
+
+/// Export name of an entity kind, e.g. "publisher"
+const char *to_string(EntityKind kind);
+
+/// Creation or destruction of an entity
+///
+/// A destruction refers to the creation it ends by record_id, so the two can
+/// be paired up at export however the handles were reused in between.
+struct LifecycleEvent {
+  EntityKind kind;
+  bool destroyed;
+  RecordId record_id;
+  int64_t time_ns; // steady_time_ns()
+  // Creation only: the owning node, or the node itself, and for endpoints the
+  // topic or service name
+  InternedString node_name;
+  InternedString node_namespace;
+  InternedString name;
+};
+
+/// Reliability policy, exported as "reliable", "best_effort" or "unknown"
+enum class QoSReliability : uint8_t { Unknown, Reliable, BestEffort };
+
+/// Durability policy, exported as "transient_local", "volatile" or "unknown"
+enum class QoSDurability : uint8_t { Unknown, TransientLocal, Volatile };
+
+/// History policy, exported as "keep_last", "keep_all" or "unknown"
+enum class QoSHistory : uint8_t { Unknown, KeepLast, KeepAll };
+
+/// Export names of the QoS policies
+const char *to_string(QoSReliability reliability);
+const char *to_string(QoSDurability durability);
+const char *to_string(QoSHistory history);
+
 /// QoS profile structure
 struct QoSProfile {
-  std::string reliability; // "reliable" or "best_effort"
-  std::string durability;  // "transient_local" or "volatile"
-  std::string history;     // "keep_last" or "keep_all"
-  uint32_t depth;
+  QoSReliability reliability = QoSReliability::Unknown;
+  QoSDurability durability = QoSDurability::Unknown;
+  QoSHistory history = QoSHistory::Unknown;
+  uint32_t depth = 0;
 
   /// Create QoSProfile from rmw_qos_profile_t
   static QoSProfile from_rmw(const rmw_qos_profile_t &qos);
@@ -20,42 +71,46 @@ struct QoSProfile {
 
 /// Publisher metadata
 struct PublisherInfo {
-  std::string node_name;
-  std::string node_namespace;
-  std::string topic_name;
-  std::string message_type; // e.g., "sensor_msgs/msg/Image"
+  InternedString node_name;
+  InternedString node_namespace;
+  InternedString topic_name;
+  InternedString message_type; // e.g., "sensor_msgs/msg/Image"
   QoSProfile qos;
   double timestamp; // When created
+  std::shared_ptr<PublisherStats> stats; // Intermediate mode only
 };
 
 /// Subscription metadata
 struct SubscriptionInfo {
-  std::string node_name;
-  std::string node_namespace;
-  std::string topic_name;
-  std::string message_type;
+  InternedString node_name;
+  InternedString node_namespace;
+  InternedString topic_name;
+  InternedString message_type;
   QoSProfile qos;
   double timestamp;
+  std::shared_ptr<SubscriptionStats> stats; // Intermediate mode only
 };
 
 /// Service metadata
 struct ServiceInfo {
-  std::string node_name;
-  std::string node_namespace;
-  std::string service_name;
-  std::string service_type; // e.g., "std_srvs/srv/SetBool"
+  InternedString node_name;
+  InternedString node_namespace;
+  InternedString service_name;
+  InternedString service_type; // e.g., "std_srvs/srv/SetBool"
   QoSProfile qos;
   double timestamp;
+  std::shared_ptr<ServiceStats> stats; // Intermediate mode only
 };
 
 /// Client metadata
 struct ClientInfo {
-  std::string node_name;
-  std::string node_namespace;
-  std::string service_name;
-  std::string service_type;
+  InternedString node_name;
+  InternedString node_namespace;
+  InternedString service_name;
+  InternedString service_type;
   QoSProfile qos;
   double timestamp;
+  std::shared_ptr<ClientStats> stats; // Intermediate mode only
 };
 
 } // namespace rmw_introspect
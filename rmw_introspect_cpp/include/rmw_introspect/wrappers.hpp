@@ -3,7 +3,17 @@
 
 #include "rmw/rmw.h"
 #include "rmw/types.h"
+#include "rmw_introspect/latency_histogram.hpp"
+#include "rmw_introspect/loopback.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
+#include "rmw_introspect/stats.hpp"
+#include "rmw_introspect/string_table.hpp"
+#include "rmw_introspect/types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace rmw_introspect {
 
@@ -26,61 +36,111 @@ struct ContextWrapper {
 /// Wrapper for rmw_node_t
 struct NodeWrapper {
   rmw_node_t *real_node;
-  std::string name;
-  std::string namespace_;
+  InternedString name;
+  InternedString namespace_;
+  RecordId record_id = 0; // Closed in IntrospectionData on destroy
 
   NodeWrapper(rmw_node_t *real, const char *n, const char *ns);
   ~NodeWrapper() = default;
 };
 
+/// Stands in for an application's new-data callback at the real RMW
+///
+/// The real RMW is given invoke() with the trampoline as user data, so each
+/// delivery is counted before the application's callback runs; without
+/// stats it only forwards. Fields are only changed while the trampoline is
+/// not registered with the real RMW.
+struct CallbackTrampoline {
+  rmw_event_callback_t callback;
+  const void *user_data;
+  CallbackStats *stats;
+
+  explicit CallbackTrampoline(CallbackStats *s);
+
+  /// rmw_event_callback_t registered with the real RMW
+  static void invoke(const void *trampoline, size_t number_of_events);
+};
+
 /// Wrapper for rmw_publisher_t
 struct PublisherWrapper {
   rmw_publisher_t *real_publisher;
-  std::string topic_name;
-  std::string message_type;
+  InternedString topic_name;
+  InternedString message_type;
   rmw_qos_profile_t qos;
+  std::shared_ptr<PublisherStats> stats; // Shared with the PublisherInfo
+  std::shared_ptr<LatencyHistogram> publish_latency; // Null if disabled
+  RecordId record_id = 0;
 
-  PublisherWrapper(rmw_publisher_t *real, const std::string &topic,
-                   const std::string &type, const rmw_qos_profile_t &q);
+  PublisherWrapper(rmw_publisher_t *real, InternedString topic,
+                   InternedString type, const rmw_qos_profile_t &q,
+                   std::shared_ptr<PublisherStats> s);
   ~PublisherWrapper() = default;
 };
 
 /// Wrapper for rmw_subscription_t
 struct SubscriptionWrapper {
   rmw_subscription_t *real_subscription;
-  std::string topic_name;
-  std::string message_type;
+  InternedString topic_name;
+  InternedString message_type;
   rmw_qos_profile_t qos;
-
-  SubscriptionWrapper(rmw_subscription_t *real, const std::string &topic,
-                      const std::string &type, const rmw_qos_profile_t &q);
+  std::shared_ptr<SubscriptionStats> stats; // Shared with the SubscriptionInfo
+  std::shared_ptr<LatencyHistogram> take_latency; // Null if disabled
+  RecordId record_id = 0;
+  CallbackTrampoline on_new_message;
+
+  SubscriptionWrapper(rmw_subscription_t *real, InternedString topic,
+                      InternedString type, const rmw_qos_profile_t &q,
+                      std::shared_ptr<SubscriptionStats> s);
   ~SubscriptionWrapper() = default;
 };
 
 /// Wrapper for rmw_service_t
 struct ServiceWrapper {
   rmw_service_t *real_service;
-  std::string service_name;
-  std::string service_type;
+  InternedString service_name;
+  InternedString service_type;
   rmw_qos_profile_t qos;
-
-  ServiceWrapper(rmw_service_t *real, const std::string &name,
-                 const std::string &type, const rmw_qos_profile_t &q);
+  std::shared_ptr<ServiceStats> stats; // Shared with the ServiceInfo
+  std::shared_ptr<LatencyHistogram> send_response_latency; // Null if disabled
+  RecordId record_id = 0;
+  CallbackTrampoline on_new_request;
+
+  ServiceWrapper(rmw_service_t *real, InternedString name,
+                 InternedString type, const rmw_qos_profile_t &q,
+                 std::shared_ptr<ServiceStats> s);
   ~ServiceWrapper() = default;
 };
 
 /// Wrapper for rmw_client_t
 struct ClientWrapper {
   rmw_client_t *real_client;
-  std::string service_name;
-  std::string service_type;
+  InternedString service_name;
+  InternedString service_type;
   rmw_qos_profile_t qos;
-
-  ClientWrapper(rmw_client_t *real, const std::string &name,
-                const std::string &type, const rmw_qos_profile_t &q);
+  std::shared_ptr<ClientStats> stats; // Shared with the ClientInfo
+  std::shared_ptr<LatencyHistogram> send_request_latency; // Null if disabled
+  RecordId record_id = 0;
+  CallbackTrampoline on_new_response;
+
+  ClientWrapper(rmw_client_t *real, InternedString name,
+                InternedString type, const rmw_qos_profile_t &q,
+                std::shared_ptr<ClientStats> s);
   ~ClientWrapper() = default;
 };
 
+/// Data of a recording-only publisher, subscription, service or client
+///
+/// There is no real handle to forward to; this only carries what destroy
+/// needs to close the entity's lifecycle record and leave the graph.
+struct RecordingEntity {
+  RecordId record_id;
+  GraphEntryId graph_id = 0; // Removed from the RecordedGraph on destroy
+  /// Publishers and subscriptions under RMW_INTROSPECT_LOOPBACK only
+  std::unique_ptr<LoopbackEndpoint> loopback;
+
+  explicit RecordingEntity(RecordId id) : record_id(id) {}
+};
+
 /// Wrapper for rmw_guard_condition_t
 struct GuardConditionWrapper {
   rmw_guard_condition_t *real_guard_condition;
@@ -89,12 +149,67 @@ struct GuardConditionWrapper {
   ~GuardConditionWrapper() = default;
 };
 
+/// Wrapper stored in rmw_publisher_allocation_t::data
+///
+/// The caller owns the rmw_publisher_allocation_t, so the real RMW's
+/// allocation is held by value and handed out on publish.
+struct PublisherAllocationWrapper {
+  rmw_publisher_allocation_t real_allocation;
+
+  PublisherAllocationWrapper();
+  ~PublisherAllocationWrapper() = default;
+};
+
+/// Wrapper stored in rmw_subscription_allocation_t::data
+struct SubscriptionAllocationWrapper {
+  rmw_subscription_allocation_t real_allocation;
+
+  SubscriptionAllocationWrapper();
+  ~SubscriptionAllocationWrapper() = default;
+};
+
+/// Wrapper stored in rmw_event_t::data
+///
+/// The caller owns the rmw_event_t, so the real RMW's event is held by value
+/// like the allocations. Taken events are counted into the endpoint's stats.
+struct EventWrapper {
+  rmw_event_t real_event;
+  std::shared_ptr<QoSEventStats> stats; // Aliases the endpoint's stats
+  CallbackStats callback_stats;
+  CallbackTrampoline on_event;
+
+  explicit EventWrapper(std::shared_ptr<QoSEventStats> s);
+  ~EventWrapper() = default;
+
+  /// Count a taken event from the status struct rmw_take_event filled in
+  void record_taken(const void *event_info);
+};
+
 /// Wrapper for rmw_wait_set_t
+///
+/// Owns grow-only scratch arrays for the unwrapped handles passed to the real
+/// rmw_wait, so a steady-state wait performs no heap allocation.
 struct WaitSetWrapper {
   rmw_wait_set_t *real_wait_set;
 
-  explicit WaitSetWrapper(rmw_wait_set_t *real);
+  std::vector<void *> subscriptions_scratch;
+  std::vector<void *> guard_conditions_scratch;
+  std::vector<void *> services_scratch;
+  std::vector<void *> clients_scratch;
+  std::vector<void *> events_scratch;
+
+  /// Number of scratch requests served without allocating
+  std::atomic<uint64_t> allocations_avoided;
+  /// Number of scratch requests that had to grow an array
+  std::atomic<uint64_t> scratch_grows;
+
+  std::shared_ptr<LatencyHistogram> wait_latency; // Null if disabled
+
+  WaitSetWrapper(rmw_wait_set_t *real, size_t max_conditions);
   ~WaitSetWrapper() = default;
+
+  /// Get a scratch array with room for at least `count` handles
+  void **acquire_scratch(std::vector<void *> &scratch, size_t count);
 };
 
 } // namespace rmw_introspect
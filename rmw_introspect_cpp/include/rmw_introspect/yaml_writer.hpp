@@ -0,0 +1,79 @@
+#ifndef RMW_INTROSPECT__YAML_WRITER_HPP_
+#define RMW_INTROSPECT__YAML_WRITER_HPP_
+
+#include "rmw_introspect/output_buffer.hpp"
+#include "rmw_introspect/string_table.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace rmw_introspect {
+
+/// Block-style YAML emitter with the same interface as JsonWriter
+///
+/// Mappings and sequences are indented by two spaces, mappings inside a
+/// sequence start on the "- " line, and empty ones are written as {} and
+/// []. Strings are double-quoted with JSON escapes, which YAML accepts, so
+/// no name can be misread as another type. Keys are written as given and
+/// must be plain identifiers.
+class YamlWriter {
+public:
+  explicit YamlWriter(OutputBuffer &out);
+
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+
+  void key(std::string_view name);
+
+  void value(std::string_view str);
+  void value(const char *str) { value(std::string_view(str ? str : "")); }
+  void value(const std::string &str) { value(std::string_view(str)); }
+  void value(InternedString str) { value(std::string_view(str.str())); }
+  void value(bool b);
+  void value(double number); // null if not finite
+  template <typename T>
+  std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>
+  value(T number) {
+    begin_scalar();
+    if constexpr (std::is_signed_v<T>) {
+      out_.write_signed(static_cast<int64_t>(number));
+    } else {
+      out_.write_unsigned(static_cast<uint64_t>(number));
+    }
+  }
+  void null();
+
+  template <typename T> void member(std::string_view name, const T &v) {
+    key(name);
+    value(v);
+  }
+
+private:
+  /// Position a scalar after its key or on a new "- " line
+  void begin_scalar();
+  void begin(bool is_array);
+  void end(const char *empty);
+  /// Start a sequence item: newline, indentation and "- "
+  void begin_item();
+  void newline(size_t indent);
+
+  struct Scope {
+    bool is_array;
+    bool empty;
+    bool after_key; // Value of a key, written as "key: []" when empty
+    size_t indent;  // Of the scope's keys or "- " markers
+  };
+
+  OutputBuffer &out_;
+  std::vector<Scope> scopes_;
+  bool after_key_;  // "key:" written, value pending
+  bool after_dash_; // "- " written, item pending
+};
+
+} // namespace rmw_introspect
+
+#endif // RMW_INTROSPECT__YAML_WRITER_HPP_
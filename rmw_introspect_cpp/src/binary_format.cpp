@@ -0,0 +1,322 @@
+#include "rmw_introspect/binary_format.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace rmw_introspect {
+
+namespace {
+
+size_t align8(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+/// Renumbers process-wide string ids densely for one file
+class StringRemap {
+public:
+  StringRemap() { add(InternedString()); }
+
+  uint32_t add(InternedString str) {
+    auto inserted =
+        ids_.emplace(str.id(), static_cast<uint32_t>(strings_.size()));
+    if (inserted.second) {
+      strings_.push_back(str);
+    }
+    return inserted.first->second;
+  }
+
+  const std::vector<InternedString> &strings() const { return strings_; }
+
+private:
+  std::unordered_map<StringId, uint32_t> ids_;
+  std::vector<InternedString> strings_; // By file id
+};
+
+template <typename T>
+void put(std::vector<char> &buffer, size_t offset, const T &value) {
+  std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename Info>
+BinaryEndpoint make_endpoint(EntityKind kind, const Info &info,
+                             InternedString name, InternedString type,
+                             StringRemap &strings) {
+  BinaryEndpoint endpoint{};
+  endpoint.kind = static_cast<uint8_t>(kind);
+  endpoint.reliability = static_cast<uint8_t>(info.qos.reliability);
+  endpoint.durability = static_cast<uint8_t>(info.qos.durability);
+  endpoint.history = static_cast<uint8_t>(info.qos.history);
+  endpoint.depth = info.qos.depth;
+  endpoint.node_name = strings.add(info.node_name);
+  endpoint.node_namespace = strings.add(info.node_namespace);
+  endpoint.name = strings.add(name);
+  endpoint.type = strings.add(type);
+  endpoint.timestamp = info.timestamp;
+  return endpoint;
+}
+
+} // namespace
+
+bool write_binary(const std::string &path,
+                  const IntrospectionSnapshot &snapshot) {
+  StringRemap strings;
+
+  std::vector<BinaryNode> nodes;
+  nodes.reserve(snapshot.nodes.size());
+  for (const auto &node : snapshot.nodes) {
+    nodes.push_back({strings.add(node), 0});
+  }
+
+  std::vector<BinaryEndpoint> endpoints;
+  endpoints.reserve(snapshot.publishers.size() + snapshot.subscriptions.size() +
+                    snapshot.services.size() + snapshot.clients.size());
+  for (const auto &pub : snapshot.publishers) {
+    endpoints.push_back(make_endpoint(EntityKind::Publisher, pub,
+                                      pub.topic_name, pub.message_type,
+                                      strings));
+  }
+  for (const auto &sub : snapshot.subscriptions) {
+    endpoints.push_back(make_endpoint(EntityKind::Subscription, sub,
+                                      sub.topic_name, sub.message_type,
+                                      strings));
+  }
+  for (const auto &srv : snapshot.services) {
+    endpoints.push_back(make_endpoint(EntityKind::Service, srv,
+                                      srv.service_name, srv.service_type,
+                                      strings));
+  }
+  for (const auto &cli : snapshot.clients) {
+    endpoints.push_back(make_endpoint(EntityKind::Client, cli,
+                                      cli.service_name, cli.service_type,
+                                      strings));
+  }
+
+  // Group endpoint indices by name, names sorted for binary search
+  std::unordered_map<uint32_t, std::vector<uint32_t>> by_name;
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    by_name[endpoints[i].name].push_back(static_cast<uint32_t>(i));
+  }
+  std::vector<uint32_t> names;
+  names.reserve(by_name.size());
+  for (const auto &entry : by_name) {
+    names.push_back(entry.first);
+  }
+  const auto &table = strings.strings();
+  std::sort(names.begin(), names.end(), [&](uint32_t a, uint32_t b) {
+    return table[a].str() < table[b].str();
+  });
+
+  size_t string_data_size = 0;
+  for (const auto &str : table) {
+    string_data_size += str.str().size() + 1;
+  }
+
+  // Lay out the sections
+  BinaryHeader header{};
+  std::memcpy(header.magic, kBinaryMagic, sizeof(header.magic));
+  header.version_major = kBinaryVersionMajor;
+  header.version_minor = kBinaryVersionMinor;
+  header.header_size = sizeof(BinaryHeader);
+  header.created_unix = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+  header.string_count = static_cast<uint32_t>(table.size());
+  header.string_data_size = static_cast<uint32_t>(string_data_size);
+  header.node_count = static_cast<uint32_t>(nodes.size());
+  header.node_record_size = sizeof(BinaryNode);
+  header.endpoint_count = static_cast<uint32_t>(endpoints.size());
+  header.endpoint_record_size = sizeof(BinaryEndpoint);
+  header.topic_index_count = static_cast<uint32_t>(names.size());
+  header.topic_ref_count = static_cast<uint32_t>(endpoints.size());
+
+  size_t offset = align8(sizeof(BinaryHeader));
+  header.strings_offset = offset;
+  offset = align8(offset + table.size() * sizeof(BinaryString));
+  header.string_data_offset = offset;
+  offset = align8(offset + string_data_size);
+  header.nodes_offset = offset;
+  offset = align8(offset + nodes.size() * sizeof(BinaryNode));
+  header.endpoints_offset = offset;
+  offset = align8(offset + endpoints.size() * sizeof(BinaryEndpoint));
+  header.topic_index_offset = offset;
+  offset = align8(offset + names.size() * sizeof(BinaryTopicIndex));
+  header.topic_refs_offset = offset;
+  offset += endpoints.size() * sizeof(uint32_t);
+
+  // Fill one zeroed buffer, padding included
+  std::vector<char> buffer(offset, 0);
+  put(buffer, 0, header);
+
+  uint32_t data_offset = 0;
+  for (size_t i = 0; i < table.size(); ++i) {
+    const std::string &str = table[i].str();
+    put(buffer, header.strings_offset + i * sizeof(BinaryString),
+        BinaryString{data_offset, static_cast<uint32_t>(str.size())});
+    std::memcpy(buffer.data() + header.string_data_offset + data_offset,
+                str.c_str(), str.size() + 1);
+    data_offset += static_cast<uint32_t>(str.size() + 1);
+  }
+  if (!nodes.empty()) {
+    std::memcpy(buffer.data() + header.nodes_offset, nodes.data(),
+                nodes.size() * sizeof(BinaryNode));
+  }
+  if (!endpoints.empty()) {
+    std::memcpy(buffer.data() + header.endpoints_offset, endpoints.data(),
+                endpoints.size() * sizeof(BinaryEndpoint));
+  }
+  uint32_t first_ref = 0;
+  for (size_t i = 0; i < names.size(); ++i) {
+    const auto &refs = by_name[names[i]];
+    put(buffer, header.topic_index_offset + i * sizeof(BinaryTopicIndex),
+        BinaryTopicIndex{names[i], first_ref,
+                         static_cast<uint32_t>(refs.size()), 0});
+    std::memcpy(buffer.data() + header.topic_refs_offset +
+                    first_ref * sizeof(uint32_t),
+                refs.data(), refs.size() * sizeof(uint32_t));
+    first_ref += static_cast<uint32_t>(refs.size());
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  return static_cast<bool>(file);
+}
+
+// BinaryReader implementation
+BinaryReader::BinaryReader()
+    : base_(nullptr), size_(0), header_(nullptr) {}
+
+BinaryReader::~BinaryReader() { close(); }
+
+bool BinaryReader::open(const std::string &path) {
+  close();
+  error_.clear();
+
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return fail("cannot open file");
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(BinaryHeader)) {
+    ::close(fd);
+    return fail("file too small for a header");
+  }
+  void *mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return fail("mmap failed");
+  }
+  base_ = static_cast<const char *>(mapping);
+  size_ = static_cast<size_t>(st.st_size);
+  header_ = at<BinaryHeader>(0);
+
+  const BinaryHeader &h = *header_;
+  if (std::memcmp(h.magic, kBinaryMagic, sizeof(h.magic)) != 0) {
+    return fail("not an introspection file");
+  }
+  if (h.version_major != kBinaryVersionMajor) {
+    return fail("unsupported major version");
+  }
+  if (h.header_size < sizeof(BinaryHeader) ||
+      h.node_record_size < sizeof(BinaryNode) ||
+      h.endpoint_record_size < sizeof(BinaryEndpoint)) {
+    return fail("record sizes smaller than this reader's");
+  }
+  if (!section_fits(h.strings_offset, h.string_count, sizeof(BinaryString)) ||
+      !section_fits(h.string_data_offset, h.string_data_size, 1) ||
+      !section_fits(h.nodes_offset, h.node_count, h.node_record_size) ||
+      !section_fits(h.endpoints_offset, h.endpoint_count,
+                    h.endpoint_record_size) ||
+      !section_fits(h.topic_index_offset, h.topic_index_count,
+                    sizeof(BinaryTopicIndex)) ||
+      !section_fits(h.topic_refs_offset, h.topic_ref_count,
+                    sizeof(uint32_t))) {
+    return fail("section outside the file or misaligned");
+  }
+  return true;
+}
+
+void BinaryReader::close() {
+  if (base_) {
+    ::munmap(const_cast<char *>(base_), size_);
+  }
+  base_ = nullptr;
+  size_ = 0;
+  header_ = nullptr;
+}
+
+std::string_view BinaryReader::string(uint32_t id) const {
+  if (id >= header_->string_count) {
+    return std::string_view();
+  }
+  const BinaryString &str =
+      at<BinaryString>(header_->strings_offset)[id];
+  if (static_cast<uint64_t>(str.offset) + str.length >=
+      header_->string_data_size) {
+    return std::string_view();
+  }
+  return std::string_view(base_ + header_->string_data_offset + str.offset,
+                          str.length);
+}
+
+std::string_view BinaryReader::node(size_t index) const {
+  return string(
+      at<BinaryNode>(header_->nodes_offset +
+                     index * header_->node_record_size)
+          ->name);
+}
+
+const BinaryEndpoint &BinaryReader::endpoint(size_t index) const {
+  return *at<BinaryEndpoint>(header_->endpoints_offset +
+                             index * header_->endpoint_record_size);
+}
+
+std::vector<const BinaryEndpoint *>
+BinaryReader::endpoints_on(std::string_view name) const {
+  std::vector<const BinaryEndpoint *> result;
+  const BinaryTopicIndex *begin =
+      at<BinaryTopicIndex>(header_->topic_index_offset);
+  const BinaryTopicIndex *end = begin + header_->topic_index_count;
+  const BinaryTopicIndex *it = std::lower_bound(
+      begin, end, name, [this](const BinaryTopicIndex &entry,
+                               std::string_view key) {
+        return string(entry.name) < key;
+      });
+  if (it == end || string(it->name) != name ||
+      static_cast<uint64_t>(it->first_ref) + it->ref_count >
+          header_->topic_ref_count) {
+    return result;
+  }
+  const uint32_t *refs =
+      at<uint32_t>(header_->topic_refs_offset) + it->first_ref;
+  for (uint32_t i = 0; i < it->ref_count; ++i) {
+    if (refs[i] < header_->endpoint_count) {
+      result.push_back(&endpoint(refs[i]));
+    }
+  }
+  return result;
+}
+
+bool BinaryReader::fail(const char *message) {
+  close();
+  error_ = message;
+  return false;
+}
+
+bool BinaryReader::section_fits(uint64_t offset, uint64_t count,
+                                uint64_t size) const {
+  if (offset % 8 != 0 || offset > size_) {
+    return false;
+  }
+  return count <= (size_ - offset) / (size ? size : 1);
+}
+
+} // namespace rmw_introspect
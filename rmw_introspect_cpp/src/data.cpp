@@ -1,11 +1,78 @@
 #include "rmw_introspect/data.hpp"
+#include "rmw_introspect/binary_format.hpp"
+#include "rmw_introspect/json_writer.hpp"
+#include "rmw_introspect/serializer.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
 #include <sstream>
+#include <unordered_map>
+#include <unistd.h>
+#include <utility>
 
 namespace rmw_introspect {
 
+namespace {
+
+/// Bytes buffered per CSV table before they are written out
+constexpr size_t kCsvBufferBytes = 256 * 1024;
+
+/// Header of every export, stamped with the current UTC time
+ExportHeader export_header(char (&timestamp)[32]) {
+  auto now = std::chrono::system_clock::now();
+  auto time_t = std::chrono::system_clock::to_time_t(now);
+  std::tm utc;
+  gmtime_r(&time_t, &utc);
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+  return {"1.0", timestamp, "rmw_introspect_cpp"};
+}
+
+/// Serialize `snap` with one document sink into the file at `path`
+///
+/// The buffer is sized from the snapshot, so an export that matches the
+/// estimate is written with a single write(2).
+template <typename Sink>
+bool export_document(const std::string &path,
+                     const IntrospectionSnapshot &snap) {
+  int fd = open_export_file(path);
+  if (fd < 0) {
+    return false;
+  }
+  OutputBuffer out(fd, estimate_export_bytes(snap));
+  Sink sink(out);
+  char timestamp[32];
+  serialize(snap, export_header(timestamp), {&sink});
+  const bool ok = out.flush();
+  return ::close(fd) == 0 && ok;
+}
+
+/// Streams a name as a quoted JSON string, escaped by append_json_string()
+struct JsonString {
+  std::string_view str;
+};
+
+std::ostream &operator<<(std::ostream &os, JsonString name) {
+  std::string quoted;
+  append_json_string(quoted, name.str);
+  return os << quoted;
+}
+
+/// Write a QoS profile as a single-line JSON object
+void write_qos_inline(std::ostream &os, const QoSProfile &qos) {
+  os << "{\"reliability\":\"" << to_string(qos.reliability)
+     << "\",\"durability\":\"" << to_string(qos.durability)
+     << "\",\"history\":\"" << to_string(qos.history)
+     << "\",\"depth\":" << qos.depth << "}";
+}
+
+} // namespace
+
 // QoSProfile implementation
 QoSProfile QoSProfile::from_rmw(const rmw_qos_profile_t &qos) {
   QoSProfile profile;
@@ -13,39 +80,39 @@ QoSProfile QoSProfile::from_rmw(const rmw_qos_profile_t &qos) {
   // Reliability
   switch (qos.reliability) {
   case RMW_QOS_POLICY_RELIABILITY_RELIABLE:
-    profile.reliability = "reliable";
+    profile.reliability = QoSReliability::Reliable;
     break;
   case RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT:
-    profile.reliability = "best_effort";
+    profile.reliability = QoSReliability::BestEffort;
     break;
   default:
-    profile.reliability = "unknown";
+    profile.reliability = QoSReliability::Unknown;
     break;
   }
 
   // Durability
   switch (qos.durability) {
   case RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL:
-    profile.durability = "transient_local";
+    profile.durability = QoSDurability::TransientLocal;
     break;
   case RMW_QOS_POLICY_DURABILITY_VOLATILE:
-    profile.durability = "volatile";
+    profile.durability = QoSDurability::Volatile;
     break;
   default:
-    profile.durability = "unknown";
+    profile.durability = QoSDurability::Unknown;
     break;
   }
 
   // History
   switch (qos.history) {
   case RMW_QOS_POLICY_HISTORY_KEEP_LAST:
-    profile.history = "keep_last";
+    profile.history = QoSHistory::KeepLast;
     break;
   case RMW_QOS_POLICY_HISTORY_KEEP_ALL:
-    profile.history = "keep_all";
+    profile.history = QoSHistory::KeepAll;
     break;
   default:
-    profile.history = "unknown";
+    profile.history = QoSHistory::Unknown;
     break;
   }
 
@@ -54,135 +121,463 @@ QoSProfile QoSProfile::from_rmw(const rmw_qos_profile_t &qos) {
   return profile;
 }
 
+const char *to_string(EntityKind kind) {
+  switch (kind) {
+  case EntityKind::Node:
+    return "node";
+  case EntityKind::Publisher:
+    return "publisher";
+  case EntityKind::Subscription:
+    return "subscription";
+  case EntityKind::Service:
+    return "service";
+  case EntityKind::Client:
+    return "client";
+  default:
+    return "unknown";
+  }
+}
+
+const char *to_string(QoSReliability reliability) {
+  switch (reliability) {
+  case QoSReliability::Reliable:
+    return "reliable";
+  case QoSReliability::BestEffort:
+    return "best_effort";
+  default:
+    return "unknown";
+  }
+}
+
+const char *to_string(QoSDurability durability) {
+  switch (durability) {
+  case QoSDurability::TransientLocal:
+    return "transient_local";
+  case QoSDurability::Volatile:
+    return "volatile";
+  default:
+    return "unknown";
+  }
+}
+
+const char *to_string(QoSHistory history) {
+  switch (history) {
+  case QoSHistory::KeepLast:
+    return "keep_last";
+  case QoSHistory::KeepAll:
+    return "keep_all";
+  default:
+    return "unknown";
+  }
+}
+
 // IntrospectionData implementation
 IntrospectionData &IntrospectionData::instance() {
   static IntrospectionData instance;
   return instance;
 }
 
-void IntrospectionData::record_node(const std::string &name,
-                                    const std::string &ns) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  nodes_.push_back(ns + "/" + name);
+RecordId IntrospectionData::record_created(EntityKind kind, RecordId id,
+                                           InternedString node_name,
+                                           InternedString node_namespace,
+                                           InternedString name) {
+  if (id != 0) {
+    const int64_t now_ns = steady_time_ns();
+    lifecycle_.append(
+        {kind, false, id, now_ns, node_name, node_namespace, name});
+    record_change(now_ns);
+  }
+  return id;
 }
 
-void IntrospectionData::record_publisher(const PublisherInfo &info) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  publishers_.push_back(info);
+void IntrospectionData::record_change(int64_t now_ns) {
+  last_change_ns_.store(now_ns, std::memory_order_relaxed);
+  const uint64_t count =
+      change_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+  constexpr uint64_t disarmed = std::numeric_limits<uint64_t>::max();
+  if (count < notify_at_.load(std::memory_order_relaxed) ||
+      notify_at_.exchange(disarmed, std::memory_order_acquire) == disarmed) {
+    return;
+  }
+  if (auto listener = change_listener_.load(std::memory_order_acquire)) {
+    listener();
+  }
 }
 
-void IntrospectionData::record_subscription(const SubscriptionInfo &info) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  subscriptions_.push_back(info);
+void IntrospectionData::notify_at_change(uint64_t count, void (*listener)()) {
+  change_listener_.store(listener, std::memory_order_release);
+  notify_at_.store(listener ? count : std::numeric_limits<uint64_t>::max(),
+                   std::memory_order_release);
 }
 
-void IntrospectionData::record_service(const ServiceInfo &info) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  services_.push_back(info);
+RecordId IntrospectionData::record_node(const std::string &name,
+                                        const std::string &ns) {
+  return record_created(EntityKind::Node,
+                        nodes_.append(InternedString(ns + "/" + name)), name,
+                        ns, InternedString());
+}
+
+RecordId IntrospectionData::record_publisher(const PublisherInfo &info) {
+  return record_created(EntityKind::Publisher, publishers_.append(info),
+                        info.node_name, info.node_namespace, info.topic_name);
+}
+
+RecordId IntrospectionData::record_subscription(const SubscriptionInfo &info) {
+  return record_created(EntityKind::Subscription, subscriptions_.append(info),
+                        info.node_name, info.node_namespace, info.topic_name);
+}
+
+RecordId IntrospectionData::record_service(const ServiceInfo &info) {
+  return record_created(EntityKind::Service, services_.append(info),
+                        info.node_name, info.node_namespace,
+                        info.service_name);
+}
+
+RecordId IntrospectionData::record_client(const ClientInfo &info) {
+  return record_created(EntityKind::Client, clients_.append(info),
+                        info.node_name, info.node_namespace,
+                        info.service_name);
+}
+
+void IntrospectionData::record_destroy(EntityKind kind, RecordId id) {
+  if (id == 0) {
+    return;
+  }
+  const int64_t now_ns = steady_time_ns();
+  lifecycle_.append({kind, true, id, now_ns, InternedString(),
+                     InternedString(), InternedString()});
+  record_change(now_ns);
 }
 
-void IntrospectionData::record_client(const ClientInfo &info) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  clients_.push_back(info);
+IntrospectionSnapshot IntrospectionData::snapshot() const {
+  IntrospectionSnapshot snapshot;
+  snapshot.nodes = nodes_.snapshot();
+  snapshot.publishers = publishers_.snapshot();
+  snapshot.subscriptions = subscriptions_.snapshot();
+  snapshot.services = services_.snapshot();
+  snapshot.clients = clients_.snapshot();
+  return snapshot;
 }
 
 void IntrospectionData::clear() {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<std::mutex> lock(export_mutex_);
   nodes_.clear();
   publishers_.clear();
   subscriptions_.clear();
   services_.clear();
   clients_.clear();
+  lifecycle_.clear();
+  last_change_ns_.store(0, std::memory_order_relaxed);
+  change_count_.store(0, std::memory_order_relaxed);
+  ++generation_;
 }
 
-void IntrospectionData::export_to_json(const std::string &path) {
-  std::lock_guard<std::mutex> lock(mutex_);
+bool IntrospectionData::export_to_json(const std::string &path) {
+  std::lock_guard<std::mutex> lock(export_mutex_);
+  return export_document<JsonSink>(path, snapshot());
+}
+
+void IntrospectionData::export_timeline_to_json(const std::string &path) {
+  std::lock_guard<std::mutex> lock(export_mutex_);
   std::ofstream file(path);
 
   if (!file.is_open()) {
     return;
   }
 
-  // Get current timestamp
-  auto now = std::chrono::system_clock::now();
-  auto time_t = std::chrono::system_clock::to_time_t(now);
-  std::stringstream timestamp;
-  timestamp << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
+  // Replay the lifecycle in sequence order, pairing each destruction with
+  // its creation and tracking how many entities are alive at once
+  const auto events = lifecycle_.snapshot();
+  const int64_t end_ns = steady_time_ns();
+  const int64_t start_ns = events.empty() ? end_ns : events.front().time_ns;
 
-  file << "{\n";
-  file << "  \"format_version\": \"1.0\",\n";
-  file << "  \"timestamp\": \"" << timestamp.str() << "\",\n";
-  file << "  \"rmw_implementation\": \"rmw_introspect_cpp\",\n";
-
-  // Nodes
-  file << "  \"nodes\": [\n";
-  for (size_t i = 0; i < nodes_.size(); ++i) {
-    file << "    \"" << nodes_[i] << "\"";
-    if (i < nodes_.size() - 1) {
-      file << ",";
+  struct Lifetime {
+    const LifecycleEvent *created;
+    int64_t destroyed_ns; // -1 while alive
+  };
+  std::vector<Lifetime> lifetimes;
+  std::unordered_map<RecordId, size_t> lifetime_index;
+
+  size_t live[kEntityKindCount] = {};
+  size_t peak[kEntityKindCount] = {};
+  size_t live_total = 0;
+  size_t peak_total = 0;
+  int64_t peak_total_ns = start_ns;
+
+  // Endpoint churn per node, keyed by "namespace/name" like "nodes" in the
+  // main export
+  struct NodeChurn {
+    uint64_t created = 0;
+    uint64_t destroyed = 0;
+    uint64_t recreated = 0; // Created again after one like it was destroyed
+    size_t live = 0;
+    size_t peak_live = 0;
+    int64_t first_ns = 0;
+    std::set<std::pair<EntityKind, StringId>> destroyed_names;
+  };
+  std::map<std::string, NodeChurn> churn;
+
+  auto node_key = [](const LifecycleEvent &event) {
+    return event.node_namespace.str() + "/" + event.node_name.str();
+  };
+
+  for (const auto &event : events) {
+    const size_t kind = static_cast<size_t>(event.kind);
+    if (!event.destroyed) {
+      lifetime_index[event.record_id] = lifetimes.size();
+      lifetimes.push_back({&event, -1});
+      peak[kind] = std::max(peak[kind], ++live[kind]);
+      if (++live_total > peak_total) {
+        peak_total = live_total;
+        peak_total_ns = event.time_ns;
+      }
+
+      if (event.kind != EntityKind::Node) {
+        NodeChurn &node = churn[node_key(event)];
+        if (node.created++ == 0) {
+          node.first_ns = event.time_ns;
+        }
+        if (node.destroyed_names.count({event.kind, event.name.id()})) {
+          ++node.recreated;
+        }
+        node.peak_live = std::max(node.peak_live, ++node.live);
+      }
+      continue;
+    }
+
+    auto it = lifetime_index.find(event.record_id);
+    if (it == lifetime_index.end()) {
+      continue; // Created before the last clear()
+    }
+    Lifetime &lifetime = lifetimes[it->second];
+    lifetime_index.erase(it);
+    lifetime.destroyed_ns = event.time_ns;
+    --live[kind];
+    --live_total;
+
+    const LifecycleEvent &created = *lifetime.created;
+    if (created.kind != EntityKind::Node) {
+      NodeChurn &node = churn[node_key(created)];
+      ++node.destroyed;
+      --node.live;
+      node.destroyed_names.insert({created.kind, created.name.id()});
     }
-    file << "\n";
   }
-  file << "  ],\n";
 
-  // Publishers
-  file << "  \"publishers\": [\n";
-  for (size_t i = 0; i < publishers_.size(); ++i) {
-    const auto &pub = publishers_[i];
+  static const char *const kPlural[kEntityKindCount] = {
+      "nodes", "publishers", "subscriptions", "services", "clients"};
+
+  file << "{\n";
+  file << "  \"format_version\": \"1.0\",\n";
+  file << "  \"duration_ns\": " << end_ns - start_ns << ",\n";
+
+  // Entities, times relative to the first recorded event
+  file << "  \"entities\": [\n";
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    const auto &lifetime = lifetimes[i];
+    const LifecycleEvent &created = *lifetime.created;
+    const bool alive = lifetime.destroyed_ns < 0;
+    const int64_t until_ns = alive ? end_ns : lifetime.destroyed_ns;
     file << "    {\n";
-    file << "      \"node_name\": \"" << pub.node_name << "\",\n";
-    file << "      \"node_namespace\": \"" << pub.node_namespace << "\",\n";
-    file << "      \"topic_name\": \"" << pub.topic_name << "\",\n";
-    file << "      \"message_type\": \"" << pub.message_type << "\",\n";
-    file << "      \"qos\": {\n";
-    file << "        \"reliability\": \"" << pub.qos.reliability << "\",\n";
-    file << "        \"durability\": \"" << pub.qos.durability << "\",\n";
-    file << "        \"history\": \"" << pub.qos.history << "\",\n";
-    file << "        \"depth\": " << pub.qos.depth << "\n";
-    file << "      }\n";
+    file << "      \"kind\": \"" << to_string(created.kind) << "\",\n";
+    file << "      \"node_name\": " << JsonString{created.node_name.str()}
+         << ",\n";
+    file << "      \"node_namespace\": "
+         << JsonString{created.node_namespace.str()} << ",\n";
+    file << "      \"name\": " << JsonString{created.name.str()} << ",\n";
+    file << "      \"created_ns\": " << created.time_ns - start_ns << ",\n";
+    file << "      \"destroyed_ns\": ";
+    if (alive) {
+      file << "null";
+    } else {
+      file << lifetime.destroyed_ns - start_ns;
+    }
+    file << ",\n";
+    file << "      \"lifetime_ns\": " << until_ns - created.time_ns << "\n";
     file << "    }";
-    if (i < publishers_.size() - 1) {
+    if (i < lifetimes.size() - 1) {
       file << ",";
     }
     file << "\n";
   }
   file << "  ],\n";
 
-  // Subscriptions
-  file << "  \"subscriptions\": [\n";
-  for (size_t i = 0; i < subscriptions_.size(); ++i) {
-    const auto &sub = subscriptions_[i];
+  // Peak number of entities alive at the same time
+  file << "  \"peak_live\": {\n";
+  for (size_t kind = 0; kind < kEntityKindCount; ++kind) {
+    file << "    \"" << kPlural[kind] << "\": " << peak[kind] << ",\n";
+  }
+  file << "    \"total\": " << peak_total << ",\n";
+  file << "    \"total_at_ns\": " << peak_total_ns - start_ns << "\n";
+  file << "  },\n";
+
+  // Endpoint churn per node
+  file << "  \"node_churn\": [\n";
+  size_t written = 0;
+  for (const auto &entry : churn) {
+    const NodeChurn &node = entry.second;
+    const double seconds =
+        std::max<int64_t>(end_ns - node.first_ns, 1) / 1e9;
     file << "    {\n";
-    file << "      \"node_name\": \"" << sub.node_name << "\",\n";
-    file << "      \"node_namespace\": \"" << sub.node_namespace << "\",\n";
-    file << "      \"topic_name\": \"" << sub.topic_name << "\",\n";
-    file << "      \"message_type\": \"" << sub.message_type << "\",\n";
-    file << "      \"qos\": {\n";
-    file << "        \"reliability\": \"" << sub.qos.reliability << "\",\n";
-    file << "        \"durability\": \"" << sub.qos.durability << "\",\n";
-    file << "        \"history\": \"" << sub.qos.history << "\",\n";
-    file << "        \"depth\": " << sub.qos.depth << "\n";
-    file << "      }\n";
+    file << "      \"node\": " << JsonString{entry.first} << ",\n";
+    file << "      \"created\": " << node.created << ",\n";
+    file << "      \"destroyed\": " << node.destroyed << ",\n";
+    file << "      \"recreated\": " << node.recreated << ",\n";
+    file << "      \"peak_live\": " << node.peak_live << ",\n";
+    file << "      \"destroyed_per_second\": " << node.destroyed / seconds
+         << "\n";
     file << "    }";
-    if (i < subscriptions_.size() - 1) {
+    if (++written < churn.size()) {
       file << ",";
     }
     file << "\n";
   }
-  file << "  ],\n";
+  file << "  ]\n";
 
-  // Services
-  file << "  \"services\": [],\n";
+  file << "}\n";
+}
 
-  // Clients
-  file << "  \"clients\": []\n";
+bool IntrospectionData::append_stream_events(StreamCursor &cursor,
+                                             std::string &out,
+                                             size_t max_bytes) {
+  std::lock_guard<std::mutex> lock(export_mutex_);
+  if (cursor.generation != generation_) {
+    cursor = StreamCursor();
+    cursor.generation = generation_;
+  }
 
-  file << "}\n";
+  std::ostringstream line;
+  auto emit = [&]() {
+    line << "}\n";
+    out += line.str();
+    line.str("");
+    return out.size() < max_bytes;
+  };
+
+  auto endpoint = [&](uint64_t sequence, const char *event,
+                      InternedString node_name, InternedString node_namespace,
+                      const char *name_key, InternedString name,
+                      const char *type_key, InternedString type,
+                      const QoSProfile &qos, double timestamp) {
+    line << "{\"seq\":" << sequence << ",\"event\":\"" << event
+         << "\",\"node_name\":" << JsonString{node_name.str()}
+         << ",\"node_namespace\":" << JsonString{node_namespace.str()}
+         << ",\"" << name_key << "\":" << JsonString{name.str()} << ",\""
+         << type_key << "\":" << JsonString{type.str()} << ",\"qos\":";
+    write_qos_inline(line, qos);
+    line << ",\"timestamp\":" << std::fixed << std::setprecision(6)
+         << timestamp;
+    return emit();
+  };
+
+  return nodes_.drain(cursor.nodes,
+                      [&](uint64_t sequence, const InternedString &node) {
+                        line << "{\"seq\":" << sequence
+                             << ",\"event\":\"node\",\"name\":"
+                             << JsonString{node.str()};
+                        return emit();
+                      }) &&
+         publishers_.drain(cursor.publishers,
+                           [&](uint64_t sequence, const PublisherInfo &pub) {
+                             return endpoint(sequence, "publisher",
+                                             pub.node_name, pub.node_namespace,
+                                             "topic_name", pub.topic_name,
+                                             "message_type", pub.message_type,
+                                             pub.qos, pub.timestamp);
+                           }) &&
+         subscriptions_.drain(
+             cursor.subscriptions,
+             [&](uint64_t sequence, const SubscriptionInfo &sub) {
+               return endpoint(sequence, "subscription", sub.node_name,
+                               sub.node_namespace, "topic_name",
+                               sub.topic_name, "message_type",
+                               sub.message_type, sub.qos, sub.timestamp);
+             }) &&
+         services_.drain(cursor.services,
+                         [&](uint64_t sequence, const ServiceInfo &srv) {
+                           return endpoint(sequence, "service", srv.node_name,
+                                           srv.node_namespace, "service_name",
+                                           srv.service_name, "service_type",
+                                           srv.service_type, srv.qos,
+                                           srv.timestamp);
+                         }) &&
+         clients_.drain(cursor.clients,
+                        [&](uint64_t sequence, const ClientInfo &cli) {
+                          return endpoint(sequence, "client", cli.node_name,
+                                          cli.node_namespace, "service_name",
+                                          cli.service_name, "service_type",
+                                          cli.service_type, cli.qos,
+                                          cli.timestamp);
+                        }) &&
+         lifecycle_.drain(cursor.lifecycle,
+                          [&](uint64_t sequence, const LifecycleEvent &event) {
+                            // Creations are already in their own logs
+                            if (!event.destroyed) {
+                              return true;
+                            }
+                            line << "{\"seq\":" << sequence
+                                 << ",\"event\":\"destroy\",\"kind\":\""
+                                 << to_string(event.kind)
+                                 << "\",\"record\":" << event.record_id
+                                 << ",\"time_ns\":" << event.time_ns;
+                            return emit();
+                          });
+}
+
+bool IntrospectionData::export_to_binary(const std::string &path) {
+  std::lock_guard<std::mutex> lock(export_mutex_);
+  return write_binary(path, snapshot());
+}
+
+bool IntrospectionData::export_to_yaml(const std::string &path) {
+  std::lock_guard<std::mutex> lock(export_mutex_);
+  return export_document<YamlSink>(path, snapshot());
 }
 
-void IntrospectionData::export_to_yaml(const std::string &path) {
-  (void)path;
-  // TODO: Implement YAML export in future phases
+bool IntrospectionData::export_to_csv(const std::string &path) {
+  std::lock_guard<std::mutex> lock(export_mutex_);
+  const IntrospectionSnapshot snap = snapshot();
+
+  int fds[kEntityKindCount];
+  std::unique_ptr<OutputBuffer> buffers[kEntityKindCount];
+  OutputBuffer *outputs[kEntityKindCount];
+  bool ok = true;
+  for (size_t i = 0; i < kEntityKindCount; ++i) {
+    const auto kind = static_cast<EntityKind>(i);
+    fds[i] = open_export_file(csv_output_path(path, kind));
+    ok = ok && fds[i] >= 0;
+    buffers[i] = std::make_unique<OutputBuffer>(fds[i], kCsvBufferBytes);
+    outputs[i] = buffers[i].get();
+  }
+
+  if (ok) {
+    CsvSink sink(outputs);
+    char timestamp[32];
+    serialize(snap, export_header(timestamp), {&sink});
+  }
+  for (size_t i = 0; i < kEntityKindCount; ++i) {
+    ok = buffers[i]->flush() && ok;
+    if (fds[i] >= 0) {
+      ok = ::close(fds[i]) == 0 && ok;
+    }
+  }
+  return ok;
+}
+
+bool timeline_enabled() {
+  const char *env = std::getenv("RMW_INTROSPECT_TIMELINE");
+  return env && (*env == '1' || *env == 't' || *env == 'T');
+}
+
+std::string timeline_output_path(const std::string &output_path) {
+  const std::string suffix = ".json";
+  if (output_path.size() > suffix.size() &&
+      output_path.compare(output_path.size() - suffix.size(), suffix.size(),
+                          suffix) == 0) {
+    return output_path.substr(0, output_path.size() - suffix.size()) +
+           ".timeline.json";
+  }
+  return output_path + ".timeline.json";
 }
 
 } // namespace rmw_introspect
@@ -0,0 +1,673 @@
+#include "rmw_introspect/dispatch.hpp"
+#include "rmw_introspect/forwarding.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
+#include "rmw_introspect/loopback.hpp"
+#include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recording_wait.hpp"
+#include "rmw_introspect/wrappers.hpp"
+#include <memory>
+
+namespace rmw_introspect {
+
+namespace {
+
+using namespace internal;
+
+/// Histogram to time into; compiled out unless the mode records latency
+template <DispatchMode Mode>
+inline LatencyHistogram *timed(const std::shared_ptr<LatencyHistogram> &h) {
+  if constexpr (Mode == DispatchMode::IntermediateStats) {
+    return h.get();
+  } else {
+    (void)h;
+    return nullptr;
+  }
+}
+
+/// Data of a handle already vetted by check_dispatch_handle()
+template <typename Wrapper, typename Handle>
+inline Wrapper *wrapper_of(const Handle *handle) {
+  return static_cast<Wrapper *>(handle->data);
+}
+
+// --- Recording-only: nothing is delivered, nothing is sent ---
+
+rmw_ret_t recording_publish(const rmw_publisher_t *, const void *,
+                            rmw_publisher_allocation_t *) {
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_publish_serialized_message(
+    const rmw_publisher_t *, const rmw_serialized_message_t *,
+    rmw_publisher_allocation_t *) {
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_borrow_loaned_message(const rmw_publisher_t *,
+                                         const rosidl_message_type_support_t *,
+                                         void **) {
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t recording_return_loaned_message_from_publisher(
+    const rmw_publisher_t *, void *) {
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t recording_publish_loaned_message(const rmw_publisher_t *, void *,
+                                           rmw_publisher_allocation_t *) {
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t recording_take(const rmw_subscription_t *, void *, bool *taken,
+                         rmw_subscription_allocation_t *) {
+  *taken = false;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_take_with_info(const rmw_subscription_t *, void *,
+                                   bool *taken, rmw_message_info_t *,
+                                   rmw_subscription_allocation_t *) {
+  *taken = false;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_take_serialized_message(const rmw_subscription_t *,
+                                            rmw_serialized_message_t *,
+                                            bool *taken,
+                                            rmw_subscription_allocation_t *) {
+  *taken = false;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_take_serialized_message_with_info(
+    const rmw_subscription_t *, rmw_serialized_message_t *, bool *taken,
+    rmw_message_info_t *, rmw_subscription_allocation_t *) {
+  *taken = false;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_take_loaned_message(const rmw_subscription_t *, void **,
+                                        bool *taken,
+                                        rmw_subscription_allocation_t *) {
+  *taken = false;
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t recording_take_loaned_message_with_info(
+    const rmw_subscription_t *, void **, bool *taken, rmw_message_info_t *,
+    rmw_subscription_allocation_t *) {
+  *taken = false;
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t recording_return_loaned_message_from_subscription(
+    const rmw_subscription_t *, void *) {
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t recording_take_request(const rmw_service_t *, rmw_service_info_t *,
+                                 void *, bool *taken) {
+  *taken = false;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_send_response(const rmw_service_t *, rmw_request_id_t *,
+                                  void *) {
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_send_request(const rmw_client_t *, const void *,
+                                 int64_t *sequence_id) {
+  // Dummy sequence number
+  *sequence_id = 1;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_take_response(const rmw_client_t *, rmw_service_info_t *,
+                                  void *, bool *taken) {
+  *taken = false;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t recording_wait(rmw_subscriptions_t *subscriptions,
+                         rmw_guard_conditions_t *guard_conditions,
+                         rmw_services_t *services, rmw_clients_t *clients,
+                         rmw_events_t *events, rmw_wait_set_t *wait_set,
+                         const rmw_time_t *wait_timeout) {
+  // Block like a real RMW would, so executors sleep instead of spinning
+  return recording_only_wait(subscriptions, guard_conditions, services,
+                             clients, events, wait_set, wait_timeout);
+}
+
+rmw_ret_t recording_trigger_guard_condition(const rmw_guard_condition_t *gc) {
+  auto *data = static_cast<RecordingGuardCondition *>(gc->data);
+  if (data) {
+    data->trigger();
+  }
+  return RMW_RET_OK;
+}
+
+// --- Loopback: recording-only, with messages delivered in-process ---
+
+rmw_ret_t loopback_publish(const rmw_publisher_t *publisher,
+                           const void *ros_message,
+                           rmw_publisher_allocation_t *) {
+  auto *entity = wrapper_of<RecordingEntity>(publisher);
+  if (!entity->loopback) {
+    return RMW_RET_OK;
+  }
+  return LoopbackBus::instance().publish(*entity->loopback, ros_message);
+}
+
+rmw_ret_t loopback_take_with_info(const rmw_subscription_t *subscription,
+                                  void *ros_message, bool *taken,
+                                  rmw_message_info_t *message_info,
+                                  rmw_subscription_allocation_t *) {
+  auto *entity = wrapper_of<RecordingEntity>(subscription);
+  if (!entity->loopback) {
+    *taken = false;
+    return RMW_RET_OK;
+  }
+  return LoopbackBus::instance().take(*entity->loopback, ros_message, taken,
+                                      message_info);
+}
+
+rmw_ret_t loopback_take(const rmw_subscription_t *subscription,
+                        void *ros_message, bool *taken,
+                        rmw_subscription_allocation_t *allocation) {
+  return loopback_take_with_info(subscription, ros_message, taken, nullptr,
+                                 allocation);
+}
+
+// --- Intermediate: unwrap and forward to the real RMW ---
+
+template <DispatchMode Mode>
+rmw_ret_t forward_publish(const rmw_publisher_t *publisher,
+                          const void *ros_message,
+                          rmw_publisher_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<PublisherWrapper>(publisher);
+  rmw_ret_t ret;
+  {
+    ScopedLatency timer(timed<Mode>(wrapper->publish_latency));
+    ret = g_real_rmw->publish(wrapper->real_publisher, ros_message,
+                              unwrap_publisher_allocation(allocation));
+  }
+  wrapper->stats->record_publish(ret, 0);
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_publish_serialized_message(
+    const rmw_publisher_t *publisher,
+    const rmw_serialized_message_t *serialized_message,
+    rmw_publisher_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<PublisherWrapper>(publisher);
+  rmw_ret_t ret = g_real_rmw->publish_serialized_message(
+      wrapper->real_publisher, serialized_message,
+      unwrap_publisher_allocation(allocation));
+  wrapper->stats->record_publish(ret, serialized_message->buffer_length);
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_borrow_loaned_message(
+    const rmw_publisher_t *publisher,
+    const rosidl_message_type_support_t *type_support, void **ros_message) {
+  auto *wrapper = wrapper_of<PublisherWrapper>(publisher);
+  rmw_ret_t ret = g_real_rmw->borrow_loaned_message(
+      wrapper->real_publisher, type_support, ros_message);
+  if (ret == RMW_RET_OK) {
+    wrapper->stats->loans_borrowed.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t
+forward_return_loaned_message_from_publisher(const rmw_publisher_t *publisher,
+                                             void *loaned_message) {
+  auto *wrapper = wrapper_of<PublisherWrapper>(publisher);
+  rmw_ret_t ret = g_real_rmw->return_loaned_message_from_publisher(
+      wrapper->real_publisher, loaned_message);
+  if (ret == RMW_RET_OK) {
+    wrapper->stats->loans_returned.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t
+forward_publish_loaned_message(const rmw_publisher_t *publisher,
+                               void *ros_message,
+                               rmw_publisher_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<PublisherWrapper>(publisher);
+  rmw_ret_t ret;
+  {
+    ScopedLatency timer(timed<Mode>(wrapper->publish_latency));
+    ret = g_real_rmw->publish_loaned_message(
+        wrapper->real_publisher, ros_message,
+        unwrap_publisher_allocation(allocation));
+  }
+  wrapper->stats->record_publish(ret, 0);
+  if (ret == RMW_RET_OK) {
+    // Ownership of the loan passes to the middleware
+    wrapper->stats->loans_published.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_take(const rmw_subscription_t *subscription,
+                       void *ros_message, bool *taken,
+                       rmw_subscription_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret =
+      g_real_rmw->take(wrapper->real_subscription, ros_message, taken,
+                       unwrap_subscription_allocation(allocation));
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_take_with_info(const rmw_subscription_t *subscription,
+                                 void *ros_message, bool *taken,
+                                 rmw_message_info_t *message_info,
+                                 rmw_subscription_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret;
+  {
+    ScopedLatency timer(timed<Mode>(wrapper->take_latency));
+    ret = g_real_rmw->take_with_info(
+        wrapper->real_subscription, ros_message, taken, message_info,
+        unwrap_subscription_allocation(allocation));
+  }
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t
+forward_take_serialized_message(const rmw_subscription_t *subscription,
+                                rmw_serialized_message_t *serialized_message,
+                                bool *taken,
+                                rmw_subscription_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret = g_real_rmw->take_serialized_message(
+      wrapper->real_subscription, serialized_message, taken,
+      unwrap_subscription_allocation(allocation));
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_take_serialized_message_with_info(
+    const rmw_subscription_t *subscription,
+    rmw_serialized_message_t *serialized_message, bool *taken,
+    rmw_message_info_t *message_info,
+    rmw_subscription_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret = g_real_rmw->take_serialized_message_with_info(
+      wrapper->real_subscription, serialized_message, taken, message_info,
+      unwrap_subscription_allocation(allocation));
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t
+forward_take_loaned_message(const rmw_subscription_t *subscription,
+                            void **loaned_message, bool *taken,
+                            rmw_subscription_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret = g_real_rmw->take_loaned_message(
+      wrapper->real_subscription, loaned_message, taken,
+      unwrap_subscription_allocation(allocation));
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->loans_taken.fetch_add(1, std::memory_order_relaxed);
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_take_loaned_message_with_info(
+    const rmw_subscription_t *subscription, void **loaned_message, bool *taken,
+    rmw_message_info_t *message_info,
+    rmw_subscription_allocation_t *allocation) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret;
+  {
+    ScopedLatency timer(timed<Mode>(wrapper->take_latency));
+    ret = g_real_rmw->take_loaned_message_with_info(
+        wrapper->real_subscription, loaned_message, taken, message_info,
+        unwrap_subscription_allocation(allocation));
+  }
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->loans_taken.fetch_add(1, std::memory_order_relaxed);
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_return_loaned_message_from_subscription(
+    const rmw_subscription_t *subscription, void *loaned_message) {
+  auto *wrapper = wrapper_of<SubscriptionWrapper>(subscription);
+  rmw_ret_t ret = g_real_rmw->return_loaned_message_from_subscription(
+      wrapper->real_subscription, loaned_message);
+  if (ret == RMW_RET_OK) {
+    wrapper->stats->loans_returned.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_take_request(const rmw_service_t *service,
+                               rmw_service_info_t *request_header,
+                               void *ros_request, bool *taken) {
+  auto *wrapper = wrapper_of<ServiceWrapper>(service);
+  rmw_ret_t ret = g_real_rmw->take_request(wrapper->real_service,
+                                           request_header, ros_request, taken);
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_send_response(const rmw_service_t *service,
+                                rmw_request_id_t *request_header,
+                                void *ros_response) {
+  auto *wrapper = wrapper_of<ServiceWrapper>(service);
+  ScopedLatency timer(timed<Mode>(wrapper->send_response_latency));
+  return g_real_rmw->send_response(wrapper->real_service, request_header,
+                                   ros_response);
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_send_request(const rmw_client_t *client,
+                               const void *ros_request, int64_t *sequence_id) {
+  auto *wrapper = wrapper_of<ClientWrapper>(client);
+  ScopedLatency timer(timed<Mode>(wrapper->send_request_latency));
+  return g_real_rmw->send_request(wrapper->real_client, ros_request,
+                                  sequence_id);
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_take_response(const rmw_client_t *client,
+                                rmw_service_info_t *request_header,
+                                void *ros_response, bool *taken) {
+  auto *wrapper = wrapper_of<ClientWrapper>(client);
+  rmw_ret_t ret = g_real_rmw->take_response(
+      wrapper->real_client, request_header, ros_response, taken);
+  if (ret == RMW_RET_OK && *taken) {
+    wrapper->stats->callbacks.record_take();
+  }
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t forward_wait(rmw_subscriptions_t *subscriptions,
+                       rmw_guard_conditions_t *guard_conditions,
+                       rmw_services_t *services, rmw_clients_t *clients,
+                       rmw_events_t *events, rmw_wait_set_t *wait_set,
+                       const rmw_time_t *wait_timeout) {
+  auto *ws_wrapper = wrapper_of<WaitSetWrapper>(wait_set);
+  rmw_wait_set_t *real_wait_set = ws_wrapper->real_wait_set;
+  if (!real_wait_set) {
+    RMW_SET_ERROR_MSG("failed to unwrap wait set");
+    return RMW_RET_ERROR;
+  }
+
+  // Unwrap subscriptions array
+  rmw_subscriptions_t real_subscriptions;
+  if (subscriptions && subscriptions->subscriber_count > 0) {
+    void **storage = ws_wrapper->acquire_scratch(
+        ws_wrapper->subscriptions_scratch, subscriptions->subscriber_count);
+    for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
+      storage[i] = unwrap_subscription(
+          static_cast<rmw_subscription_t *>(subscriptions->subscribers[i]));
+    }
+    real_subscriptions.subscriber_count = subscriptions->subscriber_count;
+    real_subscriptions.subscribers = storage;
+  } else {
+    real_subscriptions.subscriber_count = 0;
+    real_subscriptions.subscribers = nullptr;
+  }
+
+  // Unwrap guard conditions array
+  rmw_guard_conditions_t real_guard_conditions;
+  if (guard_conditions && guard_conditions->guard_condition_count > 0) {
+    void **storage = ws_wrapper->acquire_scratch(
+        ws_wrapper->guard_conditions_scratch,
+        guard_conditions->guard_condition_count);
+    for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
+      storage[i] =
+          unwrap_guard_condition(static_cast<rmw_guard_condition_t *>(
+              guard_conditions->guard_conditions[i]));
+    }
+    real_guard_conditions.guard_condition_count =
+        guard_conditions->guard_condition_count;
+    real_guard_conditions.guard_conditions = storage;
+  } else {
+    real_guard_conditions.guard_condition_count = 0;
+    real_guard_conditions.guard_conditions = nullptr;
+  }
+
+  // Unwrap services array
+  rmw_services_t real_services;
+  if (services && services->service_count > 0) {
+    void **storage = ws_wrapper->acquire_scratch(ws_wrapper->services_scratch,
+                                                 services->service_count);
+    for (size_t i = 0; i < services->service_count; ++i) {
+      storage[i] =
+          unwrap_service(static_cast<rmw_service_t *>(services->services[i]));
+    }
+    real_services.service_count = services->service_count;
+    real_services.services = storage;
+  } else {
+    real_services.service_count = 0;
+    real_services.services = nullptr;
+  }
+
+  // Unwrap clients array
+  rmw_clients_t real_clients;
+  if (clients && clients->client_count > 0) {
+    void **storage = ws_wrapper->acquire_scratch(ws_wrapper->clients_scratch,
+                                                 clients->client_count);
+    for (size_t i = 0; i < clients->client_count; ++i) {
+      storage[i] =
+          unwrap_client(static_cast<rmw_client_t *>(clients->clients[i]));
+    }
+    real_clients.client_count = clients->client_count;
+    real_clients.clients = storage;
+  } else {
+    real_clients.client_count = 0;
+    real_clients.clients = nullptr;
+  }
+
+  // Unwrap events array
+  rmw_events_t real_events;
+  if (events && events->event_count > 0) {
+    void **storage = ws_wrapper->acquire_scratch(ws_wrapper->events_scratch,
+                                                 events->event_count);
+    for (size_t i = 0; i < events->event_count; ++i) {
+      storage[i] = unwrap_event(static_cast<rmw_event_t *>(events->events[i]));
+    }
+    real_events.event_count = events->event_count;
+    real_events.events = storage;
+  } else {
+    real_events.event_count = 0;
+    real_events.events = nullptr;
+  }
+
+  // Call real RMW wait
+  rmw_ret_t ret;
+  {
+    ScopedLatency timer(timed<Mode>(ws_wrapper->wait_latency));
+    ret = g_real_rmw->wait(
+        subscriptions ? &real_subscriptions : nullptr,
+        guard_conditions ? &real_guard_conditions : nullptr,
+        services ? &real_services : nullptr,
+        clients ? &real_clients : nullptr, events ? &real_events : nullptr,
+        real_wait_set, wait_timeout);
+  }
+
+  // Update ready flags in original arrays based on real arrays
+  if (ret == RMW_RET_OK) {
+    if (subscriptions && subscriptions->subscriber_count > 0) {
+      for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
+        subscriptions->subscribers[i] = real_subscriptions.subscribers[i]
+                                            ? subscriptions->subscribers[i]
+                                            : nullptr;
+      }
+    }
+    if (guard_conditions && guard_conditions->guard_condition_count > 0) {
+      for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
+        guard_conditions->guard_conditions[i] =
+            real_guard_conditions.guard_conditions[i]
+                ? guard_conditions->guard_conditions[i]
+                : nullptr;
+      }
+    }
+    if (services && services->service_count > 0) {
+      for (size_t i = 0; i < services->service_count; ++i) {
+        services->services[i] =
+            real_services.services[i] ? services->services[i] : nullptr;
+      }
+    }
+    if (clients && clients->client_count > 0) {
+      for (size_t i = 0; i < clients->client_count; ++i) {
+        clients->clients[i] =
+            real_clients.clients[i] ? clients->clients[i] : nullptr;
+      }
+    }
+    if (events && events->event_count > 0) {
+      for (size_t i = 0; i < events->event_count; ++i) {
+        events->events[i] =
+            real_events.events[i] ? events->events[i] : nullptr;
+      }
+    }
+  }
+
+  return ret;
+}
+
+template <DispatchMode Mode>
+rmw_ret_t
+forward_trigger_guard_condition(const rmw_guard_condition_t *guard_condition) {
+  auto *wrapper = wrapper_of<GuardConditionWrapper>(guard_condition);
+  return g_real_rmw->trigger_guard_condition(wrapper->real_guard_condition);
+}
+
+template <DispatchMode Mode> constexpr DispatchTable make_forwarding_table() {
+  return DispatchTable{
+      Mode,
+      &forward_publish<Mode>,
+      &forward_publish_serialized_message<Mode>,
+      &forward_borrow_loaned_message<Mode>,
+      &forward_return_loaned_message_from_publisher<Mode>,
+      &forward_publish_loaned_message<Mode>,
+      &forward_take<Mode>,
+      &forward_take_with_info<Mode>,
+      &forward_take_serialized_message<Mode>,
+      &forward_take_serialized_message_with_info<Mode>,
+      &forward_take_loaned_message<Mode>,
+      &forward_take_loaned_message_with_info<Mode>,
+      &forward_return_loaned_message_from_subscription<Mode>,
+      &forward_take_request<Mode>,
+      &forward_send_response<Mode>,
+      &forward_send_request<Mode>,
+      &forward_take_response<Mode>,
+      &forward_wait<Mode>,
+      &forward_trigger_guard_condition<Mode>,
+  };
+}
+
+constexpr DispatchTable kRecordingOnlyTable{
+    DispatchMode::RecordingOnly,
+    &recording_publish,
+    &recording_publish_serialized_message,
+    &recording_borrow_loaned_message,
+    &recording_return_loaned_message_from_publisher,
+    &recording_publish_loaned_message,
+    &recording_take,
+    &recording_take_with_info,
+    &recording_take_serialized_message,
+    &recording_take_serialized_message_with_info,
+    &recording_take_loaned_message,
+    &recording_take_loaned_message_with_info,
+    &recording_return_loaned_message_from_subscription,
+    &recording_take_request,
+    &recording_send_response,
+    &recording_send_request,
+    &recording_take_response,
+    &recording_wait,
+    &recording_trigger_guard_condition,
+};
+
+// Serialized messages, loans, services and clients stay recording-only
+constexpr DispatchTable kLoopbackTable{
+    DispatchMode::Loopback,
+    &loopback_publish,
+    &recording_publish_serialized_message,
+    &recording_borrow_loaned_message,
+    &recording_return_loaned_message_from_publisher,
+    &recording_publish_loaned_message,
+    &loopback_take,
+    &loopback_take_with_info,
+    &recording_take_serialized_message,
+    &recording_take_serialized_message_with_info,
+    &recording_take_loaned_message,
+    &recording_take_loaned_message_with_info,
+    &recording_return_loaned_message_from_subscription,
+    &recording_take_request,
+    &recording_send_response,
+    &recording_send_request,
+    &recording_take_response,
+    &recording_wait,
+    &recording_trigger_guard_condition,
+};
+
+constexpr DispatchTable kIntermediateTable =
+    make_forwarding_table<DispatchMode::Intermediate>();
+
+constexpr DispatchTable kIntermediateStatsTable =
+    make_forwarding_table<DispatchMode::IntermediateStats>();
+
+} // namespace
+
+const DispatchTable &dispatch_table(DispatchMode mode) {
+  switch (mode) {
+  case DispatchMode::Intermediate:
+    return kIntermediateTable;
+  case DispatchMode::IntermediateStats:
+    return kIntermediateStatsTable;
+  case DispatchMode::Loopback:
+    return kLoopbackTable;
+  case DispatchMode::RecordingOnly:
+  default:
+    return kRecordingOnlyTable;
+  }
+}
+
+namespace internal {
+
+std::atomic<const DispatchTable *> g_dispatch{&kRecordingOnlyTable};
+
+void select_dispatch(DispatchMode mode) {
+  g_dispatch.store(&dispatch_table(mode), std::memory_order_release);
+}
+
+} // namespace internal
+} // namespace rmw_introspect
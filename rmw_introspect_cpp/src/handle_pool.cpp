@@ -0,0 +1,27 @@
+#include "rmw_introspect/handle_pool.hpp"
+
+namespace rmw_introspect {
+namespace internal {
+
+HandlePool<rmw_publisher_t, PublisherWrapper> &publisher_pool() {
+  static auto *pool = new HandlePool<rmw_publisher_t, PublisherWrapper>;
+  return *pool;
+}
+
+HandlePool<rmw_subscription_t, SubscriptionWrapper> &subscription_pool() {
+  static auto *pool = new HandlePool<rmw_subscription_t, SubscriptionWrapper>;
+  return *pool;
+}
+
+HandlePool<rmw_service_t, ServiceWrapper> &service_pool() {
+  static auto *pool = new HandlePool<rmw_service_t, ServiceWrapper>;
+  return *pool;
+}
+
+HandlePool<rmw_client_t, ClientWrapper> &client_pool() {
+  static auto *pool = new HandlePool<rmw_client_t, ClientWrapper>;
+  return *pool;
+}
+
+} // namespace internal
+} // namespace rmw_introspect
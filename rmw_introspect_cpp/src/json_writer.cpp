@@ -0,0 +1,141 @@
+#include "rmw_introspect/json_writer.hpp"
+#include <cstdio>
+
+namespace rmw_introspect {
+
+namespace {
+
+bool needs_escape(unsigned char c) {
+  return c == '"' || c == '\\' || c < 0x20;
+}
+
+void append(OutputBuffer &out, const char *data, size_t size) {
+  out.write(data, size);
+}
+
+void append(std::string &out, const char *data, size_t size) {
+  out.append(data, size);
+}
+
+template <typename Out> void append_quoted(Out &out, std::string_view str) {
+  append(out, "\"", 1);
+  size_t run_start = 0;
+  for (size_t i = 0; i < str.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(str[i]);
+    if (!needs_escape(c)) {
+      continue;
+    }
+    append(out, str.data() + run_start, i - run_start);
+    run_start = i + 1;
+    switch (c) {
+    case '"':
+      append(out, "\\\"", 2);
+      break;
+    case '\\':
+      append(out, "\\\\", 2);
+      break;
+    case '\n':
+      append(out, "\\n", 2);
+      break;
+    case '\r':
+      append(out, "\\r", 2);
+      break;
+    case '\t':
+      append(out, "\\t", 2);
+      break;
+    case '\b':
+      append(out, "\\b", 2);
+      break;
+    case '\f':
+      append(out, "\\f", 2);
+      break;
+    default: {
+      char escaped[7];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      append(out, escaped, 6);
+      break;
+    }
+    }
+  }
+  append(out, str.data() + run_start, str.size() - run_start);
+  append(out, "\"", 1);
+}
+
+} // namespace
+
+void append_json_string(OutputBuffer &out, std::string_view str) {
+  append_quoted(out, str);
+}
+
+void append_json_string(std::string &out, std::string_view str) {
+  append_quoted(out, str);
+}
+
+JsonWriter::JsonWriter(OutputBuffer &out) : out_(out), after_key_(false) {}
+
+void JsonWriter::begin_object() { begin('{'); }
+void JsonWriter::end_object() { end('}'); }
+void JsonWriter::begin_array() { begin('['); }
+void JsonWriter::end_array() { end(']'); }
+
+void JsonWriter::key(std::string_view name) {
+  next_element();
+  append_json_string(out_, name);
+  out_.write(": ", 2);
+  after_key_ = true;
+}
+
+void JsonWriter::value(std::string_view str) {
+  next_element();
+  append_json_string(out_, str);
+}
+
+void JsonWriter::value(bool b) {
+  next_element();
+  out_.write(b ? "true" : "false");
+}
+
+void JsonWriter::value(double number) {
+  next_element();
+  out_.write_double(number);
+}
+
+void JsonWriter::null() {
+  next_element();
+  out_.write("null", 4);
+}
+
+void JsonWriter::next_element() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (scopes_.empty()) {
+    return;
+  }
+  Scope &scope = scopes_.back();
+  out_.write(scope.empty ? "\n" : ",\n");
+  scope.empty = false;
+  out_.fill(scopes_.size() * 2, ' ');
+}
+
+void JsonWriter::begin(char bracket) {
+  next_element();
+  out_.put(bracket);
+  scopes_.push_back({true});
+}
+
+void JsonWriter::end(char bracket) {
+  const bool empty = scopes_.back().empty;
+  scopes_.pop_back();
+  if (!empty) {
+    out_.put('\n');
+    out_.fill(scopes_.size() * 2, ' ');
+  }
+  out_.put(bracket);
+  if (scopes_.empty()) {
+    out_.put('\n');
+  }
+}
+
+} // namespace rmw_introspect
@@ -0,0 +1,214 @@
+#include "rmw_introspect/latency_histogram.hpp"
+#include "rmw_introspect/json_writer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace rmw_introspect {
+
+namespace {
+
+/// Shard used by the calling thread, assigned round-robin on first use
+size_t thread_shard() {
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) %
+      LatencyHistogram::kShardCount;
+  return shard;
+}
+
+unsigned highest_bit(uint64_t value) {
+  return 63u - static_cast<unsigned>(__builtin_clzll(value));
+}
+
+} // namespace
+
+size_t LatencyHistogram::bucket_index(uint64_t ns) {
+  if (ns < kSubBucketCount) {
+    return static_cast<size_t>(ns);
+  }
+  const unsigned exponent = highest_bit(ns);
+  const size_t sub =
+      (ns >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBucketCount + sub;
+}
+
+uint64_t LatencyHistogram::bucket_lower_bound(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const unsigned shift =
+      static_cast<unsigned>(index / kSubBucketCount - 1);
+  const uint64_t sub = index % kSubBucketCount;
+  return (kSubBucketCount + sub) << shift;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+  Shard &shard = shards_[thread_shard()];
+  shard.buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+  shard.count.fetch_add(1, std::memory_order_relaxed);
+  shard.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+  uint64_t current = shard.min_ns.load(std::memory_order_relaxed);
+  while (ns < current && !shard.min_ns.compare_exchange_weak(
+                             current, ns, std::memory_order_relaxed)) {
+  }
+  current = shard.max_ns.load(std::memory_order_relaxed);
+  while (ns > current && !shard.max_ns.compare_exchange_weak(
+                             current, ns, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+  Snapshot snap;
+  uint64_t min_ns = UINT64_MAX;
+  for (const auto &shard : shards_) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      snap.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+    snap.count += shard.count.load(std::memory_order_relaxed);
+    snap.sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+    min_ns = std::min(min_ns, shard.min_ns.load(std::memory_order_relaxed));
+    snap.max_ns =
+        std::max(snap.max_ns, shard.max_ns.load(std::memory_order_relaxed));
+  }
+  snap.min_ns = snap.count > 0 ? min_ns : 0;
+  return snap;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  q = std::min(std::max(q, 0.0), 1.0);
+  uint64_t rank =
+      static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+  rank = std::max<uint64_t>(rank, 1);
+  if (rank >= count) {
+    return max_ns;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      // Report the middle of the bucket, clamped to what was observed
+      const uint64_t lower = bucket_lower_bound(i);
+      const uint64_t upper =
+          i + 1 < kBucketCount ? bucket_lower_bound(i + 1) - 1 : UINT64_MAX;
+      const uint64_t mid = lower + (upper - lower) / 2;
+      return std::min(std::max(mid, min_ns), max_ns);
+    }
+  }
+  return max_ns;
+}
+
+LatencyRegistry &LatencyRegistry::instance() {
+  static LatencyRegistry registry;
+  return registry;
+}
+
+LatencyRegistry::LatencyRegistry() {
+  const char *env = std::getenv("RMW_INTROSPECT_LATENCY");
+  enabled_ = env && (*env == '1' || *env == 't' || *env == 'T');
+}
+
+std::shared_ptr<LatencyHistogram>
+LatencyRegistry::create(const std::string &operation,
+                        const std::string &entity) {
+  if (!enabled_) {
+    return nullptr;
+  }
+  auto histogram = std::make_shared<LatencyHistogram>();
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back({operation, entity, histogram});
+  return histogram;
+}
+
+void LatencyRegistry::export_to_json(const std::string &path) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    return;
+  }
+
+  file << "{\n";
+  file << "  \"format_version\": \"1.0\",\n";
+  file << "  \"unit\": \"ns\",\n";
+  file << "  \"histograms\": [\n";
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const auto &entry = entries_[i];
+    const auto snap = entry.histogram->snapshot();
+    const uint64_t mean = snap.count > 0 ? snap.sum_ns / snap.count : 0;
+
+    // Entity labels are built from node and topic names, so escape them
+    std::string operation;
+    std::string entity;
+    append_json_string(operation, entry.operation);
+    append_json_string(entity, entry.entity);
+
+    file << "    {\n";
+    file << "      \"operation\": " << operation << ",\n";
+    file << "      \"entity\": " << entity << ",\n";
+    file << "      \"count\": " << snap.count << ",\n";
+    file << "      \"min\": " << snap.min_ns << ",\n";
+    file << "      \"mean\": " << mean << ",\n";
+    file << "      \"p50\": " << snap.percentile(0.5) << ",\n";
+    file << "      \"p90\": " << snap.percentile(0.9) << ",\n";
+    file << "      \"p99\": " << snap.percentile(0.99) << ",\n";
+    file << "      \"p999\": " << snap.percentile(0.999) << ",\n";
+    file << "      \"max\": " << snap.max_ns << ",\n";
+
+    // Non-empty buckets as [lower_bound_ns, count] pairs, so histograms from
+    // several runs can be merged offline
+    file << "      \"buckets\": [";
+    bool first = true;
+    for (size_t b = 0; b < LatencyHistogram::kBucketCount; ++b) {
+      if (snap.buckets[b] == 0) {
+        continue;
+      }
+      file << (first ? "" : ", ") << "["
+           << LatencyHistogram::bucket_lower_bound(b) << ", "
+           << snap.buckets[b] << "]";
+      first = false;
+    }
+    file << "]\n";
+    file << "    }";
+    if (i < entries_.size() - 1) {
+      file << ",";
+    }
+    file << "\n";
+  }
+  file << "  ]\n";
+  file << "}\n";
+}
+
+void LatencyRegistry::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+std::string latency_entity_label(const std::string &node_namespace,
+                                 const std::string &node_name,
+                                 const std::string &endpoint) {
+  std::string label = node_namespace;
+  if (label.empty() || label.back() != '/') {
+    label += '/';
+  }
+  return label + node_name + " " + endpoint;
+}
+
+std::string latency_output_path(const std::string &output_path) {
+  const std::string suffix = ".json";
+  if (output_path.size() > suffix.size() &&
+      output_path.compare(output_path.size() - suffix.size(), suffix.size(),
+                          suffix) == 0) {
+    return output_path.substr(0, output_path.size() - suffix.size()) +
+           ".latency.json";
+  }
+  return output_path + ".latency.json";
+}
+
+} // namespace rmw_introspect
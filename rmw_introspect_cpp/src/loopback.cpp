@@ -0,0 +1,375 @@
+#include "rmw_introspect/loopback.hpp"
+#include "rmw_introspect/recording_wait.hpp"
+#include "rosidl_typesupport_cpp/message_type_support_dispatch.hpp"
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace rmw_introspect {
+
+namespace {
+
+namespace ts = rosidl_typesupport_introspection_cpp;
+
+/// Depth of KEEP_ALL endpoints, and the most any ring holds
+constexpr size_t kMaxDepth = 1024;
+
+size_t qos_depth(const rmw_qos_profile_t &qos) {
+  if (qos.history == RMW_QOS_POLICY_HISTORY_KEEP_ALL) {
+    return kMaxDepth;
+  }
+  return std::clamp<size_t>(qos.depth, 1, kMaxDepth);
+}
+
+size_t primitive_size(uint8_t type_id) {
+  switch (type_id) {
+  case ts::ROS_TYPE_FLOAT:
+    return sizeof(float);
+  case ts::ROS_TYPE_DOUBLE:
+    return sizeof(double);
+  case ts::ROS_TYPE_LONG_DOUBLE:
+    return sizeof(long double);
+  case ts::ROS_TYPE_WCHAR:
+    return sizeof(char16_t);
+  case ts::ROS_TYPE_BOOLEAN:
+    return sizeof(bool);
+  case ts::ROS_TYPE_CHAR:
+  case ts::ROS_TYPE_OCTET:
+  case ts::ROS_TYPE_UINT8:
+  case ts::ROS_TYPE_INT8:
+    return 1;
+  case ts::ROS_TYPE_UINT16:
+  case ts::ROS_TYPE_INT16:
+    return 2;
+  case ts::ROS_TYPE_UINT32:
+  case ts::ROS_TYPE_INT32:
+    return 4;
+  case ts::ROS_TYPE_UINT64:
+  case ts::ROS_TYPE_INT64:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+const ts::MessageMembers *nested(const ts::MessageMember &member) {
+  return static_cast<const ts::MessageMembers *>(member.members_->data);
+}
+
+/// Size of one element of `member` in an std::array
+size_t element_size(const ts::MessageMember &member) {
+  switch (member.type_id_) {
+  case ts::ROS_TYPE_STRING:
+    return sizeof(std::string);
+  case ts::ROS_TYPE_WSTRING:
+    return sizeof(std::u16string);
+  case ts::ROS_TYPE_MESSAGE:
+    return nested(member)->size_of_;
+  default:
+    return primitive_size(member.type_id_);
+  }
+}
+
+void copy_members(const ts::MessageMembers *members, const void *from,
+                  void *to);
+
+void copy_element(const ts::MessageMember &member, const void *from,
+                  void *to) {
+  switch (member.type_id_) {
+  case ts::ROS_TYPE_STRING:
+    *static_cast<std::string *>(to) = *static_cast<const std::string *>(from);
+    break;
+  case ts::ROS_TYPE_WSTRING:
+    *static_cast<std::u16string *>(to) =
+        *static_cast<const std::u16string *>(from);
+    break;
+  case ts::ROS_TYPE_MESSAGE:
+    copy_members(nested(member), from, to);
+    break;
+  default:
+    std::memcpy(to, from, primitive_size(member.type_id_));
+    break;
+  }
+}
+
+/// Member-wise assignment of two C++ messages of one type
+void copy_members(const ts::MessageMembers *members, const void *from,
+                  void *to) {
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const ts::MessageMember &member = members->members_[i];
+    const auto *src = static_cast<const uint8_t *>(from) + member.offset_;
+    auto *dst = static_cast<uint8_t *>(to) + member.offset_;
+
+    if (!member.is_array_) {
+      copy_element(member, src, dst);
+    } else if (member.array_size_ > 0 && !member.is_upper_bound_) {
+      // std::array: elements are contiguous
+      const size_t stride = element_size(member);
+      for (size_t j = 0; j < member.array_size_; ++j) {
+        copy_element(member, src + j * stride, dst + j * stride);
+      }
+    } else {
+      // std::vector or BoundedVector
+      const size_t count = member.size_function(src);
+      member.resize_function(dst, count);
+      for (size_t j = 0; j < count; ++j) {
+        if (member.type_id_ == ts::ROS_TYPE_BOOLEAN) {
+          // std::vector<bool> has no element addresses
+          bool value = false;
+          member.fetch_function(src, j, &value);
+          member.assign_function(dst, j, &value);
+        } else {
+          copy_element(member, member.get_const_function(src, j),
+                       member.get_function(dst, j));
+        }
+      }
+    }
+  }
+}
+
+int64_t system_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+// --- LoopbackType ---
+
+std::shared_ptr<const LoopbackType>
+LoopbackType::create(const rosidl_message_type_support_t *type_support) {
+  const rosidl_message_type_support_t *introspection =
+      rosidl_typesupport_cpp::get_message_typesupport_handle_function(
+          type_support, ts::typesupport_identifier);
+  if (!introspection || !introspection->data) {
+    return nullptr;
+  }
+  return std::make_shared<const LoopbackType>(
+      static_cast<const ts::MessageMembers *>(introspection->data));
+}
+
+LoopbackType::LoopbackType(const ts::MessageMembers *members)
+    : members_(members) {
+  std::string ns = members->message_namespace_;
+  const size_t pos = ns.find("::");
+  if (pos != std::string::npos) {
+    ns.replace(pos, 2, "/");
+  }
+  name_ = ns + "/" + members->message_name_;
+}
+
+void *LoopbackType::clone(const void *message) const {
+  void *copy = ::operator new(members_->size_of_);
+  members_->init_function(copy, rosidl_runtime_cpp::MessageInitialization::ALL);
+  try {
+    copy_members(members_, message, copy);
+  } catch (...) {
+    destroy(copy);
+    throw;
+  }
+  return copy;
+}
+
+void LoopbackType::copy(const void *from, void *to) const {
+  copy_members(members_, from, to);
+}
+
+void LoopbackType::destroy(void *message) const {
+  members_->fini_function(message);
+  ::operator delete(message);
+}
+
+LoopbackMessage::~LoopbackMessage() {
+  if (data) {
+    type->destroy(data);
+  }
+}
+
+// --- LoopbackTopic ---
+
+void LoopbackTopic::reserve(size_t depth) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (depth <= slots_.size()) {
+    return;
+  }
+  // Retained messages have consecutive sequences, so they never collide in
+  // the larger ring
+  std::vector<std::shared_ptr<const LoopbackMessage>> slots(depth);
+  for (auto &message : slots_) {
+    if (message) {
+      slots[message->sequence % depth] = std::move(message);
+    }
+  }
+  slots_ = std::move(slots);
+}
+
+void LoopbackTopic::attach(LoopbackEndpoint &subscription,
+                           bool transient_local) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  subscription.cursor =
+      transient_local ? oldest_for(subscription) : next_sequence_;
+}
+
+void LoopbackTopic::publish(std::shared_ptr<LoopbackMessage> message) {
+  std::shared_ptr<const LoopbackMessage> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &slot = slots_[next_sequence_ % slots_.size()];
+    message->sequence = next_sequence_++;
+    dropped = std::move(slot);
+    slot = std::move(message);
+  }
+  // The dropped message, if no subscription still holds it, is freed here
+  // rather than under the lock
+}
+
+uint64_t LoopbackTopic::oldest_for(const LoopbackEndpoint &subscription) const {
+  const uint64_t retained = std::min<uint64_t>(
+      slots_.size(), std::max<size_t>(subscription.depth, 1));
+  return next_sequence_ > retained ? next_sequence_ - retained : 1;
+}
+
+bool LoopbackTopic::readable(const LoopbackEndpoint &subscription) const {
+  if (!subscription.type) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (uint64_t sequence =
+           std::max(subscription.cursor, oldest_for(subscription));
+       sequence < next_sequence_; ++sequence) {
+    const auto &message = slots_[sequence % slots_.size()];
+    if (message && message->type->name() == subscription.type->name()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<const LoopbackMessage>
+LoopbackTopic::take(LoopbackEndpoint &subscription) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  subscription.cursor =
+      std::max(subscription.cursor, oldest_for(subscription));
+  while (subscription.cursor < next_sequence_) {
+    const auto &message = slots_[subscription.cursor++ % slots_.size()];
+    if (message && message->type->name() == subscription.type->name()) {
+      return message;
+    }
+  }
+  return nullptr;
+}
+
+// --- LoopbackBus ---
+
+LoopbackBus &LoopbackBus::instance() {
+  static LoopbackBus instance;
+  return instance;
+}
+
+std::unique_ptr<LoopbackEndpoint>
+LoopbackBus::attach(const char *topic_name,
+                    const rosidl_message_type_support_t *type_support,
+                    const rmw_qos_profile_t &qos) {
+  auto endpoint = std::unique_ptr<LoopbackEndpoint>(
+      new (std::nothrow) LoopbackEndpoint);
+  if (!endpoint) {
+    return nullptr;
+  }
+  try {
+    endpoint->type = LoopbackType::create(type_support);
+    endpoint->depth = qos_depth(qos);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &entry = topics_[topic_name];
+    endpoint->topic = entry.lock();
+    if (!endpoint->topic) {
+      endpoint->topic = std::make_shared<LoopbackTopic>();
+      entry = endpoint->topic;
+    }
+    endpoint->topic->reserve(endpoint->depth);
+
+    // Forget topics whose endpoints are all gone
+    for (auto it = topics_.begin(); it != topics_.end();) {
+      it = it->second.expired() ? topics_.erase(it) : std::next(it);
+    }
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+  return endpoint;
+}
+
+std::unique_ptr<LoopbackEndpoint>
+LoopbackBus::attach_publisher(const char *topic_name,
+                              const rosidl_message_type_support_t *type_support,
+                              const rmw_qos_profile_t &qos) {
+  return attach(topic_name, type_support, qos);
+}
+
+std::unique_ptr<LoopbackEndpoint> LoopbackBus::attach_subscription(
+    const char *topic_name, const rosidl_message_type_support_t *type_support,
+    const rmw_qos_profile_t &qos) {
+  auto endpoint = attach(topic_name, type_support, qos);
+  if (endpoint) {
+    endpoint->topic->attach(
+        *endpoint,
+        qos.durability == RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL);
+  }
+  return endpoint;
+}
+
+rmw_ret_t LoopbackBus::publish(const LoopbackEndpoint &publisher,
+                               const void *message) {
+  if (!publisher.type) {
+    return RMW_RET_OK;
+  }
+  try {
+    auto copy = std::make_shared<LoopbackMessage>();
+    copy->type = publisher.type;
+    copy->data = publisher.type->clone(message);
+    copy->source_timestamp = system_time_ns();
+    publisher.topic->publish(std::move(copy));
+  } catch (const std::bad_alloc &) {
+    return RMW_RET_BAD_ALLOC;
+  }
+  WaitNotifier::instance().notify();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t LoopbackBus::take(LoopbackEndpoint &subscription, void *message,
+                            bool *taken, rmw_message_info_t *info) {
+  *taken = false;
+  if (!subscription.type) {
+    return RMW_RET_OK;
+  }
+  auto next = subscription.topic->take(subscription);
+  if (!next) {
+    return RMW_RET_OK;
+  }
+  try {
+    subscription.type->copy(next->data, message);
+  } catch (const std::bad_alloc &) {
+    return RMW_RET_BAD_ALLOC;
+  }
+  *taken = true;
+
+  if (info) {
+    *info = rmw_get_zero_initialized_message_info();
+    info->source_timestamp = next->source_timestamp;
+    info->received_timestamp = system_time_ns();
+    info->publication_sequence_number = next->sequence;
+    info->reception_sequence_number = next->sequence;
+  }
+  return RMW_RET_OK;
+}
+
+bool loopback_enabled() {
+  const char *env = std::getenv("RMW_INTROSPECT_LOOPBACK");
+  return env && (*env == '1' || *env == 't' || *env == 'T');
+}
+
+} // namespace rmw_introspect
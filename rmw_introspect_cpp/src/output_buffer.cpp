@@ -0,0 +1,85 @@
+#include "rmw_introspect/output_buffer.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace rmw_introspect {
+
+OutputBuffer::OutputBuffer(size_t capacity)
+    : fd_(-1), capacity_(capacity), ok_(true) {
+  buffer_.reserve(capacity);
+}
+
+OutputBuffer::OutputBuffer(int fd, size_t capacity)
+    : fd_(fd), capacity_(capacity > 0 ? capacity : 1), ok_(fd >= 0) {
+  buffer_.reserve(capacity_);
+}
+
+void OutputBuffer::fill(size_t count, char c) {
+  if (buffer_.size() + count > capacity_ && fd_ >= 0) {
+    drain(nullptr, 0);
+  }
+  buffer_.append(count, c);
+}
+
+void OutputBuffer::write_unsigned(uint64_t number) {
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), number);
+  write(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void OutputBuffer::write_signed(int64_t number) {
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), number);
+  write(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+void OutputBuffer::write_double(double number) {
+  if (!std::isfinite(number)) {
+    write("null", 4);
+    return;
+  }
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits), number);
+  write(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+bool OutputBuffer::flush() {
+  if (fd_ >= 0 && !buffer_.empty()) {
+    ok_ = write_fd(buffer_.data(), buffer_.size()) && ok_;
+    buffer_.clear();
+  }
+  return ok_;
+}
+
+void OutputBuffer::drain(const char *data, size_t size) {
+  flush();
+  if (size >= capacity_) {
+    ok_ = write_fd(data, size) && ok_;
+    return;
+  }
+  buffer_.append(data, size);
+}
+
+bool OutputBuffer::write_fd(const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd_, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+int open_export_file(const std::string &path) {
+  return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+}
+
+} // namespace rmw_introspect
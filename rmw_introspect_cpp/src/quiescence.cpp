@@ -0,0 +1,218 @@
+#include "rmw_introspect/quiescence.hpp"
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/stats.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace rmw_introspect {
+
+namespace {
+
+/// Parse a non-negative integer from the environment, -1 if unset or invalid
+long long env_integer(const char *name) {
+  const char *env = std::getenv(name);
+  if (!env || !*env) {
+    return -1;
+  }
+  char *end = nullptr;
+  long long value = std::strtoll(env, &end, 10);
+  if (*end != '\0' || value < 0) {
+    return -1;
+  }
+  return value;
+}
+
+/// Whether a boolean flag is set in the environment ('1', 't' or 'T')
+bool env_flag(const char *name) {
+  const char *env = std::getenv(name);
+  return env && (*env == '1' || *env == 't' || *env == 'T');
+}
+
+} // namespace
+
+QuiescenceMonitor &QuiescenceMonitor::instance() {
+  static QuiescenceMonitor instance;
+  return instance;
+}
+
+QuiescenceMonitor::QuiescenceMonitor()
+    : awaiting_wait_(false), signalled_(false), stop_(false),
+      first_wait_ns_(0), deadline_ns_(0) {
+  // The callback exports IntrospectionData, which must outlive our thread
+  IntrospectionData::instance();
+}
+
+QuiescenceMonitor::~QuiescenceMonitor() { stop(); }
+
+bool QuiescenceMonitor::start(const QuiescenceOptions &options,
+                              QuietCallback on_quiet) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) {
+    return false;
+  }
+  int ready_fd = options.ready_fd;
+  struct stat st;
+  if (ready_fd >= 0 &&
+      (::fstat(ready_fd, &st) != 0 || !S_ISFIFO(st.st_mode))) {
+    // A number inherited without its pipe may name one of the node's own
+    // files or sockets, which we must neither write to nor close
+    ready_fd = -1;
+  }
+  if (ready_fd >= 0) {
+    // Node subprocesses must not keep the supervisor's pipe open
+    ::fcntl(ready_fd, F_SETFD, FD_CLOEXEC);
+  }
+  stop_ = false;
+  first_wait_ns_ = 0;
+  deadline_ns_ =
+      options.deadline.count() > 0
+          ? steady_time_ns() +
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    options.deadline)
+                    .count()
+          : 0;
+  options_ = options;
+  options_.ready_fd = ready_fd;
+  on_quiet_ = std::move(on_quiet);
+  signalled_.store(false, std::memory_order_relaxed);
+  awaiting_wait_.store(true, std::memory_order_release);
+  thread_ = std::thread(&QuiescenceMonitor::run, this);
+  return true;
+}
+
+void QuiescenceMonitor::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable()) {
+      return;
+    }
+    stop_ = true;
+    awaiting_wait_.store(false, std::memory_order_relaxed);
+  }
+  wake_.notify_all();
+  thread_.join();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (options_.ready_fd >= 0) {
+    ::close(options_.ready_fd);
+    options_.ready_fd = -1;
+  }
+  on_quiet_ = nullptr;
+}
+
+void QuiescenceMonitor::first_wait() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!awaiting_wait_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    awaiting_wait_.store(false, std::memory_order_relaxed);
+    first_wait_ns_ = steady_time_ns();
+  }
+  wake_.notify_all();
+}
+
+void QuiescenceMonitor::run() {
+  auto &data = IntrospectionData::instance();
+  const int64_t window_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(options_.window)
+          .count();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  QuietReason reason = QuietReason::Quiet;
+  while (!stop_) {
+    const int64_t now_ns = steady_time_ns();
+    int64_t wake_ns = deadline_ns_;
+    if (first_wait_ns_ != 0) {
+      const int64_t quiet_ns =
+          std::max(first_wait_ns_, data.last_change_ns()) + window_ns;
+      if (quiet_ns <= now_ns) {
+        break;
+      }
+      wake_ns = wake_ns != 0 ? std::min(wake_ns, quiet_ns) : quiet_ns;
+    }
+    if (deadline_ns_ != 0 && deadline_ns_ <= now_ns) {
+      reason = QuietReason::Deadline;
+      break;
+    }
+    // Woken early by first_wait() and stop(); changes are picked up when
+    // the current window runs out
+    if (wake_ns == 0) {
+      wake_.wait(lock);
+    } else {
+      wake_.wait_for(lock, std::chrono::nanoseconds(wake_ns - now_ns));
+    }
+  }
+  if (stop_) {
+    return;
+  }
+
+  // Run the export unlocked; stop() waits for it by joining
+  auto on_quiet = on_quiet_;
+  lock.unlock();
+  const bool exported = on_quiet ? on_quiet(reason) : true;
+  lock.lock();
+
+  signalled_.store(true, std::memory_order_release);
+  if (options_.ready_fd >= 0) {
+    const char ready = exported ? '1' : '0';
+    while (::write(options_.ready_fd, &ready, 1) < 0 && errno == EINTR) {
+    }
+    ::close(options_.ready_fd);
+    options_.ready_fd = -1;
+  }
+
+  if (options_.exit_after_export) {
+    // Skip static destructors and a shutdown that may block: everything
+    // worth keeping has been written
+    std::fflush(nullptr);
+    ::_exit(exit_status(reason, exported));
+  }
+}
+
+int QuiescenceMonitor::exit_status(QuietReason reason, bool exported) const {
+  if (!exported) {
+    return kExitExportFailed;
+  }
+  if (reason == QuietReason::Quiet) {
+    return kExitExported;
+  }
+  return IntrospectionData::instance().node_count() == 0 ? kExitNoNode
+                                                         : kExitDeadline;
+}
+
+bool start_quiescence_from_env(QuiescenceMonitor::QuietCallback on_quiet) {
+  const long long window_ms = env_integer("RMW_INTROSPECT_QUIESCENCE_MS");
+  const long long deadline_ms = env_integer("RMW_INTROSPECT_DEADLINE_MS");
+  const long long ready_fd = env_integer("RMW_INTROSPECT_READY_FD");
+  // The descriptor is not inherited by the processes this node spawns
+  ::unsetenv("RMW_INTROSPECT_READY_FD");
+  // An intermediate node talks to real peers, which must see the real RMW
+  // shut down: it exports and signals, then keeps running until stopped
+  const bool exit_after_export = env_flag("RMW_INTROSPECT_EXIT_ON_EXPORT") &&
+                                 internal::is_recording_only_mode();
+  if (window_ms < 0 && deadline_ms < 0 && ready_fd < 0 &&
+      !exit_after_export) {
+    return false;
+  }
+
+  QuiescenceOptions options;
+  if (window_ms >= 0) {
+    options.window = std::chrono::milliseconds(window_ms);
+  }
+  if (deadline_ms >= 0) {
+    options.deadline = std::chrono::milliseconds(deadline_ms);
+  }
+  options.ready_fd = static_cast<int>(ready_fd);
+  options.exit_after_export = exit_after_export;
+  return QuiescenceMonitor::instance().start(options, std::move(on_quiet));
+}
+
+} // namespace rmw_introspect
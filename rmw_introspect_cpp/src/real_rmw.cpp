@@ -52,7 +52,8 @@ RealRMW::RealRMW()
       // Loaned messages
       borrow_loaned_message(nullptr),
       return_loaned_message_from_publisher(nullptr),
-      take_loaned_message(nullptr), take_loaned_message_with_info(nullptr),
+      publish_loaned_message(nullptr), take_loaned_message(nullptr),
+      take_loaned_message_with_info(nullptr),
       return_loaned_message_from_subscription(nullptr),
       // Topic and service names/types
       get_topic_names_and_types(nullptr), get_service_names_and_types(nullptr),
@@ -67,7 +68,15 @@ RealRMW::RealRMW()
       client_response_subscription_get_actual_qos(nullptr),
       // Event handling
       publisher_event_init(nullptr), subscription_event_init(nullptr),
-      take_event(nullptr), event_fini(nullptr) {}
+      take_event(nullptr), event_fini(nullptr), event_set_callback(nullptr),
+      // Preallocation
+      init_publisher_allocation(nullptr), fini_publisher_allocation(nullptr),
+      init_subscription_allocation(nullptr),
+      fini_subscription_allocation(nullptr),
+      // New-data callbacks
+      subscription_set_on_new_message_callback(nullptr),
+      service_set_on_new_request_callback(nullptr),
+      client_set_on_new_response_callback(nullptr) {}
 
 RealRMW::~RealRMW() { unload(); }
 
@@ -213,6 +222,8 @@ bool RealRMW::load(const char *implementation_name) {
   success &= load_symbol(borrow_loaned_message, "rmw_borrow_loaned_message");
   success &= load_symbol(return_loaned_message_from_publisher,
                          "rmw_return_loaned_message_from_publisher");
+  success &=
+      load_symbol(publish_loaned_message, "rmw_publish_loaned_message");
   success &= load_symbol(take_loaned_message, "rmw_take_loaned_message");
   success &= load_symbol(take_loaned_message_with_info,
                          "rmw_take_loaned_message_with_info");
@@ -249,6 +260,25 @@ bool RealRMW::load(const char *implementation_name) {
       load_symbol(subscription_event_init, "rmw_subscription_event_init");
   success &= load_symbol(take_event, "rmw_take_event");
   success &= load_symbol(event_fini, "rmw_event_fini");
+  load_symbol(event_set_callback, "rmw_event_set_callback", false);
+
+  // Preallocation (optional)
+  load_symbol(init_publisher_allocation, "rmw_init_publisher_allocation",
+              false);
+  load_symbol(fini_publisher_allocation, "rmw_fini_publisher_allocation",
+              false);
+  load_symbol(init_subscription_allocation,
+              "rmw_init_subscription_allocation", false);
+  load_symbol(fini_subscription_allocation,
+              "rmw_fini_subscription_allocation", false);
+
+  // New-data callbacks (optional)
+  load_symbol(subscription_set_on_new_message_callback,
+              "rmw_subscription_set_on_new_message_callback", false);
+  load_symbol(service_set_on_new_request_callback,
+              "rmw_service_set_on_new_request_callback", false);
+  load_symbol(client_set_on_new_response_callback,
+              "rmw_client_set_on_new_response_callback", false);
 
   if (!success) {
     if (verbose) {
@@ -327,6 +357,12 @@ void RealRMW::unload() {
   serialize = nullptr;
   deserialize = nullptr;
   get_serialized_message_size = nullptr;
+  borrow_loaned_message = nullptr;
+  return_loaned_message_from_publisher = nullptr;
+  publish_loaned_message = nullptr;
+  take_loaned_message = nullptr;
+  take_loaned_message_with_info = nullptr;
+  return_loaned_message_from_subscription = nullptr;
   get_topic_names_and_types = nullptr;
   get_service_names_and_types = nullptr;
   get_publisher_names_and_types_by_node = nullptr;
@@ -341,6 +377,14 @@ void RealRMW::unload() {
   subscription_event_init = nullptr;
   take_event = nullptr;
   event_fini = nullptr;
+  event_set_callback = nullptr;
+  init_publisher_allocation = nullptr;
+  fini_publisher_allocation = nullptr;
+  init_subscription_allocation = nullptr;
+  fini_subscription_allocation = nullptr;
+  subscription_set_on_new_message_callback = nullptr;
+  service_set_on_new_request_callback = nullptr;
+  client_set_on_new_response_callback = nullptr;
 }
 
 template <typename FuncPtr>
@@ -0,0 +1,220 @@
+#include "rmw_introspect/recorded_graph.hpp"
+#include <algorithm>
+#include <new>
+
+namespace rmw_introspect {
+
+namespace {
+
+/// Key of a node in RecordedGraph::nodes_; names cannot contain '/', so
+/// distinct nodes get distinct keys
+std::string node_key(const std::string &name, const std::string &ns) {
+  return ns + "/" + name;
+}
+
+size_t index_of(EntityKind kind) { return static_cast<size_t>(kind); }
+
+/// Drop one endpoint of `type` from `types`
+void release_type(std::map<std::string, size_t> &types,
+                  const std::string &type) {
+  auto it = types.find(type);
+  if (it != types.end() && --it->second == 0) {
+    types.erase(it);
+  }
+}
+
+/// Names of the types in `types`, sorted
+std::vector<std::string>
+type_names(const std::map<std::string, size_t> &types) {
+  std::vector<std::string> names;
+  names.reserve(types.size());
+  for (const auto &[type, count] : types) {
+    names.push_back(type);
+  }
+  return names;
+}
+
+} // namespace
+
+RecordedGraph &RecordedGraph::instance() {
+  static RecordedGraph instance;
+  return instance;
+}
+
+std::unordered_map<std::string, RecordedGraph::NameEntry> &
+RecordedGraph::names_for(EntityKind kind) {
+  return kind == EntityKind::Publisher || kind == EntityKind::Subscription
+             ? topics_
+             : services_;
+}
+
+const std::unordered_map<std::string, RecordedGraph::NameEntry> &
+RecordedGraph::names_for(EntityKind kind) const {
+  return kind == EntityKind::Publisher || kind == EntityKind::Subscription
+             ? topics_
+             : services_;
+}
+
+GraphEntryId RecordedGraph::add_node(const std::string &name,
+                                     const std::string &ns) {
+  GraphEntryId id = 0;
+  try {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string key = node_key(name, ns);
+    NodeEntry &node = nodes_[key];
+    if (node.instances++ == 0) {
+      node.name = name;
+      node.ns = ns;
+    }
+    id = next_id_++;
+    entries_[id] = {EntityKind::Node, std::move(key), {}, {}};
+  } catch (const std::bad_alloc &) {
+    return 0;
+  }
+  guard_condition_.trigger();
+  return id;
+}
+
+GraphEntryId RecordedGraph::add_endpoint(EntityKind kind,
+                                         const std::string &node_name,
+                                         const std::string &node_namespace,
+                                         const std::string &name,
+                                         const std::string &type) {
+  GraphEntryId id = 0;
+  try {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string key = node_key(node_name, node_namespace);
+    NameEntry &entry = names_for(kind)[name];
+    ++entry.counts[index_of(kind)];
+    ++entry.types[type];
+    ++nodes_[key].endpoints[index_of(kind)][name][type];
+    id = next_id_++;
+    entries_[id] = {kind, std::move(key), name, type};
+  } catch (const std::bad_alloc &) {
+    // Counts bumped before the failure stay until the process exits; a
+    // graph that overstates is better than one that loses a live endpoint
+    return 0;
+  }
+  guard_condition_.trigger();
+  return id;
+}
+
+void RecordedGraph::remove(GraphEntryId id) {
+  if (id == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry_it = entries_.find(id);
+    if (entry_it == entries_.end()) {
+      return;
+    }
+    const Entry &entry = entry_it->second;
+    auto node_it = nodes_.find(entry.node_key);
+
+    if (entry.kind == EntityKind::Node) {
+      if (node_it != nodes_.end()) {
+        --node_it->second.instances;
+      }
+    } else {
+      auto &names = names_for(entry.kind);
+      auto name_it = names.find(entry.name);
+      if (name_it != names.end()) {
+        NameEntry &name = name_it->second;
+        --name.counts[index_of(entry.kind)];
+        release_type(name.types, entry.type);
+        if (name.types.empty()) {
+          names.erase(name_it);
+        }
+      }
+      if (node_it != nodes_.end()) {
+        auto &endpoints = node_it->second.endpoints[index_of(entry.kind)];
+        auto endpoint_it = endpoints.find(entry.name);
+        if (endpoint_it != endpoints.end()) {
+          release_type(endpoint_it->second, entry.type);
+          if (endpoint_it->second.empty()) {
+            endpoints.erase(endpoint_it);
+          }
+        }
+      }
+    }
+
+    // Endpoints normally go first, but a node outlived by its endpoints
+    // stays listed under them until they are gone too
+    if (node_it != nodes_.end() && node_it->second.instances == 0 &&
+        std::all_of(std::begin(node_it->second.endpoints),
+                    std::end(node_it->second.endpoints),
+                    [](const auto &endpoints) { return endpoints.empty(); })) {
+      nodes_.erase(node_it);
+    }
+    entries_.erase(entry_it);
+  }
+  guard_condition_.trigger();
+}
+
+size_t RecordedGraph::count(EntityKind kind, const std::string &name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto &names = names_for(kind);
+  auto it = names.find(name);
+  return it == names.end() ? 0 : it->second.counts[index_of(kind)];
+}
+
+std::vector<std::pair<std::string, std::string>>
+RecordedGraph::node_names() const {
+  std::vector<std::pair<std::string, std::string>> result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &[key, node] : nodes_) {
+    for (size_t i = 0; i < node.instances; ++i) {
+      result.emplace_back(node.name, node.ns);
+    }
+  }
+  return result;
+}
+
+bool RecordedGraph::has_node(const std::string &name,
+                             const std::string &ns) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = nodes_.find(node_key(name, ns));
+  return it != nodes_.end() && it->second.instances > 0;
+}
+
+NamesAndTypes RecordedGraph::collect(
+    const std::unordered_map<std::string, NameEntry> &names) {
+  NamesAndTypes result;
+  result.reserve(names.size());
+  for (const auto &[name, entry] : names) {
+    result.emplace_back(name, type_names(entry.types));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+NamesAndTypes RecordedGraph::topic_names_and_types() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return collect(topics_);
+}
+
+NamesAndTypes RecordedGraph::service_names_and_types() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return collect(services_);
+}
+
+NamesAndTypes RecordedGraph::names_and_types_by_node(
+    EntityKind kind, const std::string &node_name,
+    const std::string &node_namespace) const {
+  NamesAndTypes result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto node_it = nodes_.find(node_key(node_name, node_namespace));
+  if (node_it == nodes_.end()) {
+    return result;
+  }
+  const auto &endpoints = node_it->second.endpoints[index_of(kind)];
+  result.reserve(endpoints.size());
+  for (const auto &[name, types] : endpoints) {
+    result.emplace_back(name, type_names(types));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+} // namespace rmw_introspect
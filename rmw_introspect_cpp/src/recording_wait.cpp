@@ -0,0 +1,161 @@
+#include "rmw_introspect/recording_wait.hpp"
+#include "rmw_introspect/loopback.hpp"
+#include "rmw_introspect/wrappers.hpp"
+#include <cstdlib>
+
+namespace rmw_introspect {
+
+namespace {
+
+template <typename T> void clear_entries(T **entries, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    entries[i] = nullptr;
+  }
+}
+
+/// Whether a subscription entry (a RecordingEntity) has a message to take
+bool has_message(void *entry) {
+  auto *entity = static_cast<RecordingEntity *>(entry);
+  return entity && entity->loopback &&
+         entity->loopback->topic->readable(*entity->loopback);
+}
+
+} // namespace
+
+WaitNotifier &WaitNotifier::instance() {
+  static WaitNotifier instance;
+  return instance;
+}
+
+void WaitNotifier::notify() {
+  // Sequentially consistent with the waiter's increment and check, so one
+  // of the two always sees the other
+  generation_.fetch_add(1);
+  if (waiters_.load() == 0) {
+    return;
+  }
+  // A waiter between its generation check and blocking holds the mutex, so
+  // taking it here cannot slip the wakeup in between
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  wake_.notify_all();
+}
+
+uint64_t WaitNotifier::wait(uint64_t seen,
+                            const std::chrono::nanoseconds *timeout) {
+  const auto changed = [this, seen]() { return generation_.load() != seen; };
+  std::unique_lock<std::mutex> lock(mutex_);
+  waiters_.fetch_add(1);
+  if (timeout) {
+    wake_.wait_for(lock, *timeout, changed);
+  } else {
+    wake_.wait(lock, changed);
+  }
+  waiters_.fetch_sub(1);
+  return generation();
+}
+
+double parse_time_scale(const char *value) {
+  if (!value || !*value) {
+    return 1.0;
+  }
+  char *end = nullptr;
+  const double scale = std::strtod(value, &end);
+  if (*end != '\0' || !(scale > 0.0)) {
+    return 1.0;
+  }
+  return scale;
+}
+
+double time_scale() {
+  static const double scale =
+      parse_time_scale(std::getenv("RMW_INTROSPECT_TIME_SCALE"));
+  return scale;
+}
+
+rmw_ret_t recording_only_wait(rmw_subscriptions_t *subscriptions,
+                              rmw_guard_conditions_t *guard_conditions,
+                              rmw_services_t *services, rmw_clients_t *clients,
+                              rmw_events_t *events, rmw_wait_set_t *,
+                              const rmw_time_t *wait_timeout) {
+  if (services) {
+    clear_entries(services->services, services->service_count);
+  }
+  if (clients) {
+    clear_entries(clients->clients, clients->client_count);
+  }
+  if (events) {
+    clear_entries(events->events, events->event_count);
+  }
+
+  // Subscriptions only have messages under RMW_INTROSPECT_LOOPBACK
+  void **subscribers = subscriptions ? subscriptions->subscribers : nullptr;
+  const size_t subscriber_count =
+      subscriptions ? subscriptions->subscriber_count : 0;
+  void **entries = guard_conditions ? guard_conditions->guard_conditions
+                                    : nullptr;
+  const size_t count =
+      guard_conditions ? guard_conditions->guard_condition_count : 0;
+  const auto any_ready = [=]() {
+    for (size_t i = 0; i < subscriber_count; ++i) {
+      if (has_message(subscribers[i])) {
+        return true;
+      }
+    }
+    for (size_t i = 0; i < count; ++i) {
+      auto *gc = static_cast<RecordingGuardCondition *>(entries[i]);
+      if (gc && gc->triggered.load()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto &notifier = WaitNotifier::instance();
+  const bool poll =
+      wait_timeout && wait_timeout->sec == 0 && wait_timeout->nsec == 0;
+  std::chrono::steady_clock::time_point deadline;
+  if (wait_timeout && !poll) {
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::duration<double, std::nano>(
+                       (static_cast<double>(wait_timeout->sec) * 1e9 +
+                        static_cast<double>(wait_timeout->nsec)) /
+                       time_scale()));
+  }
+
+  // Read the generation before the flags and rings: a trigger or message the
+  // check misses bumps it afterwards, ending the wait below
+  for (uint64_t seen = notifier.generation(); !any_ready() && !poll;
+       seen = notifier.generation()) {
+    if (!wait_timeout) {
+      notifier.wait(seen, nullptr);
+      continue;
+    }
+    const std::chrono::nanoseconds remaining =
+        deadline - std::chrono::steady_clock::now();
+    if (remaining <= std::chrono::nanoseconds::zero()) {
+      break;
+    }
+    notifier.wait(seen, &remaining);
+  }
+
+  bool ready = false;
+  for (size_t i = 0; i < subscriber_count; ++i) {
+    if (has_message(subscribers[i])) {
+      ready = true;
+    } else {
+      subscribers[i] = nullptr;
+    }
+  }
+  for (size_t i = 0; i < count; ++i) {
+    auto *gc = static_cast<RecordingGuardCondition *>(entries[i]);
+    if (gc && gc->take()) {
+      ready = true;
+    } else {
+      entries[i] = nullptr;
+    }
+  }
+  return ready ? RMW_RET_OK : RMW_RET_TIMEOUT;
+}
+
+} // namespace rmw_introspect
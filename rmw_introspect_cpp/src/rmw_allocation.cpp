@@ -2,13 +2,90 @@
 #include "rmw/error_handling.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/type_support.hpp"
 #include "rmw_introspect/visibility_control.h"
+#include "rmw_introspect/wrappers.hpp"
+#include <new>
 
-extern "C" {
+namespace {
+
+/// Shared body of rmw_init_{publisher,subscription}_allocation
+template <typename WrapperT, typename AllocationT, typename RealInitT>
+rmw_ret_t init_allocation(const rosidl_message_type_support_t *type_support,
+                          const rosidl_runtime_c__Sequence__bound *bounds,
+                          AllocationT *allocation, RealInitT real_init) {
+  using namespace rmw_introspect::internal;
+
+  bool bounded = false;
+  bool introspectable =
+      rmw_introspect::is_message_bounded(type_support, &bounded);
+
+  // Recording-only mode emulates preallocation, so the message layout must be
+  // known up front, and unbounded strings and sequences need bounds to size
+  // the storage by, as with a preallocating RMW
+  if (is_recording_only_mode()) {
+    if (!introspectable) {
+      RMW_SET_ERROR_MSG("type support has no introspection information");
+      return RMW_RET_ERROR;
+    }
+    if (!bounded && !bounds) {
+      RMW_SET_ERROR_MSG("message type is unbounded and no bounds were given");
+      return RMW_RET_UNSUPPORTED;
+    }
+  }
+
+  // Intermediate mode: the real RMW must support preallocation itself
+  if (is_intermediate_mode() && !real_init) {
+    RMW_SET_ERROR_MSG("real RMW does not support allocations");
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  auto *wrapper = new (std::nothrow) WrapperT();
+  if (!wrapper) {
+    RMW_SET_ERROR_MSG("failed to allocate allocation wrapper");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  if (is_intermediate_mode()) {
+    rmw_ret_t ret = real_init(type_support, bounds, &wrapper->real_allocation);
+    if (ret != RMW_RET_OK) {
+      delete wrapper;
+      return ret;
+    }
+  }
+
+  allocation->implementation_identifier = rmw_introspect_cpp_identifier;
+  allocation->data = wrapper;
+  return RMW_RET_OK;
+}
+
+/// Shared body of rmw_fini_{publisher,subscription}_allocation
+template <typename WrapperT, typename AllocationT, typename RealFiniT>
+rmw_ret_t fini_allocation(AllocationT *allocation, RealFiniT real_fini) {
+  using namespace rmw_introspect::internal;
+
+  auto *wrapper = static_cast<WrapperT *>(allocation->data);
+  if (wrapper && wrapper->real_allocation.implementation_identifier &&
+      is_intermediate_mode() && real_fini) {
+    rmw_ret_t ret = real_fini(&wrapper->real_allocation);
+    if (ret != RMW_RET_OK) {
+      return ret;
+    }
+  }
+
+  delete wrapper;
+  allocation->implementation_identifier = nullptr;
+  allocation->data = nullptr;
+  return RMW_RET_OK;
+}
 
-// All allocation functions return UNSUPPORTED - introspection doesn't use
-// zero-copy
+} // namespace
+
+extern "C" {
 
 // Initialize publisher allocation
 RMW_INTROSPECT_PUBLIC
@@ -16,18 +93,33 @@ rmw_ret_t rmw_init_publisher_allocation(
     const rosidl_message_type_support_t *type_support,
     const rosidl_runtime_c__Sequence__bound *message_bounds,
     rmw_publisher_allocation_t *allocation) {
-  (void)type_support;
-  (void)message_bounds;
-  (void)allocation;
-  return RMW_RET_UNSUPPORTED;
+  using namespace rmw_introspect::internal;
+
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+
+  return init_allocation<rmw_introspect::PublisherAllocationWrapper>(
+      type_support, message_bounds, allocation,
+      is_intermediate_mode() ? g_real_rmw->init_publisher_allocation
+                             : nullptr);
 }
 
 // Finalize publisher allocation
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t
 rmw_fini_publisher_allocation(rmw_publisher_allocation_t *allocation) {
-  (void)allocation;
-  return RMW_RET_UNSUPPORTED;
+  using namespace rmw_introspect::internal;
+
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+      allocation, allocation->implementation_identifier,
+      rmw_introspect_cpp_identifier,
+      return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  return fini_allocation<rmw_introspect::PublisherAllocationWrapper>(
+      allocation, is_intermediate_mode()
+                      ? g_real_rmw->fini_publisher_allocation
+                      : nullptr);
 }
 
 // Initialize subscription allocation
@@ -36,18 +128,33 @@ rmw_ret_t rmw_init_subscription_allocation(
     const rosidl_message_type_support_t *type_support,
     const rosidl_runtime_c__Sequence__bound *message_bounds,
     rmw_subscription_allocation_t *allocation) {
-  (void)type_support;
-  (void)message_bounds;
-  (void)allocation;
-  return RMW_RET_UNSUPPORTED;
+  using namespace rmw_introspect::internal;
+
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+
+  return init_allocation<rmw_introspect::SubscriptionAllocationWrapper>(
+      type_support, message_bounds, allocation,
+      is_intermediate_mode() ? g_real_rmw->init_subscription_allocation
+                             : nullptr);
 }
 
 // Finalize subscription allocation
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t
 rmw_fini_subscription_allocation(rmw_subscription_allocation_t *allocation) {
-  (void)allocation;
-  return RMW_RET_UNSUPPORTED;
+  using namespace rmw_introspect::internal;
+
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+      allocation, allocation->implementation_identifier,
+      rmw_introspect_cpp_identifier,
+      return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  return fini_allocation<rmw_introspect::SubscriptionAllocationWrapper>(
+      allocation, is_intermediate_mode()
+                      ? g_real_rmw->fini_subscription_allocation
+                      : nullptr);
 }
 
 // Publish loaned message
@@ -55,10 +162,16 @@ RMW_INTROSPECT_PUBLIC
 rmw_ret_t rmw_publish_loaned_message(const rmw_publisher_t *publisher,
                                      void *ros_message,
                                      rmw_publisher_allocation_t *allocation) {
-  (void)publisher;
-  (void)ros_message;
-  (void)allocation;
-  return RMW_RET_UNSUPPORTED;
+  using namespace rmw_introspect::internal;
+
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+
+  if (rmw_ret_t ret = check_dispatch_handle(publisher); ret != RMW_RET_OK) {
+    return ret;
+  }
+  return current_dispatch().publish_loaned_message(publisher, ros_message,
+                                                   allocation);
 }
 
 } // extern "C"
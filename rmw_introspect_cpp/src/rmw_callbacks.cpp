@@ -2,23 +2,43 @@
 #include "rmw/error_handling.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
+#include "rmw_introspect/forwarding.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/real_rmw.hpp"
 #include "rmw_introspect/visibility_control.h"
+#include "rmw_introspect/wrappers.hpp"
 
 extern "C" {
 
-// Set callback for new message - accept but never invoke
+// Set callback for new message
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t
 rmw_subscription_set_on_new_message_callback(rmw_subscription_t *subscription,
                                              rmw_event_callback_t callback,
                                              const void *user_data) {
+  using namespace rmw_introspect::internal;
+
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(subscription,
                                    subscription->implementation_identifier,
                                    rmw_introspect_cpp_identifier,
                                    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
+  // Intermediate mode: forward through the trampoline
+  if (is_intermediate_mode()) {
+    if (!g_real_rmw->subscription_set_on_new_message_callback) {
+      RMW_SET_ERROR_MSG("real RMW does not support new message callbacks");
+      return RMW_RET_UNSUPPORTED;
+    }
+    auto *wrapper =
+        static_cast<rmw_introspect::SubscriptionWrapper *>(subscription->data);
+    return set_callback_trampoline(
+        g_real_rmw->subscription_set_on_new_message_callback,
+        wrapper->real_subscription, wrapper->on_new_message, callback,
+        user_data);
+  }
+
   (void)callback;
   (void)user_data;
 
@@ -26,16 +46,31 @@ rmw_subscription_set_on_new_message_callback(rmw_subscription_t *subscription,
   return RMW_RET_OK;
 }
 
-// Set callback for new service request - accept but never invoke
+// Set callback for new service request
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t rmw_service_set_on_new_request_callback(rmw_service_t *service,
                                                   rmw_event_callback_t callback,
                                                   const void *user_data) {
+  using namespace rmw_introspect::internal;
+
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(service, RMW_RET_INVALID_ARGUMENT);
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(service, service->implementation_identifier,
                                    rmw_introspect_cpp_identifier,
                                    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
+  // Intermediate mode: forward through the trampoline
+  if (is_intermediate_mode()) {
+    if (!g_real_rmw->service_set_on_new_request_callback) {
+      RMW_SET_ERROR_MSG("real RMW does not support new request callbacks");
+      return RMW_RET_UNSUPPORTED;
+    }
+    auto *wrapper =
+        static_cast<rmw_introspect::ServiceWrapper *>(service->data);
+    return set_callback_trampoline(
+        g_real_rmw->service_set_on_new_request_callback, wrapper->real_service,
+        wrapper->on_new_request, callback, user_data);
+  }
+
   (void)callback;
   (void)user_data;
 
@@ -43,16 +78,30 @@ rmw_ret_t rmw_service_set_on_new_request_callback(rmw_service_t *service,
   return RMW_RET_OK;
 }
 
-// Set callback for new client response - accept but never invoke
+// Set callback for new client response
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t rmw_client_set_on_new_response_callback(rmw_client_t *client,
                                                   rmw_event_callback_t callback,
                                                   const void *user_data) {
+  using namespace rmw_introspect::internal;
+
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(client, client->implementation_identifier,
                                    rmw_introspect_cpp_identifier,
                                    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
+  // Intermediate mode: forward through the trampoline
+  if (is_intermediate_mode()) {
+    if (!g_real_rmw->client_set_on_new_response_callback) {
+      RMW_SET_ERROR_MSG("real RMW does not support new response callbacks");
+      return RMW_RET_UNSUPPORTED;
+    }
+    auto *wrapper = static_cast<rmw_introspect::ClientWrapper *>(client->data);
+    return set_callback_trampoline(
+        g_real_rmw->client_set_on_new_response_callback, wrapper->real_client,
+        wrapper->on_new_response, callback, user_data);
+  }
+
   (void)callback;
   (void)user_data;
 
@@ -3,15 +3,20 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 #include "rmw_introspect/data.hpp"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/forwarding.hpp"
+#include "rmw_introspect/handle_pool.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
 #include "rmw_introspect/mode.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
 #include "rmw_introspect/type_support.hpp"
 #include "rmw_introspect/types.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
 #include <chrono>
+#include <memory>
 #include <new>
 
 extern "C" {
@@ -46,7 +51,12 @@ rmw_client_t *rmw_create_client(
                        std::chrono::system_clock::now().time_since_epoch())
                        .count();
 
-  rmw_introspect::IntrospectionData::instance().record_client(info);
+  if (is_intermediate_mode()) {
+    info.stats = std::make_shared<rmw_introspect::ClientStats>();
+  }
+
+  rmw_introspect::RecordId record_id =
+      rmw_introspect::IntrospectionData::instance().record_client(info);
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
@@ -64,26 +74,23 @@ rmw_client_t *rmw_create_client(
       return nullptr;
     }
 
-    // Create wrapper
-    auto *wrapper = new (std::nothrow) rmw_introspect::ClientWrapper(
-        real_client, service_name, service_type, *qos_profile);
-    if (!wrapper) {
-      g_real_rmw->destroy_client(real_node, real_client);
-      RMW_SET_ERROR_MSG("failed to allocate client wrapper");
-      return nullptr;
-    }
-
-    // Create our client structure
-    rmw_client_t *client = new (std::nothrow) rmw_client_t;
+    // Create our client structure and its wrapper in one pooled slot
+    rmw_client_t *client = client_pool().acquire(
+        real_client, service_name, service_type, *qos_profile,
+        info.stats);
     if (!client) {
       g_real_rmw->destroy_client(real_node, real_client);
-      delete wrapper;
       RMW_SET_ERROR_MSG("failed to allocate client");
       return nullptr;
     }
+    auto *wrapper = static_cast<rmw_introspect::ClientWrapper *>(client->data);
+    wrapper->send_request_latency =
+        rmw_introspect::LatencyRegistry::instance().create(
+            "send_request", rmw_introspect::latency_entity_label(
+                                node->namespace_, node->name, service_name));
+    wrapper->record_id = record_id;
 
     client->implementation_identifier = rmw_introspect_cpp_identifier;
-    client->data = wrapper;
     client->service_name = real_client->service_name;
 
     return client;
@@ -97,7 +104,16 @@ rmw_client_t *rmw_create_client(
   }
 
   client->implementation_identifier = rmw_introspect_cpp_identifier;
-  client->data = nullptr;
+  auto *entity = new (std::nothrow) rmw_introspect::RecordingEntity(record_id);
+  client->data = entity;
+  if (!client->data) {
+    delete client;
+    RMW_SET_ERROR_MSG("failed to allocate client data");
+    return nullptr;
+  }
+  entity->graph_id = rmw_introspect::RecordedGraph::instance().add_endpoint(
+      rmw_introspect::EntityKind::Client, node->name, node->namespace_,
+      service_name, service_type);
   client->service_name = service_name;
 
   return client;
@@ -128,12 +144,22 @@ rmw_ret_t rmw_destroy_client(rmw_node_t *node, rmw_client_t *client) {
         return ret;
       }
     }
-    delete wrapper;
-    delete client;
+    if (wrapper) {
+      rmw_introspect::IntrospectionData::instance().record_destroy(
+          rmw_introspect::EntityKind::Client, wrapper->record_id);
+    }
+    client_pool().release(client);
     return RMW_RET_OK;
   }
 
   // Recording-only mode
+  auto *entity = static_cast<rmw_introspect::RecordingEntity *>(client->data);
+  if (entity) {
+    rmw_introspect::IntrospectionData::instance().record_destroy(
+        rmw_introspect::EntityKind::Client, entity->record_id);
+    rmw_introspect::RecordedGraph::instance().remove(entity->graph_id);
+    delete entity;
+  }
   delete client;
   return RMW_RET_OK;
 }
@@ -148,19 +174,10 @@ rmw_ret_t rmw_send_request(const rmw_client_t *client, const void *ros_request,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(sequence_id, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_client_t *real_client = unwrap_client(client);
-    if (!real_client) {
-      RMW_SET_ERROR_MSG("failed to unwrap client");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->send_request(real_client, ros_request, sequence_id);
+  if (rmw_ret_t ret = check_dispatch_handle(client); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: return dummy sequence number
-  *sequence_id = 1;
-  return RMW_RET_OK;
+  return current_dispatch().send_request(client, ros_request, sequence_id);
 }
 
 // Take response
@@ -175,20 +192,11 @@ rmw_ret_t rmw_take_response(const rmw_client_t *client,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_client_t *real_client = unwrap_client(client);
-    if (!real_client) {
-      RMW_SET_ERROR_MSG("failed to unwrap client");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_response(real_client, request_header, ros_response,
-                                     taken);
+  if (rmw_ret_t ret = check_dispatch_handle(client); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  *taken = false;
-  return RMW_RET_OK;
+  return current_dispatch().take_response(client, request_header, ros_response,
+                                          taken);
 }
 
 // Get client request publisher actual QoS
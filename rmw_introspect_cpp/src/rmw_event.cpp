@@ -1,5 +1,6 @@
 #include "rmw/error_handling.h"
 #include "rmw/event.h"
+#include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 #include "rmw_introspect/forwarding.hpp"
 #include "rmw_introspect/identifier.hpp"
@@ -7,6 +8,37 @@
 #include "rmw_introspect/real_rmw.hpp"
 #include "rmw_introspect/wrappers.hpp"
 #include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace {
+
+/// Wrap a real event created by `real_init` into the caller's rmw_event
+template <typename RealInitFn>
+rmw_ret_t init_event(rmw_event_t *rmw_event, rmw_event_type_t event_type,
+                     std::shared_ptr<rmw_introspect::QoSEventStats> stats,
+                     RealInitFn real_init) {
+  auto *wrapper =
+      new (std::nothrow) rmw_introspect::EventWrapper(std::move(stats));
+  if (!wrapper) {
+    RMW_SET_ERROR_MSG("failed to allocate event wrapper");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  rmw_ret_t ret = real_init(&wrapper->real_event);
+  if (ret != RMW_RET_OK) {
+    delete wrapper;
+    return ret;
+  }
+
+  rmw_event->implementation_identifier = rmw_introspect_cpp_identifier;
+  rmw_event->data = wrapper;
+  rmw_event->event_type = event_type;
+  return RMW_RET_OK;
+}
+
+} // namespace
 
 extern "C" {
 
@@ -20,13 +52,20 @@ rmw_ret_t rmw_publisher_event_init(rmw_event_t *rmw_event,
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
-    rmw_publisher_t *real_publisher = unwrap_publisher(publisher);
-    if (!real_publisher) {
+    auto *pub_wrapper = get_publisher_wrapper(publisher);
+    if (!pub_wrapper) {
       RMW_SET_ERROR_MSG("failed to unwrap publisher");
       return RMW_RET_ERROR;
     }
-    return g_real_rmw->publisher_event_init(rmw_event, real_publisher,
-                                            event_type);
+    // Count into the publisher's stats, keeping them alive with the event
+    std::shared_ptr<rmw_introspect::QoSEventStats> stats(
+        pub_wrapper->stats, &pub_wrapper->stats->qos_events);
+    return init_event(rmw_event, event_type, std::move(stats),
+                      [&](rmw_event_t *real_event) {
+                        return g_real_rmw->publisher_event_init(
+                            real_event, pub_wrapper->real_publisher,
+                            event_type);
+                      });
   }
 
   // Recording-only mode: events are not supported
@@ -43,13 +82,20 @@ rmw_ret_t rmw_subscription_event_init(rmw_event_t *rmw_event,
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
+    auto *sub_wrapper = get_subscription_wrapper(subscription);
+    if (!sub_wrapper) {
       RMW_SET_ERROR_MSG("failed to unwrap subscription");
       return RMW_RET_ERROR;
     }
-    return g_real_rmw->subscription_event_init(rmw_event, real_subscription,
-                                               event_type);
+    // Count into the subscription's stats, keeping them alive with the event
+    std::shared_ptr<rmw_introspect::QoSEventStats> stats(
+        sub_wrapper->stats, &sub_wrapper->stats->qos_events);
+    return init_event(rmw_event, event_type, std::move(stats),
+                      [&](rmw_event_t *real_event) {
+                        return g_real_rmw->subscription_event_init(
+                            real_event, sub_wrapper->real_subscription,
+                            event_type);
+                      });
   }
 
   // Recording-only mode: events are not supported
@@ -66,7 +112,19 @@ rmw_ret_t rmw_take_event(const rmw_event_t *event_handle, void *event_info,
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
-    return g_real_rmw->take_event(event_handle, event_info, taken);
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+        event_handle, event_handle->implementation_identifier,
+        rmw_introspect_cpp_identifier,
+        return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    auto *wrapper =
+        static_cast<rmw_introspect::EventWrapper *>(event_handle->data);
+    rmw_ret_t ret =
+        g_real_rmw->take_event(&wrapper->real_event, event_info, taken);
+    if (ret == RMW_RET_OK && *taken) {
+      wrapper->record_taken(event_info);
+    }
+    return ret;
   }
 
   // Recording-only mode: no events available
@@ -81,7 +139,19 @@ rmw_ret_t rmw_event_fini(rmw_event_t *event) {
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
-    return g_real_rmw->event_fini(event);
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+        event, event->implementation_identifier, rmw_introspect_cpp_identifier,
+        return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    auto *wrapper = static_cast<rmw_introspect::EventWrapper *>(event->data);
+    rmw_ret_t ret = g_real_rmw->event_fini(&wrapper->real_event);
+    if (ret != RMW_RET_OK) {
+      return ret;
+    }
+    delete wrapper;
+    event->implementation_identifier = nullptr;
+    event->data = nullptr;
+    return RMW_RET_OK;
   }
 
   // Recording-only mode: no-op
@@ -91,12 +161,30 @@ rmw_ret_t rmw_event_fini(rmw_event_t *event) {
 rmw_ret_t rmw_event_set_callback(rmw_event_t *event,
                                  rmw_event_callback_t callback,
                                  const void *user_data) {
+  using namespace rmw_introspect::internal;
+
+  // Intermediate mode: forward through the trampoline
+  if (is_intermediate_mode()) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(event, RMW_RET_INVALID_ARGUMENT);
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+        event, event->implementation_identifier, rmw_introspect_cpp_identifier,
+        return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+    if (!g_real_rmw->event_set_callback) {
+      RMW_SET_ERROR_MSG("real RMW does not support event callbacks");
+      return RMW_RET_UNSUPPORTED;
+    }
+    auto *wrapper = static_cast<rmw_introspect::EventWrapper *>(event->data);
+    return set_callback_trampoline(g_real_rmw->event_set_callback,
+                                   &wrapper->real_event, wrapper->on_event,
+                                   callback, user_data);
+  }
+
   (void)event;
   (void)callback;
   (void)user_data;
 
-  // No-op: callbacks not currently supported
-  // This would need special handling in intermediate mode if needed
+  // No-op: recording-only mode never creates events
   return RMW_RET_OK;
 }
 
@@ -1,4 +1,5 @@
 #include "rcutils/allocator.h"
+#include "rcutils/strdup.h"
 #include "rcutils/types/string_array.h"
 #include "rmw/error_handling.h"
 #include "rmw/get_node_info_and_types.h"
@@ -8,8 +9,106 @@
 #include "rmw_introspect/identifier.hpp"
 #include "rmw_introspect/mode.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
 #include "rmw_introspect/wrappers.hpp"
 
+namespace {
+
+/// Copy recorded names and types into `result`
+rmw_ret_t to_names_and_types(const rmw_introspect::NamesAndTypes &recorded,
+                             rcutils_allocator_t *allocator,
+                             rmw_names_and_types_t *result) {
+  rmw_ret_t ret = rmw_names_and_types_init(result, recorded.size(), allocator);
+  if (ret != RMW_RET_OK) {
+    return ret;
+  }
+  for (size_t i = 0; i < recorded.size(); ++i) {
+    const auto &[name, types] = recorded[i];
+    result->names.data[i] = rcutils_strdup(name.c_str(), *allocator);
+    bool ok = result->names.data[i] &&
+              rcutils_string_array_init(&result->types[i], types.size(),
+                                        allocator) == RCUTILS_RET_OK;
+    for (size_t j = 0; ok && j < types.size(); ++j) {
+      result->types[i].data[j] = rcutils_strdup(types[j].c_str(), *allocator);
+      ok = result->types[i].data[j] != nullptr;
+    }
+    if (!ok) {
+      rmw_names_and_types_fini(result);
+      RMW_SET_ERROR_MSG("failed to allocate names and types");
+      return RMW_RET_BAD_ALLOC;
+    }
+  }
+  return RMW_RET_OK;
+}
+
+/// Names and types of a recorded node's `kind` endpoints
+rmw_ret_t recorded_names_and_types_by_node(rmw_introspect::EntityKind kind,
+                                           const char *node_name,
+                                           const char *node_namespace,
+                                           rcutils_allocator_t *allocator,
+                                           rmw_names_and_types_t *result) {
+  auto &graph = rmw_introspect::RecordedGraph::instance();
+  if (!graph.has_node(node_name, node_namespace)) {
+    RMW_SET_ERROR_MSG("node not found");
+    return RMW_RET_NODE_NAME_NON_EXISTENT;
+  }
+  return to_names_and_types(
+      graph.names_and_types_by_node(kind, node_name, node_namespace),
+      allocator, result);
+}
+
+/// Names and namespaces of the recorded nodes, and their enclaves if set
+rmw_ret_t recorded_node_names(rcutils_string_array_t *node_names,
+                              rcutils_string_array_t *node_namespaces,
+                              rcutils_string_array_t *enclaves) {
+  const auto nodes = rmw_introspect::RecordedGraph::instance().node_names();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_ret_t ret =
+      rcutils_string_array_init(node_names, nodes.size(), &allocator);
+  if (ret != RCUTILS_RET_OK) {
+    RMW_SET_ERROR_MSG("failed to initialize node_names");
+    return RMW_RET_ERROR;
+  }
+  ret = rcutils_string_array_init(node_namespaces, nodes.size(), &allocator);
+  if (ret != RCUTILS_RET_OK) {
+    RMW_SET_ERROR_MSG("failed to initialize node_namespaces");
+    rcutils_string_array_fini(node_names);
+    return RMW_RET_ERROR;
+  }
+  if (enclaves) {
+    ret = rcutils_string_array_init(enclaves, nodes.size(), &allocator);
+    if (ret != RCUTILS_RET_OK) {
+      RMW_SET_ERROR_MSG("failed to initialize enclaves");
+      rcutils_string_array_fini(node_names);
+      rcutils_string_array_fini(node_namespaces);
+      return RMW_RET_ERROR;
+    }
+  }
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    node_names->data[i] = rcutils_strdup(nodes[i].first.c_str(), allocator);
+    node_namespaces->data[i] =
+        rcutils_strdup(nodes[i].second.c_str(), allocator);
+    // Enclaves are not recorded; every node gets the default one
+    if (enclaves) {
+      enclaves->data[i] = rcutils_strdup("/", allocator);
+    }
+    if (!node_names->data[i] || !node_namespaces->data[i] ||
+        (enclaves && !enclaves->data[i])) {
+      rcutils_string_array_fini(node_names);
+      rcutils_string_array_fini(node_namespaces);
+      if (enclaves) {
+        rcutils_string_array_fini(enclaves);
+      }
+      RMW_SET_ERROR_MSG("failed to allocate node names");
+      return RMW_RET_BAD_ALLOC;
+    }
+  }
+  return RMW_RET_OK;
+}
+
+} // namespace
+
 extern "C" {
 
 rmw_ret_t rmw_count_publishers(const rmw_node_t *node, const char *topic_name,
@@ -30,8 +129,9 @@ rmw_ret_t rmw_count_publishers(const rmw_node_t *node, const char *topic_name,
     return g_real_rmw->count_publishers(real_node, topic_name, count);
   }
 
-  // Recording-only mode: return 0
-  *count = 0;
+  // Recording-only mode: recorded publishers on the topic
+  *count = rmw_introspect::RecordedGraph::instance().count(
+      rmw_introspect::EntityKind::Publisher, topic_name);
   return RMW_RET_OK;
 }
 
@@ -53,8 +153,9 @@ rmw_ret_t rmw_count_subscribers(const rmw_node_t *node, const char *topic_name,
     return g_real_rmw->count_subscribers(real_node, topic_name, count);
   }
 
-  // Recording-only mode: return 0
-  *count = 0;
+  // Recording-only mode: recorded subscriptions on the topic
+  *count = rmw_introspect::RecordedGraph::instance().count(
+      rmw_introspect::EntityKind::Subscription, topic_name);
   return RMW_RET_OK;
 }
 
@@ -77,20 +178,8 @@ rmw_ret_t rmw_get_node_names(const rmw_node_t *node,
     return g_real_rmw->get_node_names(real_node, node_names, node_namespaces);
   }
 
-  // Recording-only mode: return empty arrays
-  rcutils_allocator_t allocator = rcutils_get_default_allocator();
-  rcutils_ret_t ret = rcutils_string_array_init(node_names, 0, &allocator);
-  if (ret != RCUTILS_RET_OK) {
-    RMW_SET_ERROR_MSG("failed to initialize node_names");
-    return RMW_RET_ERROR;
-  }
-  ret = rcutils_string_array_init(node_namespaces, 0, &allocator);
-  if (ret != RCUTILS_RET_OK) {
-    RMW_SET_ERROR_MSG("failed to initialize node_namespaces");
-    rcutils_string_array_fini(node_names);
-    return RMW_RET_ERROR;
-  }
-  return RMW_RET_OK;
+  // Recording-only mode: the recorded nodes
+  return recorded_node_names(node_names, node_namespaces, nullptr);
 }
 
 rmw_ret_t rmw_get_node_names_with_enclaves(
@@ -114,27 +203,8 @@ rmw_ret_t rmw_get_node_names_with_enclaves(
                                                     node_namespaces, enclaves);
   }
 
-  // Recording-only mode: return empty arrays
-  rcutils_allocator_t allocator = rcutils_get_default_allocator();
-  rcutils_ret_t ret = rcutils_string_array_init(node_names, 0, &allocator);
-  if (ret != RCUTILS_RET_OK) {
-    RMW_SET_ERROR_MSG("failed to initialize node_names");
-    return RMW_RET_ERROR;
-  }
-  ret = rcutils_string_array_init(node_namespaces, 0, &allocator);
-  if (ret != RCUTILS_RET_OK) {
-    RMW_SET_ERROR_MSG("failed to initialize node_namespaces");
-    rcutils_string_array_fini(node_names);
-    return RMW_RET_ERROR;
-  }
-  ret = rcutils_string_array_init(enclaves, 0, &allocator);
-  if (ret != RCUTILS_RET_OK) {
-    RMW_SET_ERROR_MSG("failed to initialize enclaves");
-    rcutils_string_array_fini(node_names);
-    rcutils_string_array_fini(node_namespaces);
-    return RMW_RET_ERROR;
-  }
-  return RMW_RET_OK;
+  // Recording-only mode: the recorded nodes
+  return recorded_node_names(node_names, node_namespaces, enclaves);
 }
 
 rmw_ret_t
@@ -159,8 +229,11 @@ rmw_get_topic_names_and_types(const rmw_node_t *node,
         real_node, allocator, no_demangle, topic_names_and_types);
   }
 
-  // Recording-only mode: return empty list
-  return rmw_names_and_types_init(topic_names_and_types, 0, allocator);
+  // Recording-only mode: topics with a recorded publisher or subscription.
+  // Recorded names are ROS names already, so there is nothing to demangle
+  return to_names_and_types(
+      rmw_introspect::RecordedGraph::instance().topic_names_and_types(),
+      allocator, topic_names_and_types);
 }
 
 rmw_ret_t rmw_get_service_names_and_types(
@@ -184,8 +257,10 @@ rmw_ret_t rmw_get_service_names_and_types(
                                                    service_names_and_types);
   }
 
-  // Recording-only mode: return empty list
-  return rmw_names_and_types_init(service_names_and_types, 0, allocator);
+  // Recording-only mode: services with a recorded server or client
+  return to_names_and_types(
+      rmw_introspect::RecordedGraph::instance().service_names_and_types(),
+      allocator, service_names_and_types);
 }
 
 rmw_ret_t rmw_get_publisher_names_and_types_by_node(
@@ -213,8 +288,10 @@ rmw_ret_t rmw_get_publisher_names_and_types_by_node(
         topic_names_and_types);
   }
 
-  // Recording-only mode: return empty list
-  return rmw_names_and_types_init(topic_names_and_types, 0, allocator);
+  // Recording-only mode: the node's recorded endpoints
+  return recorded_names_and_types_by_node(
+      rmw_introspect::EntityKind::Publisher, node_name, node_namespace,
+      allocator, topic_names_and_types);
 }
 
 rmw_ret_t rmw_get_subscriber_names_and_types_by_node(
@@ -242,8 +319,10 @@ rmw_ret_t rmw_get_subscriber_names_and_types_by_node(
         topic_names_and_types);
   }
 
-  // Recording-only mode: return empty list
-  return rmw_names_and_types_init(topic_names_and_types, 0, allocator);
+  // Recording-only mode: the node's recorded endpoints
+  return recorded_names_and_types_by_node(
+      rmw_introspect::EntityKind::Subscription, node_name, node_namespace,
+      allocator, topic_names_and_types);
 }
 
 rmw_ret_t rmw_get_service_names_and_types_by_node(
@@ -271,8 +350,10 @@ rmw_ret_t rmw_get_service_names_and_types_by_node(
         service_names_and_types);
   }
 
-  // Recording-only mode: return empty list
-  return rmw_names_and_types_init(service_names_and_types, 0, allocator);
+  // Recording-only mode: the node's recorded endpoints
+  return recorded_names_and_types_by_node(
+      rmw_introspect::EntityKind::Service, node_name, node_namespace, allocator,
+      service_names_and_types);
 }
 
 rmw_ret_t rmw_get_client_names_and_types_by_node(
@@ -300,8 +381,10 @@ rmw_ret_t rmw_get_client_names_and_types_by_node(
         service_names_and_types);
   }
 
-  // Recording-only mode: return empty list
-  return rmw_names_and_types_init(service_names_and_types, 0, allocator);
+  // Recording-only mode: the node's recorded endpoints
+  return recorded_names_and_types_by_node(
+      rmw_introspect::EntityKind::Client, node_name, node_namespace, allocator,
+      service_names_and_types);
 }
 
 } // extern "C"
@@ -6,9 +6,14 @@
 #include "rmw/init_options.h"
 #include "rmw/rmw.h"
 #include "rmw_introspect/data.hpp"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
+#include "rmw_introspect/loopback.hpp"
 #include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/quiescence.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/stream_writer.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
 #include <atomic>
@@ -31,6 +36,48 @@ std::atomic<size_t> g_context_count{0};
 } // namespace internal
 } // namespace rmw_introspect
 
+namespace {
+
+/// Whether RMW_INTROSPECT_AUTO_EXPORT leaves exports enabled (the default)
+bool auto_export_enabled() {
+  const char *auto_export_env = std::getenv("RMW_INTROSPECT_AUTO_EXPORT");
+  return !(auto_export_env && std::string(auto_export_env) == "0");
+}
+
+/// Write the introspection output in the RMW_INTROSPECT_FORMAT format, and
+/// the timeline and latency exports when they are enabled
+/// @return false if the main output could not be written
+bool export_outputs(const std::string &output_path) {
+  // Bring the event stream up to date before the final document
+  rmw_introspect::StreamWriter::instance().flush();
+
+  auto &data = rmw_introspect::IntrospectionData::instance();
+  const char *format_env = std::getenv("RMW_INTROSPECT_FORMAT");
+  const std::string format = format_env ? format_env : "json";
+  bool exported;
+  if (format == "binary") {
+    exported = data.export_to_binary(output_path);
+  } else if (format == "yaml") {
+    exported = data.export_to_yaml(output_path);
+  } else if (format == "csv") {
+    exported = data.export_to_csv(output_path);
+  } else {
+    exported = data.export_to_json(output_path);
+  }
+  if (rmw_introspect::timeline_enabled()) {
+    data.export_timeline_to_json(
+        rmw_introspect::timeline_output_path(output_path));
+  }
+
+  auto &latency = rmw_introspect::LatencyRegistry::instance();
+  if (latency.enabled()) {
+    latency.export_to_json(rmw_introspect::latency_output_path(output_path));
+  }
+  return exported;
+}
+
+} // namespace
+
 extern "C" {
 
 // Implementation identifier
@@ -146,6 +193,33 @@ rmw_ret_t rmw_init(const rmw_init_options_t *options, rmw_context_t *context) {
         RCUTILS_LOG_INFO_NAMED("rmw_introspect",
                                "Real RMW loaded successfully: %s", delegate_to);
       }
+
+      // Pick the hot-path implementations once for the whole process
+      rmw_introspect::internal::select_dispatch(
+          rmw_introspect::LatencyRegistry::instance().enabled()
+              ? rmw_introspect::DispatchMode::IntermediateStats
+              : rmw_introspect::DispatchMode::Intermediate);
+    } else if (rmw_introspect::loopback_enabled()) {
+      // Deliver messages between this process's endpoints
+      rmw_introspect::internal::select_dispatch(
+          rmw_introspect::DispatchMode::Loopback);
+    }
+
+    // Stream records to disk as they are created, so a crash loses at most
+    // one writer interval
+    const char *output_path = std::getenv("RMW_INTROSPECT_OUTPUT");
+    if (output_path && rmw_introspect::stream_enabled() &&
+        !rmw_introspect::StreamWriter::instance().running()) {
+      rmw_introspect::start_stream_from_env(output_path);
+    }
+
+    // Export early and tell the supervisor once the node stops creating
+    // entities or the deadline passes, instead of waiting to be shut down
+    if (output_path && auto_export_enabled()) {
+      rmw_introspect::start_quiescence_from_env(
+          [path = std::string(output_path)](rmw_introspect::QuietReason) {
+            return export_outputs(path);
+          });
     }
   }
 
@@ -204,19 +278,14 @@ rmw_ret_t rmw_shutdown(rmw_context_t *context) {
     return RMW_RET_INCORRECT_RMW_IMPLEMENTATION;
   }
 
-  // Check if auto-export is enabled
-  const char *auto_export_env = std::getenv("RMW_INTROSPECT_AUTO_EXPORT");
-  bool auto_export = true; // Default to enabled
-  if (auto_export_env && std::string(auto_export_env) == "0") {
-    auto_export = false;
-  }
+  // The final export supersedes an early one, and a node that never went
+  // quiet sees its ready pipe closed
+  rmw_introspect::QuiescenceMonitor::instance().stop();
 
   // Export introspection data if enabled
-  if (auto_export) {
-    const char *output_path = std::getenv("RMW_INTROSPECT_OUTPUT");
-    if (output_path) {
-      rmw_introspect::IntrospectionData::instance().export_to_json(output_path);
-    }
+  const char *output_path = std::getenv("RMW_INTROSPECT_OUTPUT");
+  if (auto_export_enabled() && output_path) {
+    export_outputs(output_path);
   }
 
   // If in intermediate mode, forward shutdown to real RMW
@@ -263,6 +332,9 @@ rmw_ret_t rmw_context_fini(rmw_context_t *context) {
 
   // Decrement context count and unload real RMW if this is the last context
   --g_context_count;
+  if (g_context_count == 0) {
+    select_dispatch(rmw_introspect::DispatchMode::RecordingOnly);
+  }
   if (g_context_count == 0 && g_real_rmw) {
     delete g_real_rmw;
     g_real_rmw = nullptr;
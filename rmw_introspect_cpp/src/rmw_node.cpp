@@ -7,6 +7,7 @@
 #include "rmw_introspect/identifier.hpp"
 #include "rmw_introspect/mode.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
 #include <cstring>
@@ -16,6 +17,8 @@
 struct rmw_node_impl_t {
   char *name;
   char *namespace_;
+  rmw_introspect::RecordId record_id;
+  rmw_introspect::GraphEntryId graph_id;
 };
 
 extern "C" {
@@ -35,7 +38,9 @@ rmw_node_t *rmw_create_node(rmw_context_t *context, const char *name,
                                    return nullptr);
 
   // Record node in introspection data
-  rmw_introspect::IntrospectionData::instance().record_node(name, namespace_);
+  rmw_introspect::RecordId record_id =
+      rmw_introspect::IntrospectionData::instance().record_node(name,
+                                                               namespace_);
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
@@ -59,6 +64,7 @@ rmw_node_t *rmw_create_node(rmw_context_t *context, const char *name,
       RMW_SET_ERROR_MSG("failed to allocate node wrapper");
       return nullptr;
     }
+    wrapper->record_id = record_id;
 
     // Create our node structure
     rmw_node_t *node = new (std::nothrow) rmw_node_t;
@@ -109,6 +115,9 @@ rmw_node_t *rmw_create_node(rmw_context_t *context, const char *name,
 
   strcpy(impl->name, name);
   strcpy(impl->namespace_, namespace_);
+  impl->record_id = record_id;
+  impl->graph_id =
+      rmw_introspect::RecordedGraph::instance().add_node(name, namespace_);
 
   // Initialize node
   node->implementation_identifier = rmw_introspect_cpp_identifier;
@@ -139,6 +148,10 @@ rmw_ret_t rmw_destroy_node(rmw_node_t *node) {
         return ret;
       }
     }
+    if (wrapper) {
+      rmw_introspect::IntrospectionData::instance().record_destroy(
+          rmw_introspect::EntityKind::Node, wrapper->record_id);
+    }
     delete wrapper;
     delete node;
     return RMW_RET_OK;
@@ -147,6 +160,9 @@ rmw_ret_t rmw_destroy_node(rmw_node_t *node) {
   // Recording-only mode
   auto impl = static_cast<rmw_node_impl_t *>(node->data);
   if (impl) {
+    rmw_introspect::IntrospectionData::instance().record_destroy(
+        rmw_introspect::EntityKind::Node, impl->record_id);
+    rmw_introspect::RecordedGraph::instance().remove(impl->graph_id);
     delete[] impl->name;
     delete[] impl->namespace_;
     delete impl;
@@ -177,9 +193,11 @@ rmw_node_get_graph_guard_condition(const rmw_node_t *node) {
     return g_real_rmw->node_get_graph_guard_condition(real_node);
   }
 
-  // Recording-only mode: return stub
+  // Recording-only mode: one graph guard condition for every node, triggered
+  // by the RecordedGraph on each change and waited on like any other
   static rmw_guard_condition_t stub_guard_condition = {
-      rmw_introspect_cpp_identifier, nullptr};
+      rmw_introspect_cpp_identifier,
+      &rmw_introspect::RecordedGraph::instance().guard_condition(), nullptr};
 
   return &stub_guard_condition;
 }
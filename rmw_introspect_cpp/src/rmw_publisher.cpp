@@ -3,15 +3,20 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 #include "rmw_introspect/data.hpp"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/forwarding.hpp"
+#include "rmw_introspect/handle_pool.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
 #include "rmw_introspect/mode.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
 #include "rmw_introspect/type_support.hpp"
 #include "rmw_introspect/types.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
 #include <chrono>
+#include <memory>
 #include <new>
 
 extern "C" {
@@ -47,7 +52,14 @@ rmw_publisher_t *rmw_create_publisher(
                        std::chrono::system_clock::now().time_since_epoch())
                        .count();
 
-  rmw_introspect::IntrospectionData::instance().record_publisher(info);
+  // Traffic counters are shared between the record and the wrapper so they
+  // outlive the publisher and can be exported at shutdown
+  if (is_intermediate_mode()) {
+    info.stats = std::make_shared<rmw_introspect::PublisherStats>();
+  }
+
+  rmw_introspect::RecordId record_id =
+      rmw_introspect::IntrospectionData::instance().record_publisher(info);
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
@@ -65,26 +77,23 @@ rmw_publisher_t *rmw_create_publisher(
       return nullptr;
     }
 
-    // Create wrapper
-    auto *wrapper = new (std::nothrow) rmw_introspect::PublisherWrapper(
-        real_publisher, topic_name, message_type, *qos_profile);
-    if (!wrapper) {
-      g_real_rmw->destroy_publisher(real_node, real_publisher);
-      RMW_SET_ERROR_MSG("failed to allocate publisher wrapper");
-      return nullptr;
-    }
-
-    // Create our publisher structure
-    rmw_publisher_t *publisher = new (std::nothrow) rmw_publisher_t;
+    // Create our publisher structure and its wrapper in one pooled slot
+    rmw_publisher_t *publisher = publisher_pool().acquire(
+        real_publisher, topic_name, message_type, *qos_profile, info.stats);
     if (!publisher) {
       g_real_rmw->destroy_publisher(real_node, real_publisher);
-      delete wrapper;
       RMW_SET_ERROR_MSG("failed to allocate publisher");
       return nullptr;
     }
+    auto *wrapper =
+        static_cast<rmw_introspect::PublisherWrapper *>(publisher->data);
+    wrapper->publish_latency =
+        rmw_introspect::LatencyRegistry::instance().create(
+            "publish", rmw_introspect::latency_entity_label(
+                           node->namespace_, node->name, topic_name));
+    wrapper->record_id = record_id;
 
     publisher->implementation_identifier = rmw_introspect_cpp_identifier;
-    publisher->data = wrapper;
     publisher->topic_name = real_publisher->topic_name;
     publisher->options = *publisher_options;
     publisher->can_loan_messages = real_publisher->can_loan_messages;
@@ -100,7 +109,26 @@ rmw_publisher_t *rmw_create_publisher(
   }
 
   publisher->implementation_identifier = rmw_introspect_cpp_identifier;
-  publisher->data = nullptr;
+  auto *entity = new (std::nothrow) rmw_introspect::RecordingEntity(record_id);
+  publisher->data = entity;
+  if (!publisher->data) {
+    delete publisher;
+    RMW_SET_ERROR_MSG("failed to allocate publisher data");
+    return nullptr;
+  }
+  if (is_loopback_mode()) {
+    entity->loopback = rmw_introspect::LoopbackBus::instance().attach_publisher(
+        topic_name, type_support, *qos_profile);
+    if (!entity->loopback) {
+      delete entity;
+      delete publisher;
+      RMW_SET_ERROR_MSG("failed to attach publisher to the loopback");
+      return nullptr;
+    }
+  }
+  entity->graph_id = rmw_introspect::RecordedGraph::instance().add_endpoint(
+      rmw_introspect::EntityKind::Publisher, node->name, node->namespace_,
+      topic_name, message_type);
   publisher->topic_name = topic_name;
   publisher->options = *publisher_options;
   publisher->can_loan_messages = false;
@@ -135,12 +163,23 @@ rmw_ret_t rmw_destroy_publisher(rmw_node_t *node, rmw_publisher_t *publisher) {
         return ret;
       }
     }
-    delete wrapper;
-    delete publisher;
+    if (wrapper) {
+      rmw_introspect::IntrospectionData::instance().record_destroy(
+          rmw_introspect::EntityKind::Publisher, wrapper->record_id);
+    }
+    publisher_pool().release(publisher);
     return RMW_RET_OK;
   }
 
   // Recording-only mode
+  auto *entity =
+      static_cast<rmw_introspect::RecordingEntity *>(publisher->data);
+  if (entity) {
+    rmw_introspect::IntrospectionData::instance().record_destroy(
+        rmw_introspect::EntityKind::Publisher, entity->record_id);
+    rmw_introspect::RecordedGraph::instance().remove(entity->graph_id);
+    delete entity;
+  }
   delete publisher;
   return RMW_RET_OK;
 }
@@ -154,18 +193,10 @@ rmw_ret_t rmw_publish(const rmw_publisher_t *publisher, const void *ros_message,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_publisher_t *real_publisher = unwrap_publisher(publisher);
-    if (!real_publisher) {
-      RMW_SET_ERROR_MSG("failed to unwrap publisher");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->publish(real_publisher, ros_message, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(publisher); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  return RMW_RET_OK;
+  return current_dispatch().publish(publisher, ros_message, allocation);
 }
 
 // Publish serialized message
@@ -179,19 +210,12 @@ rmw_ret_t rmw_publish_serialized_message(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_publisher_t *real_publisher = unwrap_publisher(publisher);
-    if (!real_publisher) {
-      RMW_SET_ERROR_MSG("failed to unwrap publisher");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->publish_serialized_message(
-        real_publisher, serialized_message, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(publisher); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  return RMW_RET_OK;
+  return current_dispatch().publish_serialized_message(publisher,
+                                                       serialized_message,
+                                                       allocation);
 }
 
 // Borrow loaned message
@@ -206,19 +230,11 @@ rmw_borrow_loaned_message(const rmw_publisher_t *publisher,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_publisher_t *real_publisher = unwrap_publisher(publisher);
-    if (!real_publisher) {
-      RMW_SET_ERROR_MSG("failed to unwrap publisher");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->borrow_loaned_message(real_publisher, type_support,
-                                             ros_message);
+  if (rmw_ret_t ret = check_dispatch_handle(publisher); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: not supported
-  return RMW_RET_UNSUPPORTED;
+  return current_dispatch().borrow_loaned_message(publisher, type_support,
+                                                  ros_message);
 }
 
 // Return loaned message
@@ -231,19 +247,11 @@ rmw_return_loaned_message_from_publisher(const rmw_publisher_t *publisher,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(loaned_message, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_publisher_t *real_publisher = unwrap_publisher(publisher);
-    if (!real_publisher) {
-      RMW_SET_ERROR_MSG("failed to unwrap publisher");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->return_loaned_message_from_publisher(real_publisher,
-                                                            loaned_message);
+  if (rmw_ret_t ret = check_dispatch_handle(publisher); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: not supported
-  return RMW_RET_UNSUPPORTED;
+  return current_dispatch().return_loaned_message_from_publisher(
+      publisher, loaned_message);
 }
 
 // Get publisher actual QoS
@@ -291,8 +299,9 @@ rmw_publisher_count_matched_subscriptions(const rmw_publisher_t *publisher,
         real_publisher, subscription_count);
   }
 
-  // Recording-only mode: return 0
-  *subscription_count = 0;
+  // Recording-only mode: every recorded subscription on the topic matches
+  *subscription_count = rmw_introspect::RecordedGraph::instance().count(
+      rmw_introspect::EntityKind::Subscription, publisher->topic_name);
   return RMW_RET_OK;
 }
 
@@ -3,15 +3,20 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 #include "rmw_introspect/data.hpp"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/forwarding.hpp"
+#include "rmw_introspect/handle_pool.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
 #include "rmw_introspect/mode.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
 #include "rmw_introspect/type_support.hpp"
 #include "rmw_introspect/types.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
 #include <chrono>
+#include <memory>
 #include <new>
 
 extern "C" {
@@ -46,7 +51,12 @@ rmw_service_t *rmw_create_service(
                        std::chrono::system_clock::now().time_since_epoch())
                        .count();
 
-  rmw_introspect::IntrospectionData::instance().record_service(info);
+  if (is_intermediate_mode()) {
+    info.stats = std::make_shared<rmw_introspect::ServiceStats>();
+  }
+
+  rmw_introspect::RecordId record_id =
+      rmw_introspect::IntrospectionData::instance().record_service(info);
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
@@ -64,26 +74,24 @@ rmw_service_t *rmw_create_service(
       return nullptr;
     }
 
-    // Create wrapper
-    auto *wrapper = new (std::nothrow) rmw_introspect::ServiceWrapper(
-        real_service, service_name, service_type, *qos_profile);
-    if (!wrapper) {
-      g_real_rmw->destroy_service(real_node, real_service);
-      RMW_SET_ERROR_MSG("failed to allocate service wrapper");
-      return nullptr;
-    }
-
-    // Create our service structure
-    rmw_service_t *service = new (std::nothrow) rmw_service_t;
+    // Create our service structure and its wrapper in one pooled slot
+    rmw_service_t *service = service_pool().acquire(
+        real_service, service_name, service_type, *qos_profile,
+        info.stats);
     if (!service) {
       g_real_rmw->destroy_service(real_node, real_service);
-      delete wrapper;
       RMW_SET_ERROR_MSG("failed to allocate service");
       return nullptr;
     }
+    auto *wrapper =
+        static_cast<rmw_introspect::ServiceWrapper *>(service->data);
+    wrapper->send_response_latency =
+        rmw_introspect::LatencyRegistry::instance().create(
+            "send_response", rmw_introspect::latency_entity_label(
+                                 node->namespace_, node->name, service_name));
+    wrapper->record_id = record_id;
 
     service->implementation_identifier = rmw_introspect_cpp_identifier;
-    service->data = wrapper;
     service->service_name = real_service->service_name;
 
     return service;
@@ -97,7 +105,16 @@ rmw_service_t *rmw_create_service(
   }
 
   service->implementation_identifier = rmw_introspect_cpp_identifier;
-  service->data = nullptr;
+  auto *entity = new (std::nothrow) rmw_introspect::RecordingEntity(record_id);
+  service->data = entity;
+  if (!service->data) {
+    delete service;
+    RMW_SET_ERROR_MSG("failed to allocate service data");
+    return nullptr;
+  }
+  entity->graph_id = rmw_introspect::RecordedGraph::instance().add_endpoint(
+      rmw_introspect::EntityKind::Service, node->name, node->namespace_,
+      service_name, service_type);
   service->service_name = service_name;
 
   return service;
@@ -129,12 +146,22 @@ rmw_ret_t rmw_destroy_service(rmw_node_t *node, rmw_service_t *service) {
         return ret;
       }
     }
-    delete wrapper;
-    delete service;
+    if (wrapper) {
+      rmw_introspect::IntrospectionData::instance().record_destroy(
+          rmw_introspect::EntityKind::Service, wrapper->record_id);
+    }
+    service_pool().release(service);
     return RMW_RET_OK;
   }
 
   // Recording-only mode
+  auto *entity = static_cast<rmw_introspect::RecordingEntity *>(service->data);
+  if (entity) {
+    rmw_introspect::IntrospectionData::instance().record_destroy(
+        rmw_introspect::EntityKind::Service, entity->record_id);
+    rmw_introspect::RecordedGraph::instance().remove(entity->graph_id);
+    delete entity;
+  }
   delete service;
   return RMW_RET_OK;
 }
@@ -151,20 +178,11 @@ rmw_ret_t rmw_take_request(const rmw_service_t *service,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_service_t *real_service = unwrap_service(service);
-    if (!real_service) {
-      RMW_SET_ERROR_MSG("failed to unwrap service");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_request(real_service, request_header, ros_request,
-                                    taken);
+  if (rmw_ret_t ret = check_dispatch_handle(service); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  *taken = false;
-  return RMW_RET_OK;
+  return current_dispatch().take_request(service, request_header, ros_request,
+                                         taken);
 }
 
 // Send response
@@ -178,22 +196,14 @@ rmw_ret_t rmw_send_response(const rmw_service_t *service,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_service_t *real_service = unwrap_service(service);
-    if (!real_service) {
-      RMW_SET_ERROR_MSG("failed to unwrap service");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->send_response(real_service, request_header,
-                                     ros_response);
+  if (rmw_ret_t ret = check_dispatch_handle(service); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  return RMW_RET_OK;
+  return current_dispatch().send_response(service, request_header,
+                                          ros_response);
 }
 
-// Service server is available (stub)
+// Service server is available
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t rmw_service_server_is_available(const rmw_node_t *node,
                                           const rmw_client_t *client,
@@ -216,7 +226,10 @@ rmw_ret_t rmw_service_server_is_available(const rmw_node_t *node,
                                                    is_available);
   }
 
-  // Recording-only mode: return false
+  // Recording-only mode: never available. Requests are dropped and no
+  // response ever arrives, even from a server in this process, so a client
+  // that saw the server would block on its first call instead of in its
+  // wait for the server
   *is_available = false;
   return RMW_RET_OK;
 }
@@ -3,15 +3,20 @@
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
 #include "rmw_introspect/data.hpp"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/forwarding.hpp"
+#include "rmw_introspect/handle_pool.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
 #include "rmw_introspect/mode.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recorded_graph.hpp"
 #include "rmw_introspect/type_support.hpp"
 #include "rmw_introspect/types.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
 #include <chrono>
+#include <memory>
 #include <new>
 
 extern "C" {
@@ -47,7 +52,12 @@ rmw_subscription_t *rmw_create_subscription(
                        std::chrono::system_clock::now().time_since_epoch())
                        .count();
 
-  rmw_introspect::IntrospectionData::instance().record_subscription(info);
+  if (is_intermediate_mode()) {
+    info.stats = std::make_shared<rmw_introspect::SubscriptionStats>();
+  }
+
+  rmw_introspect::RecordId record_id =
+      rmw_introspect::IntrospectionData::instance().record_subscription(info);
 
   // Intermediate mode: forward to real RMW
   if (is_intermediate_mode()) {
@@ -65,26 +75,22 @@ rmw_subscription_t *rmw_create_subscription(
       return nullptr;
     }
 
-    // Create wrapper
-    auto *wrapper = new (std::nothrow) rmw_introspect::SubscriptionWrapper(
-        real_subscription, topic_name, message_type, *qos_profile);
-    if (!wrapper) {
-      g_real_rmw->destroy_subscription(real_node, real_subscription);
-      RMW_SET_ERROR_MSG("failed to allocate subscription wrapper");
-      return nullptr;
-    }
-
-    // Create our subscription structure
-    rmw_subscription_t *subscription = new (std::nothrow) rmw_subscription_t;
+    // Create our subscription structure and its wrapper in one pooled slot
+    rmw_subscription_t *subscription = subscription_pool().acquire(
+        real_subscription, topic_name, message_type, *qos_profile, info.stats);
     if (!subscription) {
       g_real_rmw->destroy_subscription(real_node, real_subscription);
-      delete wrapper;
       RMW_SET_ERROR_MSG("failed to allocate subscription");
       return nullptr;
     }
+    auto *wrapper =
+        static_cast<rmw_introspect::SubscriptionWrapper *>(subscription->data);
+    wrapper->take_latency = rmw_introspect::LatencyRegistry::instance().create(
+        "take_with_info", rmw_introspect::latency_entity_label(
+                              node->namespace_, node->name, topic_name));
+    wrapper->record_id = record_id;
 
     subscription->implementation_identifier = rmw_introspect_cpp_identifier;
-    subscription->data = wrapper;
     subscription->topic_name = real_subscription->topic_name;
     subscription->options = *subscription_options;
     subscription->can_loan_messages = real_subscription->can_loan_messages;
@@ -101,7 +107,27 @@ rmw_subscription_t *rmw_create_subscription(
   }
 
   subscription->implementation_identifier = rmw_introspect_cpp_identifier;
-  subscription->data = nullptr;
+  auto *entity = new (std::nothrow) rmw_introspect::RecordingEntity(record_id);
+  subscription->data = entity;
+  if (!subscription->data) {
+    delete subscription;
+    RMW_SET_ERROR_MSG("failed to allocate subscription data");
+    return nullptr;
+  }
+  if (is_loopback_mode()) {
+    entity->loopback =
+        rmw_introspect::LoopbackBus::instance().attach_subscription(
+            topic_name, type_support, *qos_profile);
+    if (!entity->loopback) {
+      delete entity;
+      delete subscription;
+      RMW_SET_ERROR_MSG("failed to attach subscription to the loopback");
+      return nullptr;
+    }
+  }
+  entity->graph_id = rmw_introspect::RecordedGraph::instance().add_endpoint(
+      rmw_introspect::EntityKind::Subscription, node->name, node->namespace_,
+      topic_name, message_type);
   subscription->topic_name = topic_name;
   subscription->options = *subscription_options;
   subscription->can_loan_messages = false;
@@ -138,12 +164,23 @@ rmw_ret_t rmw_destroy_subscription(rmw_node_t *node,
         return ret;
       }
     }
-    delete wrapper;
-    delete subscription;
+    if (wrapper) {
+      rmw_introspect::IntrospectionData::instance().record_destroy(
+          rmw_introspect::EntityKind::Subscription, wrapper->record_id);
+    }
+    subscription_pool().release(subscription);
     return RMW_RET_OK;
   }
 
   // Recording-only mode
+  auto *entity =
+      static_cast<rmw_introspect::RecordingEntity *>(subscription->data);
+  if (entity) {
+    rmw_introspect::IntrospectionData::instance().record_destroy(
+        rmw_introspect::EntityKind::Subscription, entity->record_id);
+    rmw_introspect::RecordedGraph::instance().remove(entity->graph_id);
+    delete entity;
+  }
   delete subscription;
   return RMW_RET_OK;
 }
@@ -158,19 +195,10 @@ rmw_ret_t rmw_take(const rmw_subscription_t *subscription, void *ros_message,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take(real_subscription, ros_message, taken, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  *taken = false;
-  return RMW_RET_OK;
+  return current_dispatch().take(subscription, ros_message, taken, allocation);
 }
 
 // Take message with info
@@ -186,20 +214,11 @@ rmw_ret_t rmw_take_with_info(const rmw_subscription_t *subscription,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_with_info(real_subscription, ros_message, taken,
-                                      message_info, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  *taken = false;
-  return RMW_RET_OK;
+  return current_dispatch().take_with_info(subscription, ros_message, taken,
+                                           message_info, allocation);
 }
 
 // Take serialized message
@@ -215,20 +234,12 @@ rmw_take_serialized_message(const rmw_subscription_t *subscription,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_serialized_message(
-        real_subscription, serialized_message, taken, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  *taken = false;
-  return RMW_RET_OK;
+  return current_dispatch().take_serialized_message(subscription,
+                                                    serialized_message, taken,
+                                                    allocation);
 }
 
 // Take serialized message with info
@@ -245,20 +256,11 @@ rmw_ret_t rmw_take_serialized_message_with_info(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_serialized_message_with_info(
-        real_subscription, serialized_message, taken, message_info, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  *taken = false;
-  return RMW_RET_OK;
+  return current_dispatch().take_serialized_message_with_info(
+      subscription, serialized_message, taken, message_info, allocation);
 }
 
 // Take loaned message
@@ -272,20 +274,11 @@ rmw_ret_t rmw_take_loaned_message(const rmw_subscription_t *subscription,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(loaned_message, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_loaned_message(real_subscription, loaned_message,
-                                           taken, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: not supported
-  *taken = false;
-  return RMW_RET_UNSUPPORTED;
+  return current_dispatch().take_loaned_message(subscription, loaned_message,
+                                                taken, allocation);
 }
 
 // Take loaned message with info
@@ -302,20 +295,11 @@ rmw_take_loaned_message_with_info(const rmw_subscription_t *subscription,
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->take_loaned_message_with_info(
-        real_subscription, loaned_message, taken, message_info, allocation);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: not supported
-  *taken = false;
-  return RMW_RET_UNSUPPORTED;
+  return current_dispatch().take_loaned_message_with_info(
+      subscription, loaned_message, taken, message_info, allocation);
 }
 
 // Return loaned message
@@ -327,19 +311,11 @@ rmw_ret_t rmw_return_loaned_message_from_subscription(
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(loaned_message, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_subscription_t *real_subscription = unwrap_subscription(subscription);
-    if (!real_subscription) {
-      RMW_SET_ERROR_MSG("failed to unwrap subscription");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->return_loaned_message_from_subscription(
-        real_subscription, loaned_message);
+  if (rmw_ret_t ret = check_dispatch_handle(subscription); ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: not supported
-  return RMW_RET_UNSUPPORTED;
+  return current_dispatch().return_loaned_message_from_subscription(
+      subscription, loaned_message);
 }
 
 // Get subscription actual QoS
@@ -387,8 +363,9 @@ rmw_ret_t rmw_subscription_count_matched_publishers(
                                                              publisher_count);
   }
 
-  // Recording-only mode: return 0
-  *publisher_count = 0;
+  // Recording-only mode: every recorded publisher on the topic matches
+  *publisher_count = rmw_introspect::RecordedGraph::instance().count(
+      rmw_introspect::EntityKind::Publisher, subscription->topic_name);
   return RMW_RET_OK;
 }
 
@@ -1,15 +1,21 @@
+#include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
 #include "rmw/error_handling.h"
 #include "rmw/impl/cpp/macros.hpp"
 #include "rmw/rmw.h"
+#include "rmw_introspect/dispatch.hpp"
 #include "rmw_introspect/forwarding.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/latency_histogram.hpp"
 #include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/quiescence.hpp"
 #include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/recording_wait.hpp"
 #include "rmw_introspect/visibility_control.h"
 #include "rmw_introspect/wrappers.hpp"
+#include <atomic>
 #include <new>
-#include <vector>
+#include <string>
 
 extern "C" {
 
@@ -42,14 +48,21 @@ rmw_wait_set_t *rmw_create_wait_set(rmw_context_t *context,
     }
 
     // Create wrapper
-    auto *wrapper =
-        new (std::nothrow) rmw_introspect::WaitSetWrapper(real_wait_set);
+    auto *wrapper = new (std::nothrow)
+        rmw_introspect::WaitSetWrapper(real_wait_set, max_conditions);
     if (!wrapper) {
       g_real_rmw->destroy_wait_set(real_wait_set);
       RMW_SET_ERROR_MSG("failed to allocate wait set wrapper");
       return nullptr;
     }
 
+    auto &latency = rmw_introspect::LatencyRegistry::instance();
+    if (latency.enabled()) {
+      static std::atomic<uint64_t> wait_set_count{0};
+      wrapper->wait_latency = latency.create(
+          "wait", "wait_set_" + std::to_string(wait_set_count.fetch_add(1)));
+    }
+
     // Create our wait set structure
     rmw_wait_set_t *wait_set = new (std::nothrow) rmw_wait_set_t;
     if (!wait_set) {
@@ -99,6 +112,13 @@ rmw_ret_t rmw_destroy_wait_set(rmw_wait_set_t *wait_set) {
         return ret;
       }
     }
+    if (wrapper) {
+      RCUTILS_LOG_DEBUG_NAMED(
+          "rmw_introspect",
+          "wait set scratch: %llu allocations avoided, %llu grows",
+          static_cast<unsigned long long>(wrapper->allocations_avoided.load()),
+          static_cast<unsigned long long>(wrapper->scratch_grows.load()));
+    }
     delete wrapper;
     delete wait_set;
     return RMW_RET_OK;
@@ -109,7 +129,7 @@ rmw_ret_t rmw_destroy_wait_set(rmw_wait_set_t *wait_set) {
   return RMW_RET_OK;
 }
 
-// Wait - unwrap all handles and forward to real RMW
+// Wait
 RMW_INTROSPECT_PUBLIC
 rmw_ret_t rmw_wait(rmw_subscriptions_t *subscriptions,
                    rmw_guard_conditions_t *guard_conditions,
@@ -119,130 +139,23 @@ rmw_ret_t rmw_wait(rmw_subscriptions_t *subscriptions,
   using namespace rmw_introspect::internal;
 
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_INVALID_ARGUMENT);
-
-  // Intermediate mode: unwrap all handles and forward
   if (is_intermediate_mode()) {
-    rmw_wait_set_t *real_wait_set = unwrap_wait_set(wait_set);
-    if (!real_wait_set) {
-      RMW_SET_ERROR_MSG("failed to unwrap wait set");
-      return RMW_RET_ERROR;
-    }
-
-    // Unwrap subscriptions array
-    std::vector<void *> real_subs_storage;
-    rmw_subscriptions_t real_subscriptions;
-    if (subscriptions && subscriptions->subscriber_count > 0) {
-      real_subs_storage.resize(subscriptions->subscriber_count);
-      for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
-        real_subs_storage[i] = unwrap_subscription(
-            static_cast<rmw_subscription_t *>(subscriptions->subscribers[i]));
-      }
-      real_subscriptions.subscriber_count = subscriptions->subscriber_count;
-      real_subscriptions.subscribers = real_subs_storage.data();
-    } else {
-      real_subscriptions.subscriber_count = 0;
-      real_subscriptions.subscribers = nullptr;
-    }
-
-    // Unwrap guard conditions array
-    std::vector<void *> real_gcs_storage;
-    rmw_guard_conditions_t real_guard_conditions;
-    if (guard_conditions && guard_conditions->guard_condition_count > 0) {
-      real_gcs_storage.resize(guard_conditions->guard_condition_count);
-      for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
-        real_gcs_storage[i] =
-            unwrap_guard_condition(static_cast<rmw_guard_condition_t *>(
-                guard_conditions->guard_conditions[i]));
-      }
-      real_guard_conditions.guard_condition_count =
-          guard_conditions->guard_condition_count;
-      real_guard_conditions.guard_conditions = real_gcs_storage.data();
-    } else {
-      real_guard_conditions.guard_condition_count = 0;
-      real_guard_conditions.guard_conditions = nullptr;
-    }
-
-    // Unwrap services array
-    std::vector<void *> real_srvs_storage;
-    rmw_services_t real_services;
-    if (services && services->service_count > 0) {
-      real_srvs_storage.resize(services->service_count);
-      for (size_t i = 0; i < services->service_count; ++i) {
-        real_srvs_storage[i] =
-            unwrap_service(static_cast<rmw_service_t *>(services->services[i]));
-      }
-      real_services.service_count = services->service_count;
-      real_services.services = real_srvs_storage.data();
-    } else {
-      real_services.service_count = 0;
-      real_services.services = nullptr;
-    }
-
-    // Unwrap clients array
-    std::vector<void *> real_clients_storage;
-    rmw_clients_t real_clients;
-    if (clients && clients->client_count > 0) {
-      real_clients_storage.resize(clients->client_count);
-      for (size_t i = 0; i < clients->client_count; ++i) {
-        real_clients_storage[i] =
-            unwrap_client(static_cast<rmw_client_t *>(clients->clients[i]));
-      }
-      real_clients.client_count = clients->client_count;
-      real_clients.clients = real_clients_storage.data();
-    } else {
-      real_clients.client_count = 0;
-      real_clients.clients = nullptr;
+    if (rmw_ret_t ret = check_dispatch_handle(wait_set); ret != RMW_RET_OK) {
+      return ret;
     }
-
-    // Events are passed through as-is (they don't have wrappers in our
-    // implementation)
-    rmw_events_t *real_events = events;
-
-    // Call real RMW wait
-    rmw_ret_t ret = g_real_rmw->wait(
-        subscriptions ? &real_subscriptions : nullptr,
-        guard_conditions ? &real_guard_conditions : nullptr,
-        services ? &real_services : nullptr, clients ? &real_clients : nullptr,
-        real_events, real_wait_set, wait_timeout);
-
-    // Update ready flags in original arrays based on real arrays
-    if (ret == RMW_RET_OK) {
-      if (subscriptions && subscriptions->subscriber_count > 0) {
-        for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
-          subscriptions->subscribers[i] = real_subscriptions.subscribers[i]
-                                              ? subscriptions->subscribers[i]
-                                              : nullptr;
-        }
-      }
-      if (guard_conditions && guard_conditions->guard_condition_count > 0) {
-        for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
-          guard_conditions->guard_conditions[i] =
-              real_guard_conditions.guard_conditions[i]
-                  ? guard_conditions->guard_conditions[i]
-                  : nullptr;
-        }
-      }
-      if (services && services->service_count > 0) {
-        for (size_t i = 0; i < services->service_count; ++i) {
-          services->services[i] =
-              real_services.services[i] ? services->services[i] : nullptr;
-        }
-      }
-      if (clients && clients->client_count > 0) {
-        for (size_t i = 0; i < clients->client_count; ++i) {
-          clients->clients[i] =
-              real_clients.clients[i] ? clients->clients[i] : nullptr;
-        }
-      }
-    }
-
-    return ret;
+  } else {
+    // Recording-only wait sets carry no data
+    RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+        wait_set, wait_set->implementation_identifier,
+        rmw_introspect_cpp_identifier,
+        return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
   }
 
-  // Recording-only mode: Immediately return timeout to allow nodes to exit
-  // gracefully This is critical for introspection - we don't actually wait for
-  // events
-  return RMW_RET_TIMEOUT;
+  // A waiting node has finished setting up; starts the quiescence window
+  rmw_introspect::QuiescenceMonitor::instance().notify_wait();
+
+  return current_dispatch().wait(subscriptions, guard_conditions, services,
+                                 clients, events, wait_set, wait_timeout);
 }
 
 // Create guard condition
@@ -298,16 +211,19 @@ rmw_guard_condition_t *rmw_create_guard_condition(rmw_context_t *context) {
     return guard_condition;
   }
 
-  // Recording-only mode (existing behavior)
+  // Recording-only mode: a flag rmw_wait checks
+  auto *data = new (std::nothrow) rmw_introspect::RecordingGuardCondition;
   rmw_guard_condition_t *guard_condition =
       new (std::nothrow) rmw_guard_condition_t;
-  if (!guard_condition) {
+  if (!data || !guard_condition) {
+    delete data;
+    delete guard_condition;
     RMW_SET_ERROR_MSG("failed to allocate guard condition");
     return nullptr;
   }
 
   guard_condition->implementation_identifier = rmw_introspect_cpp_identifier;
-  guard_condition->data = nullptr;
+  guard_condition->data = data;
   guard_condition->context = context;
 
   return guard_condition;
@@ -341,6 +257,8 @@ rmw_ret_t rmw_destroy_guard_condition(rmw_guard_condition_t *guard_condition) {
   }
 
   // Recording-only mode
+  delete static_cast<rmw_introspect::RecordingGuardCondition *>(
+      guard_condition->data);
   delete guard_condition;
   return RMW_RET_OK;
 }
@@ -353,19 +271,11 @@ rmw_trigger_guard_condition(const rmw_guard_condition_t *guard_condition) {
 
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(guard_condition, RMW_RET_INVALID_ARGUMENT);
 
-  // Intermediate mode: forward to real RMW
-  if (is_intermediate_mode()) {
-    rmw_guard_condition_t *real_guard_condition =
-        unwrap_guard_condition(guard_condition);
-    if (!real_guard_condition) {
-      RMW_SET_ERROR_MSG("failed to unwrap guard condition");
-      return RMW_RET_ERROR;
-    }
-    return g_real_rmw->trigger_guard_condition(real_guard_condition);
+  if (rmw_ret_t ret = check_dispatch_handle(guard_condition);
+      ret != RMW_RET_OK) {
+    return ret;
   }
-
-  // Recording-only mode: no-op
-  return RMW_RET_OK;
+  return current_dispatch().trigger_guard_condition(guard_condition);
 }
 
 } // extern "C"
@@ -0,0 +1,17 @@
+#include "rmw_introspect/segmented_log.hpp"
+
+namespace rmw_introspect {
+
+uint64_t next_record_sequence() {
+  static std::atomic<uint64_t> sequence{0};
+  return sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+size_t record_shard(size_t shard_count) {
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed);
+  return shard % shard_count;
+}
+
+} // namespace rmw_introspect
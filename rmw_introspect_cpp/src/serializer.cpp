@@ -0,0 +1,451 @@
+#include "rmw_introspect/serializer.hpp"
+#include <atomic>
+#include <cstdio>
+#include <string_view>
+#include <type_traits>
+
+namespace rmw_introspect {
+
+namespace {
+
+/// Worst-case bytes for one exported endpoint, excluding its names
+constexpr size_t kEndpointBytes = 320;
+constexpr size_t kStatsBytes = 900;
+
+template <typename Info>
+size_t estimate_endpoint_bytes(const std::vector<Info> &infos) {
+  size_t bytes = 0;
+  for (const auto &info : infos) {
+    bytes += kEndpointBytes + info.node_name.str().size() +
+             info.node_namespace.str().size();
+    bytes += info.stats ? kStatsBytes : 0;
+  }
+  return bytes;
+}
+
+EndpointView make_view(const PublisherInfo &pub) {
+  return {EntityKind::Publisher, pub.node_name, pub.node_namespace,
+          pub.topic_name, pub.message_type, &pub.qos, pub.timestamp,
+          pub.stats.get(), nullptr, nullptr, nullptr};
+}
+
+EndpointView make_view(const SubscriptionInfo &sub) {
+  return {EntityKind::Subscription, sub.node_name, sub.node_namespace,
+          sub.topic_name, sub.message_type, &sub.qos, sub.timestamp,
+          nullptr, sub.stats.get(), nullptr, nullptr};
+}
+
+EndpointView make_view(const ServiceInfo &srv) {
+  return {EntityKind::Service, srv.node_name, srv.node_namespace,
+          srv.service_name, srv.service_type, &srv.qos, srv.timestamp,
+          nullptr, nullptr, srv.stats.get(), nullptr};
+}
+
+EndpointView make_view(const ClientInfo &cli) {
+  return {EntityKind::Client, cli.node_name, cli.node_namespace,
+          cli.service_name, cli.service_type, &cli.qos, cli.timestamp,
+          nullptr, nullptr, nullptr, cli.stats.get()};
+}
+
+template <typename Info>
+void serialize_endpoints(EntityKind kind, const std::vector<Info> &infos,
+                         std::initializer_list<ExportSink *> sinks) {
+  for (ExportSink *sink : sinks) {
+    sink->begin_section(kind);
+  }
+  for (const auto &info : infos) {
+    const EndpointView view = make_view(info);
+    for (ExportSink *sink : sinks) {
+      sink->endpoint(view);
+    }
+  }
+  for (ExportSink *sink : sinks) {
+    sink->end_section(kind);
+  }
+}
+
+bool is_service_kind(EntityKind kind) {
+  return kind == EntityKind::Service || kind == EntityKind::Client;
+}
+
+/// Write CallbackStats as the "callbacks" member of an open stats object
+template <typename Writer>
+void write_callback_stats(Writer &out, const CallbackStats &cb) {
+  out.key("callbacks");
+  out.begin_object();
+  out.member("invocations", cb.invocations.load(std::memory_order_relaxed));
+  out.member("events", cb.events.load(std::memory_order_relaxed));
+  out.member("take_delay_samples",
+             cb.take_delay_samples.load(std::memory_order_relaxed));
+  out.member("take_delay_total_ns",
+             cb.take_delay_total_ns.load(std::memory_order_relaxed));
+  out.member("take_delay_max_ns",
+             cb.take_delay_max_ns.load(std::memory_order_relaxed));
+  out.end_object();
+}
+
+/// Write QoSEventStats as the "qos_events" member of an open stats object
+template <typename Writer>
+void write_qos_event_stats(Writer &out, const QoSEventStats &ev) {
+  out.key("qos_events");
+  out.begin_object();
+  out.member("deadline_missed",
+             ev.deadline_missed.load(std::memory_order_relaxed));
+  out.member("liveliness_lost",
+             ev.liveliness_lost.load(std::memory_order_relaxed));
+  out.member("messages_lost", ev.messages_lost.load(std::memory_order_relaxed));
+  out.member("incompatible_qos",
+             ev.incompatible_qos.load(std::memory_order_relaxed));
+  out.end_object();
+}
+
+template <typename Writer>
+void write_stats(Writer &out, const EndpointView &endpoint) {
+  if (const auto *st = endpoint.publisher_stats) {
+    out.member("messages", st->messages.load(std::memory_order_relaxed));
+    out.member("serialized_bytes",
+               st->serialized_bytes.load(std::memory_order_relaxed));
+    out.member("errors", st->errors.load(std::memory_order_relaxed));
+    out.member("first_publish_ns",
+               st->first_publish_ns.load(std::memory_order_relaxed));
+    out.member("last_publish_ns",
+               st->last_publish_ns.load(std::memory_order_relaxed));
+    out.member("loans_borrowed",
+               st->loans_borrowed.load(std::memory_order_relaxed));
+    out.member("loans_published",
+               st->loans_published.load(std::memory_order_relaxed));
+    out.member("loans_returned",
+               st->loans_returned.load(std::memory_order_relaxed));
+    write_qos_event_stats(out, st->qos_events);
+  } else if (const auto *st = endpoint.subscription_stats) {
+    out.member("loans_taken", st->loans_taken.load(std::memory_order_relaxed));
+    out.member("loans_returned",
+               st->loans_returned.load(std::memory_order_relaxed));
+    write_callback_stats(out, st->callbacks);
+    write_qos_event_stats(out, st->qos_events);
+  } else if (const auto *st = endpoint.service_stats) {
+    write_callback_stats(out, st->callbacks);
+  } else if (const auto *st = endpoint.client_stats) {
+    write_callback_stats(out, st->callbacks);
+  }
+}
+
+bool has_stats(const EndpointView &endpoint) {
+  return endpoint.publisher_stats || endpoint.subscription_stats ||
+         endpoint.service_stats || endpoint.client_stats;
+}
+
+// CSV
+
+void write_csv_field(OutputBuffer &out, std::string_view field) {
+  size_t special = 0;
+  while (special < field.size() && field[special] != ',' &&
+         field[special] != '"' && field[special] != '\n' &&
+         field[special] != '\r') {
+    ++special;
+  }
+  if (special == field.size()) {
+    out.write(field);
+    return;
+  }
+  out.put('"');
+  size_t run_start = 0;
+  for (size_t i = special; i < field.size(); ++i) {
+    if (field[i] == '"') {
+      out.write(field.data() + run_start, i + 1 - run_start);
+      run_start = i; // Doubles the quote
+    }
+  }
+  out.write(field.data() + run_start, field.size() - run_start);
+  out.put('"');
+}
+
+constexpr const char *kCsvEndpointColumns =
+    "node_name,node_namespace,%s,%s,reliability,durability,history,depth,"
+    "timestamp";
+
+constexpr std::string_view kCsvPublisherStats =
+    ",messages,serialized_bytes,errors,first_publish_ns,last_publish_ns,"
+    "loans_borrowed,loans_published,loans_returned,deadline_missed,"
+    "liveliness_lost,messages_lost,incompatible_qos";
+constexpr std::string_view kCsvSubscriptionStats =
+    ",loans_taken,loans_returned,callback_invocations,callback_events,"
+    "take_delay_samples,take_delay_total_ns,take_delay_max_ns,"
+    "deadline_missed,liveliness_lost,messages_lost,incompatible_qos";
+constexpr std::string_view kCsvCallbackStats =
+    ",callback_invocations,callback_events,take_delay_samples,"
+    "take_delay_total_ns,take_delay_max_ns";
+
+std::string_view csv_stats_columns(EntityKind kind) {
+  switch (kind) {
+  case EntityKind::Publisher:
+    return kCsvPublisherStats;
+  case EntityKind::Subscription:
+    return kCsvSubscriptionStats;
+  case EntityKind::Service:
+  case EntityKind::Client:
+    return kCsvCallbackStats;
+  default:
+    return {};
+  }
+}
+
+template <typename T>
+void write_csv_counter(OutputBuffer &out, const std::atomic<T> &counter) {
+  out.put(',');
+  if constexpr (std::is_signed_v<T>) {
+    out.write_signed(counter.load(std::memory_order_relaxed));
+  } else {
+    out.write_unsigned(counter.load(std::memory_order_relaxed));
+  }
+}
+
+void write_csv_callback_stats(OutputBuffer &out, const CallbackStats &cb) {
+  write_csv_counter(out, cb.invocations);
+  write_csv_counter(out, cb.events);
+  write_csv_counter(out, cb.take_delay_samples);
+  write_csv_counter(out, cb.take_delay_total_ns);
+  write_csv_counter(out, cb.take_delay_max_ns);
+}
+
+void write_csv_qos_event_stats(OutputBuffer &out, const QoSEventStats &ev) {
+  write_csv_counter(out, ev.deadline_missed);
+  write_csv_counter(out, ev.liveliness_lost);
+  write_csv_counter(out, ev.messages_lost);
+  write_csv_counter(out, ev.incompatible_qos);
+}
+
+} // namespace
+
+void serialize(const IntrospectionSnapshot &snapshot,
+               const ExportHeader &header,
+               std::initializer_list<ExportSink *> sinks) {
+  for (ExportSink *sink : sinks) {
+    sink->begin(header);
+    sink->begin_section(EntityKind::Node);
+  }
+  for (const auto &node : snapshot.nodes) {
+    for (ExportSink *sink : sinks) {
+      sink->node(node);
+    }
+  }
+  for (ExportSink *sink : sinks) {
+    sink->end_section(EntityKind::Node);
+  }
+
+  serialize_endpoints(EntityKind::Publisher, snapshot.publishers, sinks);
+  serialize_endpoints(EntityKind::Subscription, snapshot.subscriptions, sinks);
+  serialize_endpoints(EntityKind::Service, snapshot.services, sinks);
+  serialize_endpoints(EntityKind::Client, snapshot.clients, sinks);
+
+  for (ExportSink *sink : sinks) {
+    sink->end();
+  }
+}
+
+const char *section_name(EntityKind kind) {
+  switch (kind) {
+  case EntityKind::Node:
+    return "nodes";
+  case EntityKind::Publisher:
+    return "publishers";
+  case EntityKind::Subscription:
+    return "subscriptions";
+  case EntityKind::Service:
+    return "services";
+  case EntityKind::Client:
+    return "clients";
+  default:
+    return "unknown";
+  }
+}
+
+size_t estimate_export_bytes(const IntrospectionSnapshot &snapshot) {
+  size_t bytes = 512;
+  for (const auto &node : snapshot.nodes) {
+    bytes += 8 + node.str().size();
+  }
+  for (const auto &pub : snapshot.publishers) {
+    bytes += pub.topic_name.str().size() + pub.message_type.str().size();
+  }
+  for (const auto &sub : snapshot.subscriptions) {
+    bytes += sub.topic_name.str().size() + sub.message_type.str().size();
+  }
+  for (const auto &srv : snapshot.services) {
+    bytes += srv.service_name.str().size() + srv.service_type.str().size();
+  }
+  for (const auto &cli : snapshot.clients) {
+    bytes += cli.service_name.str().size() + cli.service_type.str().size();
+  }
+  return bytes + estimate_endpoint_bytes(snapshot.publishers) +
+         estimate_endpoint_bytes(snapshot.subscriptions) +
+         estimate_endpoint_bytes(snapshot.services) +
+         estimate_endpoint_bytes(snapshot.clients);
+}
+
+// DocumentSink
+
+template <typename Writer>
+void DocumentSink<Writer>::begin(const ExportHeader &header) {
+  writer_.begin_object();
+  writer_.member("format_version", header.format_version);
+  writer_.member("timestamp", header.timestamp);
+  writer_.member("rmw_implementation", header.rmw_implementation);
+}
+
+template <typename Writer>
+void DocumentSink<Writer>::begin_section(EntityKind kind) {
+  writer_.key(section_name(kind));
+  writer_.begin_array();
+}
+
+template <typename Writer>
+void DocumentSink<Writer>::node(InternedString name) {
+  writer_.value(name);
+}
+
+template <typename Writer>
+void DocumentSink<Writer>::endpoint(const EndpointView &endpoint) {
+  const bool service = is_service_kind(endpoint.kind);
+  writer_.begin_object();
+  writer_.member("node_name", endpoint.node_name);
+  writer_.member("node_namespace", endpoint.node_namespace);
+  writer_.member(service ? "service_name" : "topic_name", endpoint.name);
+  writer_.member(service ? "service_type" : "message_type", endpoint.type);
+  writer_.key("qos");
+  writer_.begin_object();
+  writer_.member("reliability", to_string(endpoint.qos->reliability));
+  writer_.member("durability", to_string(endpoint.qos->durability));
+  writer_.member("history", to_string(endpoint.qos->history));
+  writer_.member("depth", endpoint.qos->depth);
+  writer_.end_object();
+  writer_.member("timestamp", endpoint.timestamp);
+  if (has_stats(endpoint)) {
+    writer_.key("stats");
+    writer_.begin_object();
+    write_stats(writer_, endpoint);
+    writer_.end_object();
+  }
+  writer_.end_object();
+}
+
+template <typename Writer>
+void DocumentSink<Writer>::end_section(EntityKind /*kind*/) {
+  writer_.end_array();
+}
+
+template <typename Writer> void DocumentSink<Writer>::end() {
+  writer_.end_object();
+}
+
+template class DocumentSink<JsonWriter>;
+template class DocumentSink<YamlWriter>;
+
+// CsvSink
+
+CsvSink::CsvSink(OutputBuffer *const (&outputs)[kEntityKindCount]) {
+  for (size_t i = 0; i < kEntityKindCount; ++i) {
+    outputs_[i] = outputs[i];
+  }
+}
+
+void CsvSink::begin(const ExportHeader & /*header*/) {}
+
+void CsvSink::begin_section(EntityKind kind) {
+  OutputBuffer *out = outputs_[static_cast<size_t>(kind)];
+  if (!out) {
+    return;
+  }
+  if (kind == EntityKind::Node) {
+    out->write("name\n");
+    return;
+  }
+  const bool service = is_service_kind(kind);
+  char columns[160];
+  int length = std::snprintf(columns, sizeof(columns), kCsvEndpointColumns,
+                             service ? "service_name" : "topic_name",
+                             service ? "service_type" : "message_type");
+  out->write(columns, static_cast<size_t>(length));
+  out->write(csv_stats_columns(kind));
+  out->put('\n');
+}
+
+void CsvSink::node(InternedString name) {
+  OutputBuffer *out = outputs_[static_cast<size_t>(EntityKind::Node)];
+  if (!out) {
+    return;
+  }
+  write_csv_field(*out, name.str());
+  out->put('\n');
+}
+
+void CsvSink::endpoint(const EndpointView &endpoint) {
+  OutputBuffer *out = outputs_[static_cast<size_t>(endpoint.kind)];
+  if (!out) {
+    return;
+  }
+  write_csv_field(*out, endpoint.node_name.str());
+  out->put(',');
+  write_csv_field(*out, endpoint.node_namespace.str());
+  out->put(',');
+  write_csv_field(*out, endpoint.name.str());
+  out->put(',');
+  write_csv_field(*out, endpoint.type.str());
+  out->put(',');
+  out->write(to_string(endpoint.qos->reliability));
+  out->put(',');
+  out->write(to_string(endpoint.qos->durability));
+  out->put(',');
+  out->write(to_string(endpoint.qos->history));
+  out->put(',');
+  out->write_unsigned(endpoint.qos->depth);
+  out->put(',');
+  out->write_double(endpoint.timestamp);
+
+  if (const auto *st = endpoint.publisher_stats) {
+    write_csv_counter(*out, st->messages);
+    write_csv_counter(*out, st->serialized_bytes);
+    write_csv_counter(*out, st->errors);
+    write_csv_counter(*out, st->first_publish_ns);
+    write_csv_counter(*out, st->last_publish_ns);
+    write_csv_counter(*out, st->loans_borrowed);
+    write_csv_counter(*out, st->loans_published);
+    write_csv_counter(*out, st->loans_returned);
+    write_csv_qos_event_stats(*out, st->qos_events);
+  } else if (const auto *st = endpoint.subscription_stats) {
+    write_csv_counter(*out, st->loans_taken);
+    write_csv_counter(*out, st->loans_returned);
+    write_csv_callback_stats(*out, st->callbacks);
+    write_csv_qos_event_stats(*out, st->qos_events);
+  } else if (const auto *st = endpoint.service_stats) {
+    write_csv_callback_stats(*out, st->callbacks);
+  } else if (const auto *st = endpoint.client_stats) {
+    write_csv_callback_stats(*out, st->callbacks);
+  } else {
+    // Recording-only mode: one empty field per stats column
+    const std::string_view columns = csv_stats_columns(endpoint.kind);
+    for (char c : columns) {
+      if (c == ',') {
+        out->put(',');
+      }
+    }
+  }
+  out->put('\n');
+}
+
+void CsvSink::end_section(EntityKind /*kind*/) {}
+
+void CsvSink::end() {}
+
+std::string csv_output_path(const std::string &output_path, EntityKind kind) {
+  const std::string suffix = ".json";
+  std::string stem = output_path;
+  if (output_path.size() > suffix.size() &&
+      output_path.compare(output_path.size() - suffix.size(), suffix.size(),
+                          suffix) == 0) {
+    stem = output_path.substr(0, output_path.size() - suffix.size());
+  }
+  return stem + "." + section_name(kind) + ".csv";
+}
+
+} // namespace rmw_introspect
@@ -0,0 +1,201 @@
+#include "rmw_introspect/stream_writer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+namespace rmw_introspect {
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultInterval{200};
+constexpr size_t kDefaultBufferBytes = 64 * 1024;
+// Rough size of one event line, to turn the buffer size into a record count
+constexpr size_t kEventBytes = 256;
+
+/// Parse a positive integer from the environment, `fallback` if unset
+size_t env_size(const char *name, size_t fallback) {
+  const char *env = std::getenv(name);
+  if (!env || !*env) {
+    return fallback;
+  }
+  char *end = nullptr;
+  unsigned long long value = std::strtoull(env, &end, 10);
+  if (*end != '\0' || value == 0) {
+    return fallback;
+  }
+  return static_cast<size_t>(value);
+}
+
+/// write(2) all of `data`, retrying short writes and EINTR
+bool write_all(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+} // namespace
+
+StreamWriter &StreamWriter::instance() {
+  static StreamWriter instance;
+  return instance;
+}
+
+StreamWriter::StreamWriter()
+    : stop_(false), drain_requested_(false), fd_(-1),
+      interval_(kDefaultInterval), buffer_bytes_(kDefaultBufferBytes),
+      drain_changes_(kDefaultBufferBytes / kEventBytes) {
+  // Construct the data singleton first so it is destroyed after us, and the
+  // final flush in our destructor can still read it
+  IntrospectionData::instance();
+}
+
+StreamWriter::~StreamWriter() { stop(); }
+
+bool StreamWriter::start(const std::string &path,
+                         std::chrono::milliseconds interval,
+                         size_t buffer_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_.joinable()) {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> write_lock(write_mutex_);
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND |
+                                   O_CLOEXEC,
+                 0644);
+    if (fd_ < 0) {
+      return false;
+    }
+    interval_ = interval;
+    buffer_bytes_ = buffer_bytes;
+    drain_changes_ = std::max<size_t>(buffer_bytes / kEventBytes, 1);
+    cursor_ = IntrospectionData::StreamCursor();
+
+    std::ostringstream header;
+    header << "{\"event\":\"header\",\"format_version\":\"1.0\","
+           << "\"rmw_implementation\":\"rmw_introspect_cpp\",\"pid\":"
+           << ::getpid() << "}\n";
+    buffer_ = header.str();
+    write_buffer_locked();
+    auto &data = IntrospectionData::instance();
+    data.notify_at_change(data.change_count() + drain_changes_,
+                          &StreamWriter::on_changes);
+  }
+
+  stop_ = false;
+  drain_requested_ = false;
+  thread_ = std::thread(&StreamWriter::run, this);
+  return true;
+}
+
+void StreamWriter::flush() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  drain_locked();
+}
+
+void StreamWriter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable()) {
+      return;
+    }
+    stop_ = true;
+  }
+  wake_.notify_all();
+  thread_.join();
+
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  drain_locked();
+  IntrospectionData::instance().notify_at_change(0, nullptr);
+  ::close(fd_);
+  fd_ = -1;
+}
+
+bool StreamWriter::running() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return thread_.joinable();
+}
+
+void StreamWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    wake_.wait_for(lock, interval_,
+                   [this]() { return stop_ || drain_requested_; });
+    drain_requested_ = false;
+    lock.unlock();
+    flush();
+    lock.lock();
+  }
+}
+
+void StreamWriter::on_changes() {
+  auto &writer = instance();
+  {
+    std::lock_guard<std::mutex> lock(writer.mutex_);
+    writer.drain_requested_ = true;
+  }
+  writer.wake_.notify_one();
+}
+
+void StreamWriter::drain_locked() {
+  if (fd_ < 0) {
+    return;
+  }
+  auto &data = IntrospectionData::instance();
+  // Changes made while draining may already be written, so the next drain
+  // can come a little early but never late
+  data.notify_at_change(data.change_count() + drain_changes_,
+                        &StreamWriter::on_changes);
+  bool done;
+  do {
+    done = data.append_stream_events(cursor_, buffer_, buffer_bytes_);
+    write_buffer_locked();
+  } while (!done);
+}
+
+void StreamWriter::write_buffer_locked() {
+  // A failed write drops the batch; the final export does not depend on it
+  write_all(fd_, buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+bool stream_enabled() {
+  const char *env = std::getenv("RMW_INTROSPECT_STREAM");
+  return env && (*env == '1' || *env == 't' || *env == 'T');
+}
+
+std::string stream_output_path(const std::string &output_path) {
+  const std::string suffix = ".json";
+  if (output_path.size() > suffix.size() &&
+      output_path.compare(output_path.size() - suffix.size(), suffix.size(),
+                          suffix) == 0) {
+    return output_path.substr(0, output_path.size() - suffix.size()) +
+           ".ndjson";
+  }
+  return output_path + ".ndjson";
+}
+
+bool start_stream_from_env(const std::string &output_path) {
+  const auto interval = std::chrono::milliseconds(env_size(
+      "RMW_INTROSPECT_STREAM_INTERVAL_MS",
+      static_cast<size_t>(kDefaultInterval.count())));
+  const size_t buffer_bytes =
+      env_size("RMW_INTROSPECT_STREAM_BYTES", kDefaultBufferBytes);
+  return StreamWriter::instance().start(stream_output_path(output_path),
+                                        interval, buffer_bytes);
+}
+
+} // namespace rmw_introspect
@@ -0,0 +1,48 @@
+#include "rmw_introspect/string_table.hpp"
+#include <mutex>
+
+namespace rmw_introspect {
+
+StringTable &StringTable::instance() {
+  static StringTable table;
+  return table;
+}
+
+StringTable::StringTable() {
+  // Id 0 is reserved for the empty string
+  strings_.emplace_back();
+  ids_.emplace(strings_.back(), 0);
+}
+
+StringId StringTable::intern(std::string_view str) {
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(str);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  // Another thread may have added it since the shared lock was released
+  auto it = ids_.find(str);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<StringId>(strings_.size());
+  strings_.emplace_back(str);
+  ids_.emplace(strings_.back(), id);
+  return id;
+}
+
+const std::string &StringTable::lookup(StringId id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return strings_[id];
+}
+
+size_t StringTable::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return strings_.size();
+}
+
+} // namespace rmw_introspect
@@ -1,6 +1,7 @@
 #include "rmw_introspect/type_support.hpp"
 #include "rosidl_typesupport_cpp/message_type_support_dispatch.hpp"
 #include "rosidl_typesupport_cpp/service_type_support_dispatch.hpp"
+#include "rosidl_typesupport_introspection_c/field_types.h"
 #include "rosidl_typesupport_introspection_c/identifier.h"
 #include "rosidl_typesupport_introspection_c/message_introspection.h"
 #include "rosidl_typesupport_introspection_c/service_introspection.h"
@@ -11,6 +12,42 @@
 
 namespace rmw_introspect {
 
+namespace {
+
+/// Walk introspection members (C or C++ layout) looking for unbounded fields
+template <typename MessageMembersT>
+bool members_bounded(const MessageMembersT *members) {
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto &member = members->members_[i];
+
+    // Sequences have array_size_ 0 when unbounded, or is_upper_bound_ set
+    if (member.is_array_ && member.array_size_ == 0) {
+      return false;
+    }
+
+    switch (member.type_id_) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
+      if (member.string_upper_bound_ == 0) {
+        return false;
+      }
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE:
+      if (!member.members_ || !member.members_->data ||
+          !members_bounded(
+              static_cast<const MessageMembersT *>(member.members_->data))) {
+        return false;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 std::string
 extract_message_type(const rosidl_message_type_support_t *type_support) {
   if (!type_support) {
@@ -147,4 +184,34 @@ extract_service_type(const rosidl_service_type_support_t *type_support) {
   return "unknown/srv/Unknown";
 }
 
+bool is_message_bounded(const rosidl_message_type_support_t *type_support,
+                        bool *bounded) {
+  if (!type_support || !bounded) {
+    return false;
+  }
+
+  const rosidl_message_type_support_t *introspection_ts_cpp =
+      rosidl_typesupport_cpp::get_message_typesupport_handle_function(
+          type_support,
+          rosidl_typesupport_introspection_cpp::typesupport_identifier);
+  if (introspection_ts_cpp && introspection_ts_cpp->data) {
+    *bounded = members_bounded(
+        static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers
+                        *>(introspection_ts_cpp->data));
+    return true;
+  }
+
+  const rosidl_message_type_support_t *introspection_ts_c =
+      rosidl_typesupport_cpp::get_message_typesupport_handle_function(
+          type_support, rosidl_typesupport_introspection_c__identifier);
+  if (introspection_ts_c && introspection_ts_c->data) {
+    *bounded = members_bounded(
+        static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+            introspection_ts_c->data));
+    return true;
+  }
+
+  return false;
+}
+
 } // namespace rmw_introspect
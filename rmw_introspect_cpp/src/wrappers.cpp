@@ -1,5 +1,7 @@
 #include "rmw_introspect/wrappers.hpp"
+#include "rmw/event.h"
 #include "rmw_introspect/real_rmw.hpp"
+#include <utility>
 
 namespace rmw_introspect {
 
@@ -14,39 +16,147 @@ ContextWrapper::~ContextWrapper() {
 
 // NodeWrapper
 NodeWrapper::NodeWrapper(rmw_node_t *real, const char *n, const char *ns)
-    : real_node(real), name(n ? n : ""), namespace_(ns ? ns : "") {}
+    : real_node(real), name(n), namespace_(ns) {}
+
+// CallbackTrampoline
+CallbackTrampoline::CallbackTrampoline(CallbackStats *s)
+    : callback(nullptr), user_data(nullptr), stats(s) {}
+
+void CallbackTrampoline::invoke(const void *trampoline,
+                                size_t number_of_events) {
+  auto *self = static_cast<const CallbackTrampoline *>(trampoline);
+  if (self->stats) {
+    self->stats->record_callback(number_of_events);
+  }
+  if (self->callback) {
+    self->callback(self->user_data, number_of_events);
+  }
+}
 
 // PublisherWrapper
 PublisherWrapper::PublisherWrapper(rmw_publisher_t *real,
-                                   const std::string &topic,
-                                   const std::string &type,
-                                   const rmw_qos_profile_t &q)
-    : real_publisher(real), topic_name(topic), message_type(type), qos(q) {}
+                                   InternedString topic, InternedString type,
+                                   const rmw_qos_profile_t &q,
+                                   std::shared_ptr<PublisherStats> s)
+    : real_publisher(real), topic_name(topic), message_type(type), qos(q),
+      stats(std::move(s)) {}
 
 // SubscriptionWrapper
 SubscriptionWrapper::SubscriptionWrapper(rmw_subscription_t *real,
-                                         const std::string &topic,
-                                         const std::string &type,
-                                         const rmw_qos_profile_t &q)
-    : real_subscription(real), topic_name(topic), message_type(type), qos(q) {}
+                                         InternedString topic,
+                                         InternedString type,
+                                         const rmw_qos_profile_t &q,
+                                         std::shared_ptr<SubscriptionStats> s)
+    : real_subscription(real), topic_name(topic), message_type(type), qos(q),
+      stats(std::move(s)),
+      on_new_message(stats ? &stats->callbacks : nullptr) {}
 
 // ServiceWrapper
-ServiceWrapper::ServiceWrapper(rmw_service_t *real, const std::string &name,
-                               const std::string &type,
-                               const rmw_qos_profile_t &q)
-    : real_service(real), service_name(name), service_type(type), qos(q) {}
+ServiceWrapper::ServiceWrapper(rmw_service_t *real, InternedString name,
+                               InternedString type, const rmw_qos_profile_t &q,
+                               std::shared_ptr<ServiceStats> s)
+    : real_service(real), service_name(name), service_type(type), qos(q),
+      stats(std::move(s)),
+      on_new_request(stats ? &stats->callbacks : nullptr) {}
 
 // ClientWrapper
-ClientWrapper::ClientWrapper(rmw_client_t *real, const std::string &name,
-                             const std::string &type,
-                             const rmw_qos_profile_t &q)
-    : real_client(real), service_name(name), service_type(type), qos(q) {}
+ClientWrapper::ClientWrapper(rmw_client_t *real, InternedString name,
+                             InternedString type, const rmw_qos_profile_t &q,
+                             std::shared_ptr<ClientStats> s)
+    : real_client(real), service_name(name), service_type(type), qos(q),
+      stats(std::move(s)),
+      on_new_response(stats ? &stats->callbacks : nullptr) {}
 
 // GuardConditionWrapper
 GuardConditionWrapper::GuardConditionWrapper(rmw_guard_condition_t *real)
     : real_guard_condition(real) {}
 
+// PublisherAllocationWrapper
+PublisherAllocationWrapper::PublisherAllocationWrapper()
+    : real_allocation{nullptr, nullptr} {}
+
+// SubscriptionAllocationWrapper
+SubscriptionAllocationWrapper::SubscriptionAllocationWrapper()
+    : real_allocation{nullptr, nullptr} {}
+
+// EventWrapper
+EventWrapper::EventWrapper(std::shared_ptr<QoSEventStats> s)
+    : real_event(rmw_get_zero_initialized_event()), stats(std::move(s)),
+      callback_stats(), on_event(&callback_stats) {}
+
+void EventWrapper::record_taken(const void *event_info) {
+  switch (real_event.event_type) {
+  case RMW_EVENT_REQUESTED_DEADLINE_MISSED: {
+    auto *status =
+        static_cast<const rmw_requested_deadline_missed_status_t *>(event_info);
+    if (status->total_count_change > 0) {
+      stats->deadline_missed.fetch_add(status->total_count_change,
+                                       std::memory_order_relaxed);
+    }
+    break;
+  }
+  case RMW_EVENT_OFFERED_DEADLINE_MISSED: {
+    auto *status =
+        static_cast<const rmw_offered_deadline_missed_status_t *>(event_info);
+    if (status->total_count_change > 0) {
+      stats->deadline_missed.fetch_add(status->total_count_change,
+                                       std::memory_order_relaxed);
+    }
+    break;
+  }
+  case RMW_EVENT_LIVELINESS_LOST: {
+    auto *status =
+        static_cast<const rmw_liveliness_lost_status_t *>(event_info);
+    if (status->total_count_change > 0) {
+      stats->liveliness_lost.fetch_add(status->total_count_change,
+                                       std::memory_order_relaxed);
+    }
+    break;
+  }
+  case RMW_EVENT_MESSAGE_LOST: {
+    auto *status = static_cast<const rmw_message_lost_status_t *>(event_info);
+    stats->messages_lost.fetch_add(status->total_count_change,
+                                   std::memory_order_relaxed);
+    break;
+  }
+  case RMW_EVENT_REQUESTED_QOS_INCOMPATIBLE:
+  case RMW_EVENT_OFFERED_QOS_INCOMPATIBLE: {
+    // Requested and offered statuses share one layout
+    auto *status =
+        static_cast<const rmw_qos_incompatible_event_status_t *>(event_info);
+    if (status->total_count_change > 0) {
+      stats->incompatible_qos.fetch_add(status->total_count_change,
+                                        std::memory_order_relaxed);
+    }
+    break;
+  }
+  default:
+    // Liveliness changed and matched events are not counted
+    break;
+  }
+}
+
 // WaitSetWrapper
-WaitSetWrapper::WaitSetWrapper(rmw_wait_set_t *real) : real_wait_set(real) {}
+WaitSetWrapper::WaitSetWrapper(rmw_wait_set_t *real, size_t max_conditions)
+    : real_wait_set(real), allocations_avoided(0), scratch_grows(0) {
+  // max_conditions == 0 means "unbounded"; arrays then grow on first use
+  subscriptions_scratch.resize(max_conditions);
+  guard_conditions_scratch.resize(max_conditions);
+  services_scratch.resize(max_conditions);
+  clients_scratch.resize(max_conditions);
+  events_scratch.resize(max_conditions);
+}
+
+void **WaitSetWrapper::acquire_scratch(std::vector<void *> &scratch,
+                                       size_t count) {
+  if (count > scratch.size()) {
+    // Grow-only: never shrink, so the next wait of this size is free
+    scratch.resize(count);
+    scratch_grows.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    allocations_avoided.fetch_add(1, std::memory_order_relaxed);
+  }
+  return scratch.data();
+}
 
 } // namespace rmw_introspect
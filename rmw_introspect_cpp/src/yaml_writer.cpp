@@ -0,0 +1,101 @@
+#include "rmw_introspect/yaml_writer.hpp"
+#include "rmw_introspect/json_writer.hpp"
+
+namespace rmw_introspect {
+
+YamlWriter::YamlWriter(OutputBuffer &out)
+    : out_(out), after_key_(false), after_dash_(false) {}
+
+void YamlWriter::begin_object() { begin(false); }
+void YamlWriter::end_object() { end("{}"); }
+void YamlWriter::begin_array() { begin(true); }
+void YamlWriter::end_array() { end("[]"); }
+
+void YamlWriter::key(std::string_view name) {
+  Scope &scope = scopes_.back();
+  const bool first = scope.empty;
+  scope.empty = false;
+  if (after_dash_) {
+    // First key of a mapping in a sequence shares the "- " line
+    after_dash_ = false;
+  } else if (!(first && scopes_.size() == 1)) {
+    newline(scope.indent);
+  }
+  out_.write(name);
+  out_.put(':');
+  after_key_ = true;
+}
+
+void YamlWriter::value(std::string_view str) {
+  begin_scalar();
+  append_json_string(out_, str);
+}
+
+void YamlWriter::value(bool b) {
+  begin_scalar();
+  out_.write(b ? "true" : "false");
+}
+
+void YamlWriter::value(double number) {
+  begin_scalar();
+  out_.write_double(number);
+}
+
+void YamlWriter::null() {
+  begin_scalar();
+  out_.write("null", 4);
+}
+
+void YamlWriter::begin_scalar() {
+  if (after_key_) {
+    after_key_ = false;
+    out_.put(' ');
+  } else if (!scopes_.empty() && scopes_.back().is_array) {
+    begin_item();
+    after_dash_ = false;
+  }
+}
+
+void YamlWriter::begin(bool is_array) {
+  if (scopes_.empty()) {
+    scopes_.push_back({is_array, true, false, 0});
+    return;
+  }
+  const size_t indent = scopes_.back().indent + 2;
+  const bool after_key = after_key_;
+  if (after_key) {
+    after_key_ = false;
+  } else if (scopes_.back().is_array) {
+    begin_item();
+  }
+  scopes_.push_back({is_array, true, after_key, indent});
+}
+
+void YamlWriter::end(const char *empty) {
+  if (scopes_.back().empty) {
+    if (scopes_.back().after_key) {
+      out_.put(' ');
+    }
+    out_.write(empty);
+    after_dash_ = false;
+  }
+  scopes_.pop_back();
+  if (scopes_.empty()) {
+    out_.put('\n');
+  }
+}
+
+void YamlWriter::begin_item() {
+  Scope &scope = scopes_.back();
+  scope.empty = false;
+  newline(scope.indent);
+  out_.write("- ", 2);
+  after_dash_ = true;
+}
+
+void YamlWriter::newline(size_t indent) {
+  out_.put('\n');
+  out_.fill(indent, ' ');
+}
+
+} // namespace rmw_introspect
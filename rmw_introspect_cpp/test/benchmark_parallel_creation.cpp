@@ -0,0 +1,198 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/identifier.hpp"
+#include "test_msgs/msg/basic_types.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+using namespace std::chrono;
+
+// Benchmark configuration
+constexpr size_t THREAD_COUNTS[] = {1, 2, 4, 8, 16};
+constexpr size_t RECORDS_PER_THREAD = 20000;
+constexpr size_t NODES_PER_THREAD = 4;
+constexpr size_t PUBLISHERS_PER_NODE = 25;
+
+// The previous IntrospectionData storage: one mutex around growing vectors
+struct MutexVectorLog {
+  std::mutex mutex;
+  std::vector<rmw_introspect::PublisherInfo> publishers;
+
+  void record(const rmw_introspect::PublisherInfo &info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    publishers.push_back(info);
+  }
+};
+
+// Run `body(thread_index)` on `threads` threads released together, and
+// return the wall time in nanoseconds
+template <typename Body>
+double run_parallel(size_t threads, Body body) {
+  std::vector<std::thread> workers;
+  std::mutex start_mutex;
+  start_mutex.lock();
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      { std::lock_guard<std::mutex> wait_for_start(start_mutex); }
+      body(t);
+    });
+  }
+  auto start = steady_clock::now();
+  start_mutex.unlock();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return static_cast<double>(
+      duration_cast<nanoseconds>(steady_clock::now() - start).count());
+}
+
+int main(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+
+  std::cout << "RMW Introspect Parallel Creation Benchmark\n";
+  std::cout << "==========================================\n\n";
+
+  const char *delegate_to = std::getenv("RMW_INTROSPECT_DELEGATE_TO");
+  if (delegate_to) {
+    std::cout << "Intermediate mode: delegating to " << delegate_to << "\n\n";
+  } else {
+    std::cout << "Recording-only mode (no delegation)\n\n";
+  }
+
+  auto &data = rmw_introspect::IntrospectionData::instance();
+
+  // Each record gets its own topic and each thread its own node, all
+  // interned as the Info is filled in, as rmw_create_publisher does
+  auto make_info = [](const std::string &ns, const std::string &node,
+                      size_t i) {
+    rmw_introspect::PublisherInfo info;
+    info.node_name = node;
+    info.node_namespace = ns;
+    info.topic_name = ns + "/topic_" + std::to_string(i);
+    info.message_type = "test_msgs/msg/BasicTypes";
+    info.timestamp = 0.0;
+    return info;
+  };
+
+  // Test 1: recording alone, old mutex + vector storage vs segmented log
+  std::cout << "Test 1: Building and recording " << RECORDS_PER_THREAD
+            << " publishers per thread\n";
+  std::cout << "threads  mutex+vector ns/record  segmented log ns/record\n";
+  for (size_t threads : THREAD_COUNTS) {
+    // Separate namespaces so neither run finds the other's names interned
+    const std::string suffix = "_" + std::to_string(threads);
+
+    MutexVectorLog baseline;
+    double baseline_ns = run_parallel(threads, [&](size_t t) {
+      const std::string node = "node_" + std::to_string(t);
+      for (size_t i = 0; i < RECORDS_PER_THREAD; ++i) {
+        baseline.record(make_info("/mutex" + suffix, node, i));
+      }
+    });
+
+    data.clear();
+    double log_ns = run_parallel(threads, [&](size_t t) {
+      const std::string node = "node_" + std::to_string(t);
+      for (size_t i = 0; i < RECORDS_PER_THREAD; ++i) {
+        data.record_publisher(make_info("/log" + suffix, node, i));
+      }
+    });
+
+    const double records = static_cast<double>(threads * RECORDS_PER_THREAD);
+    std::cout << "  " << threads << "\t " << baseline_ns / records << "\t\t\t  "
+              << log_ns / records << "\n";
+  }
+  data.clear();
+
+  // Test 2: end-to-end node and publisher creation through the RMW API
+  rmw_init_options_t init_options = rmw_get_zero_initialized_init_options();
+  rmw_ret_t ret =
+      rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+  if (ret != RMW_RET_OK) {
+    std::cerr << "Failed to initialize init options\n";
+    return 1;
+  }
+
+  rmw_context_t context = rmw_get_zero_initialized_context();
+  ret = rmw_init(&init_options, &context);
+  rmw_init_options_fini(&init_options);
+  if (ret != RMW_RET_OK) {
+    std::cerr << "Failed to initialize context\n";
+    return 1;
+  }
+
+  const rosidl_message_type_support_t *type_support =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+
+  std::cout << "\nTest 2: Creating " << NODES_PER_THREAD << " nodes with "
+            << PUBLISHERS_PER_NODE << " publishers each, per thread\n";
+  std::cout << "threads  μs/entity\n";
+  std::atomic<bool> failed{false};
+  for (size_t threads : THREAD_COUNTS) {
+    std::vector<std::vector<rmw_node_t *>> nodes(threads);
+    std::vector<std::vector<rmw_publisher_t *>> publishers(threads);
+
+    double create_ns = run_parallel(threads, [&](size_t t) {
+      for (size_t n = 0; n < NODES_PER_THREAD; ++n) {
+        std::string node_name = "bench_" + std::to_string(threads) + "_" +
+                                std::to_string(t) + "_" + std::to_string(n);
+        rmw_node_t *node =
+            rmw_create_node(&context, node_name.c_str(), "/bench");
+        if (!node) {
+          failed = true;
+          return;
+        }
+        nodes[t].push_back(node);
+        for (size_t p = 0; p < PUBLISHERS_PER_NODE; ++p) {
+          std::string topic = "topic_" + std::to_string(p);
+          rmw_publisher_options_t options =
+              rmw_get_default_publisher_options();
+          rmw_publisher_t *pub =
+              rmw_create_publisher(node, type_support, topic.c_str(),
+                                   &rmw_qos_profile_default, &options);
+          if (!pub) {
+            failed = true;
+            return;
+          }
+          publishers[t].push_back(pub);
+        }
+      }
+    });
+
+    const double entities = static_cast<double>(
+        threads * NODES_PER_THREAD * (PUBLISHERS_PER_NODE + 1));
+    std::cout << "  " << threads << "\t " << create_ns / entities / 1000.0
+              << "\n";
+
+    // Cleanup, outside the timed region
+    for (size_t t = 0; t < threads; ++t) {
+      for (size_t i = 0; i < publishers[t].size(); ++i) {
+        rmw_destroy_publisher(nodes[t][i / PUBLISHERS_PER_NODE],
+                              publishers[t][i]);
+      }
+      for (auto *node : nodes[t]) {
+        rmw_destroy_node(node);
+      }
+    }
+    if (failed) {
+      std::cerr << "Entity creation failed with " << threads << " threads\n";
+      break;
+    }
+  }
+
+  rmw_shutdown(&context);
+  rmw_context_fini(&context);
+
+  return failed ? 1 : 0;
+}
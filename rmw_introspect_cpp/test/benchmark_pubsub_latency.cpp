@@ -18,6 +18,7 @@ using namespace std::chrono;
 // Benchmark configuration
 constexpr size_t NUM_ITERATIONS = 1000;
 constexpr size_t WARMUP_ITERATIONS = 100;
+constexpr size_t CALL_OVERHEAD_ITERATIONS = 1000000;
 
 struct BenchmarkResults {
   double mean_latency_us;
@@ -177,6 +178,32 @@ int main(int argc, char **argv) {
     std::this_thread::sleep_for(microseconds(100));
   }
 
+  // Back-to-back calls with no sleep: average cost of one entry point,
+  // dominated by the layer's own dispatch in recording-only mode
+  std::cout << "Measuring per-call overhead...\n";
+  auto overhead_start = steady_clock::now();
+  for (size_t i = 0; i < CALL_OVERHEAD_ITERATIONS; ++i) {
+    rmw_publish(publisher, &msg, nullptr);
+  }
+  double publish_ns =
+      static_cast<double>(
+          duration_cast<nanoseconds>(steady_clock::now() - overhead_start)
+              .count()) /
+      CALL_OVERHEAD_ITERATIONS;
+
+  overhead_start = steady_clock::now();
+  for (size_t i = 0; i < CALL_OVERHEAD_ITERATIONS; ++i) {
+    bool taken = false;
+    rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+    rmw_take_with_info(subscription, &received_msg, &taken, &message_info,
+                       nullptr);
+  }
+  double take_ns =
+      static_cast<double>(
+          duration_cast<nanoseconds>(steady_clock::now() - overhead_start)
+              .count()) /
+      CALL_OVERHEAD_ITERATIONS;
+
   // Calculate and display results
   if (!latencies.empty()) {
     BenchmarkResults results = calculate_statistics(latencies);
@@ -192,6 +219,11 @@ int main(int argc, char **argv) {
     std::cout << "\nNo latency measurements collected\n";
   }
 
+  std::cout << "\nPer-call overhead (" << CALL_OVERHEAD_ITERATIONS
+            << " calls):\n";
+  std::cout << "rmw_publish:        " << publish_ns << " ns/call\n";
+  std::cout << "rmw_take_with_info: " << take_ns << " ns/call\n";
+
   // Cleanup
   test_msgs__msg__BasicTypes__fini(&msg);
   test_msgs__msg__BasicTypes__fini(&received_msg);
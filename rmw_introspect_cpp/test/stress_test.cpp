@@ -8,7 +8,9 @@
 #include "rcutils/allocator.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
+#include "rmw_introspect/handle_pool.hpp"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/wrappers.hpp"
 #include "std_msgs/msg/string.h"
 #include "std_srvs/srv/empty.h"
 #include "test_msgs/msg/basic_types.h"
@@ -25,6 +27,64 @@ constexpr size_t NUM_SERVICES_PER_NODE = 2;
 constexpr size_t NUM_CLIENTS_PER_NODE = 2;
 constexpr size_t NUM_CREATE_DESTROY_CYCLES = 100;
 constexpr size_t NUM_PUBLISH_ITERATIONS = 1000;
+constexpr size_t NUM_ALLOCATION_ROUNDS = 2000;
+constexpr size_t NUM_LIVE_HANDLES = 64;
+
+namespace {
+
+/// Time NUM_ALLOCATION_ROUNDS rounds of creating NUM_LIVE_HANDLES publisher
+/// handles with their wrappers and destroying them again
+/// @return Average ns per create/destroy pair
+template <typename Create, typename Destroy>
+double time_handle_churn(Create create, Destroy destroy) {
+  std::vector<rmw_publisher_t *> handles(NUM_LIVE_HANDLES);
+  auto start = high_resolution_clock::now();
+  for (size_t round = 0; round < NUM_ALLOCATION_ROUNDS; ++round) {
+    for (auto &handle : handles) {
+      handle = create();
+    }
+    for (auto *handle : handles) {
+      destroy(handle);
+    }
+  }
+  auto elapsed =
+      duration_cast<nanoseconds>(high_resolution_clock::now() - start);
+  return elapsed.count() / (double)(NUM_ALLOCATION_ROUNDS * NUM_LIVE_HANDLES);
+}
+
+/// Compare the intermediate-mode handle pool with the separate new/delete of
+/// handle and wrapper it replaced, without the real RMW's own cost
+void compare_handle_allocation() {
+  const rmw_introspect::InternedString topic("/stress_topic");
+  const rmw_introspect::InternedString type("std_msgs/msg/String");
+
+  double unpooled_ns = time_handle_churn(
+      [&]() {
+        auto *handle = new rmw_publisher_t{};
+        handle->data = new rmw_introspect::PublisherWrapper(
+            nullptr, topic, type, rmw_qos_profile_default, nullptr);
+        return handle;
+      },
+      [](rmw_publisher_t *handle) {
+        delete static_cast<rmw_introspect::PublisherWrapper *>(handle->data);
+        delete handle;
+      });
+
+  rmw_introspect::HandlePool<rmw_publisher_t, rmw_introspect::PublisherWrapper>
+      pool;
+  double pooled_ns = time_handle_churn(
+      [&]() {
+        return pool.acquire(nullptr, topic, type, rmw_qos_profile_default,
+                            nullptr);
+      },
+      [&](rmw_publisher_t *handle) { pool.release(handle); });
+
+  std::cout << "  new/delete per handle: " << unpooled_ns << " ns\n";
+  std::cout << "  Pooled per handle: " << pooled_ns << " ns\n";
+  std::cout << "  Speedup: " << unpooled_ns / pooled_ns << "x\n\n";
+}
+
+} // namespace
 
 int main(int argc, char **argv) {
   (void)argc;
@@ -255,18 +315,57 @@ int main(int argc, char **argv) {
                 << "\n";
       goto cleanup;
     }
+
+    // Create and destroy a temporary service
+    rmw_service_t *temp_srv = rmw_create_service(
+        nodes[0], srv_type_support, "temp_service", &rmw_qos_profile_default);
+    if (!temp_srv) {
+      std::cerr << "Failed to create temporary service in cycle " << cycle
+                << "\n";
+      goto cleanup;
+    }
+    ret = rmw_destroy_service(nodes[0], temp_srv);
+    if (ret != RMW_RET_OK) {
+      std::cerr << "Failed to destroy temporary service in cycle " << cycle
+                << "\n";
+      goto cleanup;
+    }
+
+    // Create and destroy a temporary client
+    rmw_client_t *temp_client = rmw_create_client(
+        nodes[0], srv_type_support, "temp_service", &rmw_qos_profile_default);
+    if (!temp_client) {
+      std::cerr << "Failed to create temporary client in cycle " << cycle
+                << "\n";
+      goto cleanup;
+    }
+    ret = rmw_destroy_client(nodes[0], temp_client);
+    if (ret != RMW_RET_OK) {
+      std::cerr << "Failed to destroy temporary client in cycle " << cycle
+                << "\n";
+      goto cleanup;
+    }
     }
 
     auto end_cycle = high_resolution_clock::now();
-    auto cycle_duration = duration_cast<milliseconds>(end_cycle - start_cycle);
+    auto cycle_duration = duration_cast<microseconds>(end_cycle - start_cycle);
 
+    // Each cycle creates and destroys 4 entities; in intermediate mode their
+    // handles and wrappers come from recycled pool slots after the first
+    double cycle_us =
+        cycle_duration.count() / (double)NUM_CREATE_DESTROY_CYCLES;
     std::cout << "✓ Completed " << NUM_CREATE_DESTROY_CYCLES << " cycles in "
-              << cycle_duration.count() << " ms\n";
-    std::cout << "  Average cycle time: "
-              << (cycle_duration.count() / (double)NUM_CREATE_DESTROY_CYCLES)
-              << " ms\n\n";
+              << cycle_duration.count() / 1000.0 << " ms\n";
+    std::cout << "  Average cycle time: " << cycle_us << " μs\n";
+    std::cout << "  Average create/destroy pair: " << cycle_us / 4.0
+              << " μs\n\n";
   }
 
+  // Test 4: Handle allocation, pooled vs. unpooled
+  std::cout << "Test 4: Handle allocation (" << NUM_ALLOCATION_ROUNDS
+            << " rounds of " << NUM_LIVE_HANDLES << " handles)\n";
+  compare_handle_allocation();
+
 cleanup:
   // Cleanup all entities
   std::cout << "Cleaning up...\n";
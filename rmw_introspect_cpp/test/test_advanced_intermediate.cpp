@@ -6,6 +6,7 @@
 #include "rmw/names_and_types.h"
 #include "rmw/rmw.h"
 #include "rmw_introspect/identifier.hpp"
+#include "rmw_introspect/wrappers.hpp"
 #include "std_msgs/msg/string.h"
 #include "std_msgs/msg/detail/string__type_support.h"
 
@@ -253,6 +254,34 @@ TEST_F(AdvancedIntermediateTest, GetNamesAndTypesByNode) {
   rmw_names_and_types_fini(&names_and_types);
 }
 
+TEST_F(AdvancedIntermediateTest, WaitRejectsBrokenWaitSets) {
+  rmw_time_t timeout{0, 0};
+
+  // Not ours
+  rmw_wait_set_t foreign{};
+  foreign.implementation_identifier = "other_rmw";
+  EXPECT_EQ(RMW_RET_INCORRECT_RMW_IMPLEMENTATION,
+            rmw_wait(nullptr, nullptr, nullptr, nullptr, nullptr, &foreign,
+                     &timeout));
+  rmw_reset_error();
+
+  // Ours, but without a wrapper
+  rmw_wait_set_t empty{};
+  empty.implementation_identifier = rmw_introspect_cpp_identifier;
+  EXPECT_EQ(RMW_RET_ERROR, rmw_wait(nullptr, nullptr, nullptr, nullptr,
+                                    nullptr, &empty, &timeout));
+  rmw_reset_error();
+
+  // A wrapper that lost its real wait set
+  rmw_introspect::WaitSetWrapper wrapper(nullptr, 0);
+  rmw_wait_set_t unwrapped{};
+  unwrapped.implementation_identifier = rmw_introspect_cpp_identifier;
+  unwrapped.data = &wrapper;
+  EXPECT_EQ(RMW_RET_ERROR, rmw_wait(nullptr, nullptr, nullptr, nullptr,
+                                    nullptr, &unwrapped, &timeout));
+  rmw_reset_error();
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
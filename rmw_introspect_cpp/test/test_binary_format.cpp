@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "rmw_introspect/binary_format.hpp"
+#include "rmw_introspect/data.hpp"
+
+using rmw_introspect::BinaryReader;
+using rmw_introspect::EntityKind;
+using rmw_introspect::IntrospectionData;
+using rmw_introspect::PublisherInfo;
+using rmw_introspect::QoSReliability;
+using rmw_introspect::ServiceInfo;
+using rmw_introspect::SubscriptionInfo;
+
+namespace {
+
+void record_graph(IntrospectionData & data) {
+  data.record_node("talker", "/demo");
+  data.record_node("listener", "/demo");
+
+  PublisherInfo pub;
+  pub.node_name = "talker";
+  pub.node_namespace = "/demo";
+  pub.topic_name = "/chatter";
+  pub.message_type = "std_msgs/msg/String";
+  pub.qos.reliability = QoSReliability::Reliable;
+  pub.qos.depth = 7;
+  pub.timestamp = 12.5;
+  data.record_publisher(pub);
+
+  SubscriptionInfo sub;
+  sub.node_name = "listener";
+  sub.node_namespace = "/demo";
+  sub.topic_name = "/chatter";
+  sub.message_type = "std_msgs/msg/String";
+  sub.timestamp = 13.0;
+  data.record_subscription(sub);
+
+  ServiceInfo srv;
+  srv.node_name = "talker";
+  srv.node_namespace = "/demo";
+  srv.service_name = "/reset";
+  srv.service_type = "std_srvs/srv/Empty";
+  srv.timestamp = 14.0;
+  data.record_service(srv);
+}
+
+}  // namespace
+
+// Every entity comes back through the reader, and the index finds all
+// endpoints on a name
+TEST(TestBinaryFormat, RoundTrip) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  record_graph(data);
+
+  const std::string path = "/tmp/test_rmw_introspect.bin";
+  ASSERT_TRUE(data.export_to_binary(path));
+
+  BinaryReader reader;
+  ASSERT_TRUE(reader.open(path)) << reader.error();
+  EXPECT_EQ(reader.header().version_major, rmw_introspect::kBinaryVersionMajor);
+
+  ASSERT_EQ(reader.node_count(), 2u);
+  EXPECT_EQ(reader.node(0), "/demo/talker");
+  EXPECT_EQ(reader.node(1), "/demo/listener");
+
+  ASSERT_EQ(reader.endpoint_count(), 3u);
+  const auto & pub = reader.endpoint(0);
+  EXPECT_EQ(pub.kind, static_cast<uint8_t>(EntityKind::Publisher));
+  EXPECT_EQ(pub.reliability, static_cast<uint8_t>(QoSReliability::Reliable));
+  EXPECT_EQ(pub.depth, 7u);
+  EXPECT_EQ(pub.timestamp, 12.5);
+  EXPECT_EQ(reader.string(pub.node_name), "talker");
+  EXPECT_EQ(reader.string(pub.type), "std_msgs/msg/String");
+  EXPECT_EQ(reader.endpoint(2).kind, static_cast<uint8_t>(EntityKind::Service));
+
+  auto chatter = reader.endpoints_on("/chatter");
+  ASSERT_EQ(chatter.size(), 2u);
+  EXPECT_EQ(chatter[0]->kind, static_cast<uint8_t>(EntityKind::Publisher));
+  EXPECT_EQ(chatter[1]->kind, static_cast<uint8_t>(EntityKind::Subscription));
+  EXPECT_EQ(reader.endpoints_on("/reset").size(), 1u);
+  EXPECT_TRUE(reader.endpoints_on("/missing").empty());
+  EXPECT_TRUE(reader.string(1u << 30).empty());
+
+  reader.close();
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// Files that are not ours or are cut short are rejected
+TEST(TestBinaryFormat, RejectsInvalidFiles) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  record_graph(data);
+
+  BinaryReader reader;
+  EXPECT_FALSE(reader.open("/tmp/test_rmw_introspect_missing.bin"));
+  EXPECT_FALSE(reader.error().empty());
+
+  const std::string path = "/tmp/test_rmw_introspect_invalid.bin";
+  {
+    std::ofstream file(path);
+    file << "{\"format_version\": \"1.0\"}" << std::string(200, ' ');
+  }
+  EXPECT_FALSE(reader.open(path));
+
+  // Truncate a valid file in the middle of its records
+  ASSERT_TRUE(data.export_to_binary(path));
+  std::string bytes;
+  {
+    std::ifstream file(path, std::ios::binary);
+    bytes.assign((std::istreambuf_iterator<char>(file)),
+      std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 16));
+  }
+  EXPECT_FALSE(reader.open(path));
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -3,9 +3,17 @@
 #include "rmw_introspect/data.hpp"
 #include "rmw/types.h"
 
+using rmw_introspect::EntityKind;
+using rmw_introspect::InternedString;
 using rmw_introspect::IntrospectionData;
 using rmw_introspect::PublisherInfo;
+using rmw_introspect::PublisherStats;
+using rmw_introspect::QoSDurability;
+using rmw_introspect::QoSHistory;
 using rmw_introspect::QoSProfile;
+using rmw_introspect::QoSReliability;
+using rmw_introspect::SubscriptionInfo;
+using rmw_introspect::SubscriptionStats;
 
 // Test singleton instance
 TEST(TestData, SingletonInstance) {
@@ -39,9 +47,9 @@ TEST(TestData, RecordPublisher) {
   pub_info.node_namespace = "/";
   pub_info.topic_name = "test_topic";
   pub_info.message_type = "std_msgs/msg/String";
-  pub_info.qos.reliability = "reliable";
-  pub_info.qos.durability = "volatile";
-  pub_info.qos.history = "keep_last";
+  pub_info.qos.reliability = QoSReliability::Reliable;
+  pub_info.qos.durability = QoSDurability::Volatile;
+  pub_info.qos.history = QoSHistory::KeepLast;
   pub_info.qos.depth = 10;
   pub_info.timestamp = 0.0;
 
@@ -66,9 +74,12 @@ TEST(TestData, QoSConversion) {
 
   QoSProfile qos = QoSProfile::from_rmw(rmw_qos);
 
-  EXPECT_EQ(qos.reliability, "reliable");
-  EXPECT_EQ(qos.durability, "volatile");
-  EXPECT_EQ(qos.history, "keep_last");
+  EXPECT_EQ(qos.reliability, QoSReliability::Reliable);
+  EXPECT_EQ(qos.durability, QoSDurability::Volatile);
+  EXPECT_EQ(qos.history, QoSHistory::KeepLast);
+  EXPECT_STREQ(rmw_introspect::to_string(qos.reliability), "reliable");
+  EXPECT_STREQ(rmw_introspect::to_string(qos.durability), "volatile");
+  EXPECT_STREQ(rmw_introspect::to_string(qos.history), "keep_last");
   EXPECT_EQ(qos.depth, 10u);
 }
 
@@ -85,9 +96,9 @@ TEST(TestData, JsonExport) {
   pub_info.node_namespace = "/";
   pub_info.topic_name = "test_topic";
   pub_info.message_type = "std_msgs/msg/String";
-  pub_info.qos.reliability = "reliable";
-  pub_info.qos.durability = "volatile";
-  pub_info.qos.history = "keep_last";
+  pub_info.qos.reliability = QoSReliability::Reliable;
+  pub_info.qos.durability = QoSDurability::Volatile;
+  pub_info.qos.history = QoSHistory::KeepLast;
   pub_info.qos.depth = 10;
   pub_info.timestamp = 0.0;
 
@@ -115,6 +126,195 @@ TEST(TestData, JsonExport) {
   data.clear();
 }
 
+// Test publisher traffic counters and their JSON export
+TEST(TestData, PublisherStatsExport) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  PublisherInfo pub_info;
+  pub_info.node_name = "test_node";
+  pub_info.node_namespace = "/";
+  pub_info.topic_name = "stats_topic";
+  pub_info.message_type = "std_msgs/msg/String";
+  pub_info.qos.depth = 10;
+  pub_info.timestamp = 0.0;
+  pub_info.stats = std::make_shared<PublisherStats>();
+
+  pub_info.stats->record_publish(RMW_RET_OK, 16);
+  pub_info.stats->record_publish(RMW_RET_OK, 0);
+  pub_info.stats->record_publish(RMW_RET_ERROR, 16);
+  pub_info.stats->loans_borrowed.fetch_add(1);
+
+  EXPECT_EQ(pub_info.stats->messages.load(), 2u);
+  EXPECT_EQ(pub_info.stats->serialized_bytes.load(), 16u);
+  EXPECT_EQ(pub_info.stats->errors.load(), 1u);
+  EXPECT_GT(pub_info.stats->first_publish_ns.load(), 0);
+  EXPECT_GE(pub_info.stats->last_publish_ns.load(),
+            pub_info.stats->first_publish_ns.load());
+
+  data.record_publisher(pub_info);
+
+  std::string path = "/tmp/test_rmw_introspect_stats.json";
+  data.export_to_json(path);
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+
+  EXPECT_TRUE(content.find("\"messages\": 2") != std::string::npos);
+  EXPECT_TRUE(content.find("\"serialized_bytes\": 16") != std::string::npos);
+  EXPECT_TRUE(content.find("\"errors\": 1") != std::string::npos);
+  EXPECT_TRUE(content.find("\"loans_borrowed\": 1") != std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// Test subscription callback and QoS event counters in the JSON export
+TEST(TestData, SubscriptionStatsExport) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  SubscriptionInfo sub_info;
+  sub_info.node_name = "test_node";
+  sub_info.node_namespace = "/";
+  sub_info.topic_name = "stats_topic";
+  sub_info.message_type = "std_msgs/msg/String";
+  sub_info.qos.depth = 10;
+  sub_info.timestamp = 0.0;
+  sub_info.stats = std::make_shared<SubscriptionStats>();
+
+  sub_info.stats->callbacks.record_callback(4);
+  sub_info.stats->callbacks.record_take();
+  sub_info.stats->qos_events.messages_lost.fetch_add(7);
+
+  data.record_subscription(sub_info);
+
+  std::string path = "/tmp/test_rmw_introspect_sub_stats.json";
+  data.export_to_json(path);
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+
+  EXPECT_TRUE(content.find("\"invocations\": 1") != std::string::npos);
+  EXPECT_TRUE(content.find("\"events\": 4") != std::string::npos);
+  EXPECT_TRUE(content.find("\"take_delay_samples\": 1") != std::string::npos);
+  EXPECT_TRUE(content.find("\"qos_events\"") != std::string::npos);
+  EXPECT_TRUE(content.find("\"messages_lost\": 7") != std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// Test that destroys close lifetimes and recreations show up as churn
+TEST(TestData, LifecycleTimeline) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  auto node_id = data.record_node("churn_node", "/ns");
+  ASSERT_NE(node_id, 0u);
+
+  SubscriptionInfo sub_info;
+  sub_info.node_name = "churn_node";
+  sub_info.node_namespace = "/ns";
+  sub_info.topic_name = "reconfigured";
+  sub_info.message_type = "std_msgs/msg/String";
+  sub_info.timestamp = 0.0;
+
+  // Recreate the same subscription three times, one alive at a time
+  for (int i = 0; i < 3; ++i) {
+    auto sub_id = data.record_subscription(sub_info);
+    ASSERT_NE(sub_id, 0u);
+    data.record_destroy(EntityKind::Subscription, sub_id);
+  }
+  auto live_id = data.record_subscription(sub_info);
+  ASSERT_NE(live_id, 0u);
+
+  // Unrecorded entities are ignored
+  data.record_destroy(EntityKind::Publisher, 0);
+
+  auto events = data.get_lifecycle();
+  ASSERT_EQ(events.size(), 8u);
+  EXPECT_EQ(events[0].kind, EntityKind::Node);
+  EXPECT_FALSE(events[0].destroyed);
+  EXPECT_TRUE(events[2].destroyed);
+  EXPECT_EQ(events[2].record_id, events[1].record_id);
+  EXPECT_LE(events[1].time_ns, events[2].time_ns);
+
+  std::string path = "/tmp/test_rmw_introspect_timeline.json";
+  data.export_timeline_to_json(path);
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+
+  EXPECT_TRUE(content.find("\"kind\": \"subscription\"") != std::string::npos);
+  EXPECT_TRUE(content.find("\"destroyed_ns\": null") != std::string::npos);
+  EXPECT_TRUE(content.find("\"subscriptions\": 1") != std::string::npos);
+  EXPECT_TRUE(content.find("\"total\": 2") != std::string::npos);
+  EXPECT_TRUE(content.find("\"node\": \"/ns/churn_node\"") != std::string::npos);
+  EXPECT_TRUE(content.find("\"created\": 4") != std::string::npos);
+  EXPECT_TRUE(content.find("\"destroyed\": 3") != std::string::npos);
+  EXPECT_TRUE(content.find("\"recreated\": 3") != std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// Names are escaped in the timeline, which stays valid JSON
+TEST(TestData, LifecycleTimelineEscapesNames) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  ASSERT_NE(data.record_node("odd\"node", "/ns\\x"), 0u);
+  SubscriptionInfo sub_info;
+  sub_info.node_name = "odd\"node";
+  sub_info.node_namespace = "/ns\\x";
+  sub_info.topic_name = "tab\there";
+  sub_info.message_type = "std_msgs/msg/String";
+  ASSERT_NE(data.record_subscription(sub_info), 0u);
+
+  std::string path = "/tmp/test_rmw_introspect_timeline_escape.json";
+  data.export_timeline_to_json(path);
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+
+  EXPECT_NE(content.find("\"node_name\": \"odd\\\"node\""), std::string::npos);
+  EXPECT_NE(content.find("\"node_namespace\": \"/ns\\\\x\""),
+            std::string::npos);
+  EXPECT_NE(content.find("\"name\": \"tab\\there\""), std::string::npos);
+  EXPECT_NE(content.find("\"node\": \"/ns\\\\x/odd\\\"node\""),
+            std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// Test that equal names share one interned id
+TEST(TestData, StringInterning) {
+  InternedString a("/shared/topic");
+  InternedString b(std::string("/shared/topic"));
+  InternedString c("/other/topic");
+
+  EXPECT_EQ(a.id(), b.id());
+  EXPECT_NE(a.id(), c.id());
+  EXPECT_EQ(a.str(), "/shared/topic");
+  EXPECT_TRUE(a == "/shared/topic");
+  EXPECT_TRUE(InternedString().empty());
+  EXPECT_TRUE(InternedString(static_cast<const char *>(nullptr)).empty());
+  EXPECT_EQ(sizeof(InternedString), sizeof(rmw_introspect::StringId));
+}
+
 int main(int argc, char ** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
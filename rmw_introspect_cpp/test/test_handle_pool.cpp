@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+#include "rmw_introspect/handle_pool.hpp"
+
+using rmw_introspect::HandlePool;
+
+namespace {
+
+struct TestWrapper {
+  std::string name;
+  int *destroyed;
+
+  TestWrapper(const std::string & n, int * d) : name(n), destroyed(d) {}
+  ~TestWrapper() { ++*destroyed; }
+};
+
+using TestPool = HandlePool<rmw_publisher_t, TestWrapper, 4>;
+
+rmw_publisher_t * g_late_handle = nullptr;
+
+rmw_publisher_t * acquire_publisher() {
+  return rmw_introspect::internal::publisher_pool().acquire(
+    nullptr, rmw_introspect::InternedString(),
+    rmw_introspect::InternedString(), rmw_qos_profile_default, nullptr);
+}
+
+// Exit handler destroying a handle the way a leaked rclcpp global does
+void release_late() {
+  auto & pool = rmw_introspect::internal::publisher_pool();
+  pool.release(g_late_handle);
+  // The slot is still the pool's to hand out again
+  rmw_publisher_t * again = acquire_publisher();
+  _exit(again == g_late_handle && pool.in_use() == 1 ? 0 : 1);
+}
+
+}  // namespace
+
+// The handle and wrapper come from one slot and data points at the wrapper
+TEST(TestHandlePool, AcquireConstructsWrapper) {
+  TestPool pool;
+  int destroyed = 0;
+
+  rmw_publisher_t * handle = pool.acquire("pub", &destroyed);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_NE(handle->data, nullptr);
+  EXPECT_EQ(handle->implementation_identifier, nullptr);
+  EXPECT_EQ(static_cast<TestWrapper *>(handle->data)->name, "pub");
+  EXPECT_EQ(pool.in_use(), 1u);
+
+  pool.release(handle);
+  EXPECT_EQ(destroyed, 1);
+  EXPECT_EQ(pool.in_use(), 0u);
+}
+
+// Released slots are reused before a new slab is allocated
+TEST(TestHandlePool, ReleasedSlotsAreRecycled) {
+  TestPool pool;
+  int destroyed = 0;
+
+  rmw_publisher_t * first = pool.acquire("a", &destroyed);
+  pool.release(first);
+  rmw_publisher_t * second = pool.acquire("b", &destroyed);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(pool.capacity(), 4u);
+  pool.release(second);
+}
+
+// Exhausting a slab grows the pool without moving live handles
+TEST(TestHandlePool, GrowsBySlab) {
+  TestPool pool;
+  int destroyed = 0;
+
+  std::vector<rmw_publisher_t *> handles;
+  for (int i = 0; i < 10; ++i) {
+    handles.push_back(pool.acquire(std::to_string(i), &destroyed));
+    ASSERT_NE(handles.back(), nullptr);
+  }
+  EXPECT_EQ(pool.capacity(), 12u);
+  EXPECT_EQ(std::set<rmw_publisher_t *>(handles.begin(), handles.end()).size(),
+            10u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(static_cast<TestWrapper *>(handles[i]->data)->name,
+              std::to_string(i));
+  }
+
+  for (auto * handle : handles) {
+    pool.release(handle);
+  }
+  EXPECT_EQ(destroyed, 10);
+  EXPECT_EQ(pool.in_use(), 0u);
+}
+
+// Handles destroyed after static destruction find their pool intact; under
+// AddressSanitizer a freed pool fails this with a use-after-free
+TEST(TestHandlePoolDeathTest, ReleaseAfterStaticDestruction) {
+  EXPECT_EXIT(
+  {
+    // Registered before the pool is first used, so it runs after the pool's
+    // destructor would have
+    std::atexit(release_late);
+    g_late_handle = acquire_publisher();
+    std::exit(g_late_handle ? 2 : 3);
+  }, ::testing::ExitedWithCode(0), "");
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
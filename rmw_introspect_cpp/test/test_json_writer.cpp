@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/json_writer.hpp"
+#include "rmw/types.h"
+
+using rmw_introspect::ClientInfo;
+using rmw_introspect::ClientStats;
+using rmw_introspect::IntrospectionData;
+using rmw_introspect::JsonWriter;
+using rmw_introspect::OutputBuffer;
+using rmw_introspect::PublisherInfo;
+using rmw_introspect::PublisherStats;
+using rmw_introspect::QoSDurability;
+using rmw_introspect::QoSHistory;
+using rmw_introspect::QoSProfile;
+using rmw_introspect::QoSReliability;
+using rmw_introspect::ServiceInfo;
+using rmw_introspect::SubscriptionInfo;
+
+namespace {
+
+std::string escaped(const std::string & str) {
+  OutputBuffer out(64);
+  rmw_introspect::append_json_string(out, str);
+  return std::string(out.view());
+}
+
+std::string read_file(const std::string & path) {
+  std::ifstream file(path);
+  return std::string((std::istreambuf_iterator<char>(file)),
+    std::istreambuf_iterator<char>());
+}
+
+size_t count(const std::string & haystack, const std::string & needle) {
+  size_t n = 0;
+  for (size_t pos = haystack.find(needle); pos != std::string::npos;
+    pos = haystack.find(needle, pos + needle.size()))
+  {
+    ++n;
+  }
+  return n;
+}
+
+}  // namespace
+
+// Plain names are copied as-is, everything JSON reserves is escaped
+TEST(TestJsonWriter, EscapesStrings) {
+  EXPECT_EQ(escaped("/chatter"), "\"/chatter\"");
+  EXPECT_EQ(escaped(""), "\"\"");
+  EXPECT_EQ(escaped("a\"b\\c"), "\"a\\\"b\\\\c\"");
+  EXPECT_EQ(escaped("line\nnext\ttab\r"), "\"line\\nnext\\ttab\\r\"");
+  EXPECT_EQ(escaped(std::string("nul\0", 4)), "\"nul\\u0000\"");
+  EXPECT_EQ(escaped("\x1f"), "\"\\u001f\"");
+  // UTF-8 passes through untouched
+  EXPECT_EQ(escaped("/t\xc3\xa9l\xc3\xa9"), "\"/t\xc3\xa9l\xc3\xa9\"");
+
+  // Appending to a string escapes the same way
+  std::string appended = "x";
+  rmw_introspect::append_json_string(appended, "a\"b\n");
+  EXPECT_EQ(appended, "x" + escaped("a\"b\n"));
+}
+
+// Separators and indentation follow the nesting
+TEST(TestJsonWriter, Layout) {
+  OutputBuffer out(256);
+  JsonWriter json(out);
+  json.begin_object();
+  json.member("name", "x");
+  json.key("empty");
+  json.begin_array();
+  json.end_array();
+  json.key("list");
+  json.begin_array();
+  json.value(1);
+  json.value(-2);
+  json.value(true);
+  json.null();
+  json.end_array();
+  json.member("ratio", 0.5);
+  json.end_object();
+
+  EXPECT_EQ(out.view(),
+    "{\n"
+    "  \"name\": \"x\",\n"
+    "  \"empty\": [],\n"
+    "  \"list\": [\n"
+    "    1,\n"
+    "    -2,\n"
+    "    true,\n"
+    "    null\n"
+    "  ],\n"
+    "  \"ratio\": 0.5\n"
+    "}\n");
+}
+
+// Doubles take the fewest digits that read back exactly
+TEST(TestJsonWriter, WritesShortestDoubles) {
+  auto written = [](double number) {
+      OutputBuffer out(64);
+      out.write_double(number);
+      return std::string(out.view());
+    };
+  EXPECT_EQ(written(0.1), "0.1");
+  EXPECT_EQ(written(1760000000.125), "1760000000.125");
+  EXPECT_EQ(written(2.0), "2");
+  EXPECT_EQ(written(-0.5), "-0.5");
+  EXPECT_EQ(std::strtod(written(1.0 / 3.0).c_str(), nullptr), 1.0 / 3.0);
+  EXPECT_EQ(written(std::numeric_limits<double>::infinity()), "null");
+}
+
+// Services and clients are exported like topics, with their stats
+TEST(TestJsonWriter, ExportsEveryEntityKind) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  ServiceInfo srv;
+  srv.node_name = "server";
+  srv.node_namespace = "/";
+  srv.service_name = "/add_two_ints";
+  srv.service_type = "example_interfaces/srv/AddTwoInts";
+  srv.timestamp = 1.25;
+  data.record_service(srv);
+
+  ClientInfo cli;
+  cli.node_name = "client";
+  cli.node_namespace = "/";
+  cli.service_name = "/add_two_ints";
+  cli.service_type = "example_interfaces/srv/AddTwoInts";
+  cli.timestamp = 2.5;
+  cli.stats = std::make_shared<ClientStats>();
+  cli.stats->callbacks.record_callback(3);
+  data.record_client(cli);
+
+  const std::string path = "/tmp/test_rmw_introspect_services.json";
+  data.export_to_json(path);
+  const std::string content = read_file(path);
+
+  EXPECT_EQ(content.find("\"services\": []"), std::string::npos);
+  EXPECT_EQ(content.find("\"clients\": []"), std::string::npos);
+  EXPECT_EQ(count(content, "\"service_name\": \"/add_two_ints\""), 2u);
+  EXPECT_NE(content.find("\"timestamp\": 1.25"), std::string::npos);
+  EXPECT_NE(content.find("\"timestamp\": 2.5"), std::string::npos);
+  EXPECT_NE(content.find("\"events\": 3"), std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// Large graphs with hostile names export every endpoint. The file is left
+// at RMW_INTROSPECT_LARGE_EXPORT, when set, for validate_json.py to check.
+TEST(TestJsonWriter, LargeExport) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  constexpr int kNodes = 100;
+  constexpr int kTopicsPerNode = 60;
+  QoSProfile qos;
+  qos.reliability = QoSReliability::Reliable;
+  qos.durability = QoSDurability::Volatile;
+  qos.history = QoSHistory::KeepLast;
+  qos.depth = 10;
+  for (int n = 0; n < kNodes; ++n) {
+    const std::string node = "node_" + std::to_string(n);
+    data.record_node(node.c_str(), "/large");
+    for (int t = 0; t < kTopicsPerNode; ++t) {
+      // Every tenth topic name needs escaping
+      std::string topic = "/topic_" + std::to_string(t);
+      if (t % 10 == 0) {
+        topic += "_\"quoted\"\\\n";
+      }
+      PublisherInfo pub;
+      pub.node_name = node;
+      pub.node_namespace = "/large";
+      pub.topic_name = topic;
+      pub.message_type = "std_msgs/msg/String";
+      pub.qos = qos;
+      pub.timestamp = n + t / 100.0;
+      if (t == 0) {
+        pub.stats = std::make_shared<PublisherStats>();
+        pub.stats->record_publish(RMW_RET_OK, 64);
+      }
+      data.record_publisher(pub);
+
+      SubscriptionInfo sub;
+      sub.node_name = node;
+      sub.node_namespace = "/large";
+      sub.topic_name = topic;
+      sub.message_type = "std_msgs/msg/String";
+      sub.qos = qos;
+      sub.timestamp = n + t / 100.0;
+      data.record_subscription(sub);
+    }
+  }
+
+  const char * keep = std::getenv("RMW_INTROSPECT_LARGE_EXPORT");
+  const std::string path =
+    keep && *keep ? keep : "/tmp/test_rmw_introspect_large.json";
+  data.export_to_json(path);
+  const std::string content = read_file(path);
+
+  const size_t endpoints = 2u * kNodes * kTopicsPerNode;
+  EXPECT_EQ(count(content, "\"topic_name\""), endpoints);
+  EXPECT_EQ(count(content, "_\\\"quoted\\\"\\\\\\n\""), endpoints / 10);
+  EXPECT_EQ(content.back(), '\n');
+
+  if (!keep || !*keep) {
+    std::remove(path.c_str());
+  }
+  data.clear();
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rmw_introspect/latency_histogram.hpp"
+
+using rmw_introspect::LatencyHistogram;
+using rmw_introspect::LatencyRegistry;
+using rmw_introspect::latency_output_path;
+
+// Test that bucket bounds round-trip through bucket_index
+TEST(TestLatencyHistogram, BucketBounds) {
+  for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+    EXPECT_EQ(LatencyHistogram::bucket_index(
+                  LatencyHistogram::bucket_lower_bound(i)), i);
+  }
+  EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX),
+            LatencyHistogram::kBucketCount - 1);
+}
+
+// Test percentiles stay within the bucket resolution
+TEST(TestLatencyHistogram, Percentiles) {
+  LatencyHistogram histogram;
+  for (uint64_t ns = 1; ns <= 10000; ++ns) {
+    histogram.record(ns * 1000);
+  }
+
+  auto snap = histogram.snapshot();
+  EXPECT_EQ(snap.count, 10000u);
+  EXPECT_EQ(snap.min_ns, 1000u);
+  EXPECT_EQ(snap.max_ns, 10000000u);
+
+  EXPECT_NEAR(static_cast<double>(snap.percentile(0.5)), 5000000.0,
+              5000000.0 * 0.125);
+  EXPECT_NEAR(static_cast<double>(snap.percentile(0.99)), 9900000.0,
+              9900000.0 * 0.125);
+  EXPECT_LE(snap.percentile(0.999), snap.max_ns);
+  EXPECT_EQ(snap.percentile(1.0), snap.max_ns);
+}
+
+// Test that samples from several threads are merged on snapshot
+TEST(TestLatencyHistogram, ConcurrentRecord) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&histogram]() {
+      for (int i = 0; i < 1000; ++i) {
+        histogram.record(100);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  auto snap = histogram.snapshot();
+  EXPECT_EQ(snap.count, 8000u);
+  EXPECT_EQ(snap.sum_ns, 800000u);
+  EXPECT_EQ(snap.buckets[LatencyHistogram::bucket_index(100)], 8000u);
+}
+
+// Test that names are escaped, so the export stays valid JSON
+TEST(TestLatencyHistogram, ExportEscapesNames) {
+  // Read once, when the registry is first used
+  setenv("RMW_INTROSPECT_LATENCY", "1", 1);
+  auto &registry = LatencyRegistry::instance();
+  ASSERT_TRUE(registry.enabled());
+  registry.clear();
+
+  auto histogram = registry.create("publish", "/ns\\x/odd\"node:tab\there");
+  ASSERT_NE(histogram, nullptr);
+  histogram->record(100);
+
+  std::string path = "/tmp/test_rmw_introspect_latency_escape.json";
+  registry.export_to_json(path);
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+  EXPECT_NE(content.find("\"operation\": \"publish\""), std::string::npos);
+  EXPECT_NE(content.find("\"entity\": \"/ns\\\\x/odd\\\"node:tab\\there\""),
+            std::string::npos);
+
+  std::remove(path.c_str());
+  registry.clear();
+}
+
+// Test latency export path derivation
+TEST(TestLatencyHistogram, OutputPath) {
+  EXPECT_EQ(latency_output_path("/tmp/graph.json"), "/tmp/graph.latency.json");
+  EXPECT_EQ(latency_output_path("/tmp/graph"), "/tmp/graph.latency.json");
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
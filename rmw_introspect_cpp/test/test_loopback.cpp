@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include "rmw/rmw.h"
+#include "rmw/init.h"
+#include "test_msgs/msg/arrays.hpp"
+#include "test_msgs/msg/strings.hpp"
+#include "test_msgs/msg/unbounded_sequences.hpp"
+#include "test_msgs/msg/detail/arrays__rosidl_typesupport_introspection_cpp.hpp"
+#include "test_msgs/msg/detail/strings__rosidl_typesupport_introspection_cpp.hpp"
+#include "test_msgs/msg/detail/unbounded_sequences__rosidl_typesupport_introspection_cpp.hpp"
+
+namespace {
+
+template <typename MessageT>
+const rosidl_message_type_support_t * type_support();
+
+template <>
+const rosidl_message_type_support_t * type_support<test_msgs::msg::Strings>() {
+  return ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(
+    rosidl_typesupport_introspection_cpp, test_msgs, msg, Strings)();
+}
+
+template <>
+const rosidl_message_type_support_t * type_support<test_msgs::msg::Arrays>() {
+  return ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(
+    rosidl_typesupport_introspection_cpp, test_msgs, msg, Arrays)();
+}
+
+template <>
+const rosidl_message_type_support_t *
+type_support<test_msgs::msg::UnboundedSequences>() {
+  return ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(
+    rosidl_typesupport_introspection_cpp, test_msgs, msg, UnboundedSequences)();
+}
+
+class TestLoopback : public ::testing::Test {
+protected:
+  void SetUp() override {
+    setenv("RMW_INTROSPECT_LOOPBACK", "1", 1);
+    options = rmw_get_zero_initialized_init_options();
+    context = rmw_get_zero_initialized_context();
+    ASSERT_EQ(rmw_init_options_init(&options, rcutils_get_default_allocator()), RMW_RET_OK);
+    ASSERT_EQ(rmw_init(&options, &context), RMW_RET_OK);
+    node = rmw_create_node(&context, "loopback_node", "/");
+    ASSERT_NE(node, nullptr);
+  }
+
+  void TearDown() override {
+    rmw_destroy_node(node);
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&options);
+    unsetenv("RMW_INTROSPECT_LOOPBACK");
+  }
+
+  template <typename MessageT>
+  rmw_publisher_t * create_publisher(
+    const char * topic, const rmw_qos_profile_t & qos = rmw_qos_profile_default) {
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    return rmw_create_publisher(node, type_support<MessageT>(), topic, &qos, &pub_options);
+  }
+
+  template <typename MessageT>
+  rmw_subscription_t * create_subscription(
+    const char * topic, const rmw_qos_profile_t & qos = rmw_qos_profile_default) {
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    return rmw_create_subscription(node, type_support<MessageT>(), topic, &qos, &sub_options);
+  }
+
+  rmw_init_options_t options;
+  rmw_context_t context;
+  rmw_node_t * node = nullptr;
+};
+
+}  // namespace
+
+// A published message is taken, deep-copied, by a subscription of the process
+TEST_F(TestLoopback, PublishTake) {
+  auto * pub = create_publisher<test_msgs::msg::Strings>("/chatter");
+  auto * sub = create_subscription<test_msgs::msg::Strings>("/chatter");
+  ASSERT_NE(pub, nullptr);
+  ASSERT_NE(sub, nullptr);
+
+  test_msgs::msg::Strings sent;
+  sent.string_value = std::string(1000, 'x');
+  sent.bounded_string_value = "bounded";
+  ASSERT_EQ(rmw_publish(pub, &sent, nullptr), RMW_RET_OK);
+  sent.string_value = "changed after publish";
+
+  test_msgs::msg::Strings received;
+  bool taken = false;
+  rmw_message_info_t info = rmw_get_zero_initialized_message_info();
+  ASSERT_EQ(rmw_take_with_info(sub, &received, &taken, &info, nullptr), RMW_RET_OK);
+  EXPECT_TRUE(taken);
+  EXPECT_EQ(received.string_value, std::string(1000, 'x'));
+  EXPECT_EQ(received.bounded_string_value, "bounded");
+  EXPECT_GT(info.source_timestamp, 0);
+
+  // Each message is taken once
+  ASSERT_EQ(rmw_take(sub, &received, &taken, nullptr), RMW_RET_OK);
+  EXPECT_FALSE(taken);
+
+  rmw_destroy_subscription(node, sub);
+  rmw_destroy_publisher(node, pub);
+}
+
+// Arrays, sequences (including std::vector<bool>) and nested messages copy
+TEST_F(TestLoopback, CopiesEveryFieldKind) {
+  auto * array_pub = create_publisher<test_msgs::msg::Arrays>("/arrays");
+  auto * array_sub = create_subscription<test_msgs::msg::Arrays>("/arrays");
+  auto * seq_pub = create_publisher<test_msgs::msg::UnboundedSequences>("/sequences");
+  auto * seq_sub = create_subscription<test_msgs::msg::UnboundedSequences>("/sequences");
+  ASSERT_NE(array_pub, nullptr);
+  ASSERT_NE(array_sub, nullptr);
+  ASSERT_NE(seq_pub, nullptr);
+  ASSERT_NE(seq_sub, nullptr);
+
+  test_msgs::msg::Arrays arrays;
+  arrays.bool_values = {true, false, true};
+  arrays.int64_values = {-1, 0, 1};
+  arrays.string_values = {"a", "bb", "ccc"};
+  arrays.basic_types_values[1].float64_value = 2.5;
+  ASSERT_EQ(rmw_publish(array_pub, &arrays, nullptr), RMW_RET_OK);
+
+  test_msgs::msg::UnboundedSequences sequences;
+  sequences.bool_values = {true, true, false, true};
+  sequences.uint8_values = {1, 2, 3};
+  sequences.string_values = {"x", "yy"};
+  sequences.basic_types_values.resize(2);
+  sequences.basic_types_values[1].int32_value = 42;
+  ASSERT_EQ(rmw_publish(seq_pub, &sequences, nullptr), RMW_RET_OK);
+
+  test_msgs::msg::Arrays arrays_out;
+  test_msgs::msg::UnboundedSequences sequences_out;
+  sequences_out.string_values = {"stale", "values", "dropped"};
+  bool taken = false;
+  ASSERT_EQ(rmw_take(array_sub, &arrays_out, &taken, nullptr), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  ASSERT_EQ(rmw_take(seq_sub, &sequences_out, &taken, nullptr), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(arrays_out, arrays);
+  EXPECT_EQ(sequences_out, sequences);
+
+  rmw_destroy_subscription(node, seq_sub);
+  rmw_destroy_publisher(node, seq_pub);
+  rmw_destroy_subscription(node, array_sub);
+  rmw_destroy_publisher(node, array_pub);
+}
+
+// KEEP_LAST depth drops the oldest messages; other topics and types see none
+TEST_F(TestLoopback, DepthAndMatching) {
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.depth = 2;
+  auto * pub = create_publisher<test_msgs::msg::Strings>("/counter");
+  auto * sub = create_subscription<test_msgs::msg::Strings>("/counter", qos);
+  auto * other_topic = create_subscription<test_msgs::msg::Strings>("/other");
+  auto * other_type = create_subscription<test_msgs::msg::Arrays>("/counter");
+  ASSERT_NE(pub, nullptr);
+  ASSERT_NE(sub, nullptr);
+  ASSERT_NE(other_topic, nullptr);
+  ASSERT_NE(other_type, nullptr);
+
+  test_msgs::msg::Strings msg;
+  for (int i = 0; i < 5; ++i) {
+    msg.string_value = std::to_string(i);
+    ASSERT_EQ(rmw_publish(pub, &msg, nullptr), RMW_RET_OK);
+  }
+
+  bool taken = false;
+  ASSERT_EQ(rmw_take(sub, &msg, &taken, nullptr), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(msg.string_value, "3");
+  ASSERT_EQ(rmw_take(sub, &msg, &taken, nullptr), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(msg.string_value, "4");
+  ASSERT_EQ(rmw_take(sub, &msg, &taken, nullptr), RMW_RET_OK);
+  EXPECT_FALSE(taken);
+
+  ASSERT_EQ(rmw_take(other_topic, &msg, &taken, nullptr), RMW_RET_OK);
+  EXPECT_FALSE(taken);
+  test_msgs::msg::Arrays arrays;
+  ASSERT_EQ(rmw_take(other_type, &arrays, &taken, nullptr), RMW_RET_OK);
+  EXPECT_FALSE(taken);
+
+  rmw_destroy_subscription(node, other_type);
+  rmw_destroy_subscription(node, other_topic);
+  rmw_destroy_subscription(node, sub);
+  rmw_destroy_publisher(node, pub);
+}
+
+// Late transient local subscriptions get retained messages, volatile ones not
+TEST_F(TestLoopback, TransientLocal) {
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.depth = 1;
+  qos.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+  auto * pub = create_publisher<test_msgs::msg::Strings>("/latched", qos);
+  ASSERT_NE(pub, nullptr);
+
+  test_msgs::msg::Strings msg;
+  msg.string_value = "retained";
+  ASSERT_EQ(rmw_publish(pub, &msg, nullptr), RMW_RET_OK);
+
+  auto * late = create_subscription<test_msgs::msg::Strings>("/latched", qos);
+  auto * late_volatile = create_subscription<test_msgs::msg::Strings>("/latched");
+  ASSERT_NE(late, nullptr);
+  ASSERT_NE(late_volatile, nullptr);
+
+  test_msgs::msg::Strings received;
+  bool taken = false;
+  ASSERT_EQ(rmw_take(late, &received, &taken, nullptr), RMW_RET_OK);
+  EXPECT_TRUE(taken);
+  EXPECT_EQ(received.string_value, "retained");
+  ASSERT_EQ(rmw_take(late_volatile, &received, &taken, nullptr), RMW_RET_OK);
+  EXPECT_FALSE(taken);
+
+  rmw_destroy_subscription(node, late_volatile);
+  rmw_destroy_subscription(node, late);
+  rmw_destroy_publisher(node, pub);
+}
+
+// rmw_wait reports readable subscriptions, and a publish wakes a blocked wait
+TEST_F(TestLoopback, WaitWakesOnPublish) {
+  auto * pub = create_publisher<test_msgs::msg::Strings>("/wake");
+  auto * sub = create_subscription<test_msgs::msg::Strings>("/wake");
+  ASSERT_NE(pub, nullptr);
+  ASSERT_NE(sub, nullptr);
+  rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, 1);
+  ASSERT_NE(wait_set, nullptr);
+
+  void * entries[] = {sub->data};
+  rmw_subscriptions_t subscriptions{1, entries};
+  rmw_time_t zero{0, 0};
+  EXPECT_EQ(
+    rmw_wait(&subscriptions, nullptr, nullptr, nullptr, nullptr, wait_set, &zero),
+    RMW_RET_TIMEOUT);
+  EXPECT_EQ(entries[0], nullptr);
+
+  std::thread publisher([pub]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      test_msgs::msg::Strings msg;
+      msg.string_value = "wake up";
+      rmw_publish(pub, &msg, nullptr);
+    });
+  entries[0] = sub->data;
+  rmw_time_t timeout{5, 0};
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(
+    rmw_wait(&subscriptions, nullptr, nullptr, nullptr, nullptr, wait_set, &timeout),
+    RMW_RET_OK);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+  EXPECT_EQ(entries[0], sub->data);
+  publisher.join();
+
+  rmw_destroy_wait_set(wait_set);
+  rmw_destroy_subscription(node, sub);
+  rmw_destroy_publisher(node, pub);
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/init.h"
 #include "std_msgs/msg/string.hpp"
@@ -149,6 +150,31 @@ TEST(TestPhase1, SubscriptionCreation) {
   rmw_init_options_fini(&options);
 }
 
+// Hot calls reject handles this layer did not create before dispatching
+TEST(TestPhase1, RejectsForeignHandles) {
+  std_msgs::msg::String msg;
+  bool taken = false;
+
+  rmw_publisher_t publisher{};
+  publisher.implementation_identifier = "other_rmw";
+  EXPECT_EQ(rmw_publish(&publisher, &msg, nullptr),
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rmw_reset_error();
+  publisher.implementation_identifier = rmw_get_implementation_identifier();
+  EXPECT_EQ(rmw_publish(&publisher, &msg, nullptr), RMW_RET_ERROR);
+  rmw_reset_error();
+
+  rmw_subscription_t subscription{};
+  subscription.implementation_identifier = "other_rmw";
+  EXPECT_EQ(rmw_take(&subscription, &msg, &taken, nullptr),
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rmw_reset_error();
+  subscription.implementation_identifier = rmw_get_implementation_identifier();
+  EXPECT_EQ(rmw_take(&subscription, &msg, &taken, nullptr), RMW_RET_ERROR);
+  rmw_reset_error();
+  EXPECT_FALSE(taken);
+}
+
 int main(int argc, char ** argv) {
   // Clear introspection data before tests
   rmw_introspect::IntrospectionData::instance().clear();
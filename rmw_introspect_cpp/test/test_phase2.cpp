@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/init.h"
 #include "std_srvs/srv/set_bool.hpp"
@@ -112,6 +113,45 @@ TEST(TestPhase2, ClientCreation) {
   rmw_init_options_fini(&options);
 }
 
+// Recording-only mode has no service transport, so a server is never
+// reported available, even one in the same process
+TEST(TestPhase2, ServiceServerNeverAvailable) {
+  rmw_init_options_t options = rmw_get_zero_initialized_init_options();
+  rmw_context_t context = rmw_get_zero_initialized_context();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  rmw_init_options_init(&options, allocator);
+  rmw_init(&options, &context);
+
+  rmw_node_t * node = rmw_create_node(&context, "avail_node", "/");
+  ASSERT_NE(node, nullptr);
+
+  const rosidl_service_type_support_t * type_support =
+    ROSIDL_TYPESUPPORT_INTERFACE__SERVICE_SYMBOL_NAME(
+      rosidl_typesupport_introspection_cpp, std_srvs, srv, SetBool)();
+  rmw_qos_profile_t qos = rmw_qos_profile_services_default;
+
+  rmw_service_t * service = rmw_create_service(
+    node, type_support, "/avail_service", &qos);
+  ASSERT_NE(service, nullptr);
+  rmw_client_t * client = rmw_create_client(
+    node, type_support, "/avail_service", &qos);
+  ASSERT_NE(client, nullptr);
+
+  bool is_available = true;
+  EXPECT_EQ(rmw_service_server_is_available(node, client, &is_available),
+    RMW_RET_OK);
+  EXPECT_FALSE(is_available);
+
+  // Clean up
+  rmw_destroy_client(node, client);
+  rmw_destroy_service(node, service);
+  rmw_destroy_node(node);
+  rmw_shutdown(&context);
+  rmw_context_fini(&context);
+  rmw_init_options_fini(&options);
+}
+
 // Test wait set creation and rmw_wait timeout
 TEST(TestPhase2, WaitOperations) {
   rmw_init_options_t options = rmw_get_zero_initialized_init_options();
@@ -125,17 +165,42 @@ TEST(TestPhase2, WaitOperations) {
   rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, 10);
   ASSERT_NE(wait_set, nullptr);
 
-  // Test rmw_wait - should return timeout immediately
+  // Test rmw_wait - blocks for the timeout instead of spinning
   auto start = std::chrono::steady_clock::now();
 
-  rmw_time_t timeout{1, 0};  // 1 second timeout
+  rmw_time_t timeout{0, 100000000};  // 100 ms timeout
   rmw_ret_t ret = rmw_wait(nullptr, nullptr, nullptr, nullptr, nullptr, wait_set, &timeout);
 
   auto end = std::chrono::steady_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
   EXPECT_EQ(ret, RMW_RET_TIMEOUT);
-  EXPECT_LT(duration, 100);  // Should return in <100ms, not wait full timeout
+  EXPECT_GE(duration, 90);
+  EXPECT_LT(duration, 1000);
+
+  // A triggered guard condition ends the wait early
+  rmw_guard_condition_t * guard_condition = rmw_create_guard_condition(&context);
+  ASSERT_NE(guard_condition, nullptr);
+  void * gc_entries[] = {guard_condition->data};
+  rmw_guard_conditions_t guard_conditions{1, gc_entries};
+  EXPECT_EQ(rmw_trigger_guard_condition(guard_condition), RMW_RET_OK);
+
+  start = std::chrono::steady_clock::now();
+  timeout = rmw_time_t{5, 0};
+  ret = rmw_wait(nullptr, &guard_conditions, nullptr, nullptr, nullptr, wait_set, &timeout);
+  duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(ret, RMW_RET_OK);
+  EXPECT_LT(duration, 1000);
+  EXPECT_EQ(gc_entries[0], guard_condition->data);
+
+  // The wait took the trigger
+  timeout = rmw_time_t{0, 0};
+  ret = rmw_wait(nullptr, &guard_conditions, nullptr, nullptr, nullptr, wait_set, &timeout);
+  EXPECT_EQ(ret, RMW_RET_TIMEOUT);
+  EXPECT_EQ(gc_entries[0], nullptr);
+  rmw_destroy_guard_condition(guard_condition);
 
   // Clean up
   rmw_destroy_wait_set(wait_set);
@@ -144,6 +209,17 @@ TEST(TestPhase2, WaitOperations) {
   rmw_init_options_fini(&options);
 }
 
+// A wait set from another implementation is rejected, not dereferenced
+TEST(TestPhase2, WaitRejectsForeignWaitSet) {
+  rmw_wait_set_t wait_set{};
+  wait_set.implementation_identifier = "other_rmw";
+  rmw_time_t timeout{0, 0};
+  EXPECT_EQ(
+    rmw_wait(nullptr, nullptr, nullptr, nullptr, nullptr, &wait_set, &timeout),
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rmw_reset_error();
+}
+
 // Test guard condition
 TEST(TestPhase2, GuardCondition) {
   rmw_init_options_t options = rmw_get_zero_initialized_init_options();
@@ -157,10 +233,21 @@ TEST(TestPhase2, GuardCondition) {
   rmw_guard_condition_t * guard_condition = rmw_create_guard_condition(&context);
   ASSERT_NE(guard_condition, nullptr);
 
-  // Trigger guard condition (no-op)
+  ASSERT_NE(guard_condition->data, nullptr);
+
+  // Trigger guard condition, which a wait on it then reports
   rmw_ret_t ret = rmw_trigger_guard_condition(guard_condition);
   EXPECT_EQ(ret, RMW_RET_OK);
 
+  rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, 10);
+  ASSERT_NE(wait_set, nullptr);
+  void * gc_entries[] = {guard_condition->data};
+  rmw_guard_conditions_t guard_conditions{1, gc_entries};
+  ret = rmw_wait(nullptr, &guard_conditions, nullptr, nullptr, nullptr, wait_set, nullptr);
+  EXPECT_EQ(ret, RMW_RET_OK);
+  EXPECT_EQ(gc_entries[0], guard_condition->data);
+  rmw_destroy_wait_set(wait_set);
+
   // Clean up
   rmw_destroy_guard_condition(guard_condition);
   rmw_shutdown(&context);
@@ -11,6 +11,9 @@
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
 #include "rcutils/types/string_array.h"
+#include "rmw/error_handling.h"
+#include "rmw_introspect/recording_wait.hpp"
+#include <string>
 
 // Test graph query functions
 TEST(TestPhase3, CountPublishers) {
@@ -75,8 +78,10 @@ TEST(TestPhase3, GetNodeNames) {
 
   rmw_ret_t ret = rmw_get_node_names(node, &node_names, &node_namespaces);
   EXPECT_EQ(ret, RMW_RET_OK);
-  EXPECT_EQ(node_names.size, 0u);  // Should return empty
-  EXPECT_EQ(node_namespaces.size, 0u);
+  ASSERT_EQ(node_names.size, 1u);  // The recorded node
+  ASSERT_EQ(node_namespaces.size, 1u);
+  EXPECT_EQ(std::string(node_names.data[0]), "test_node");
+  EXPECT_EQ(std::string(node_namespaces.data[0]), "/");
 
   // Clean up
   rcutils_string_array_fini(&node_names);
@@ -113,6 +118,69 @@ TEST(TestPhase3, GetTopicNamesAndTypes) {
   rmw_init_options_fini(&options);
 }
 
+TEST(TestPhase3, NamesAndTypesByNode) {
+  rmw_init_options_t options = rmw_get_zero_initialized_init_options();
+  rmw_context_t context = rmw_get_zero_initialized_context();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  rmw_init_options_init(&options, allocator);
+  rmw_init(&options, &context);
+
+  rmw_node_t * node = rmw_create_node(&context, "test_node", "/");
+  ASSERT_NE(node, nullptr);
+
+  // A recorded node without publishers
+  rmw_names_and_types_t names_and_types = rmw_get_zero_initialized_names_and_types();
+  rmw_ret_t ret = rmw_get_publisher_names_and_types_by_node(
+    node, &allocator, "test_node", "/", false, &names_and_types);
+  EXPECT_EQ(ret, RMW_RET_OK);
+  EXPECT_EQ(names_and_types.names.size, 0u);
+  rmw_names_and_types_fini(&names_and_types);
+
+  // A node that was never created
+  names_and_types = rmw_get_zero_initialized_names_and_types();
+  ret = rmw_get_publisher_names_and_types_by_node(
+    node, &allocator, "missing_node", "/", false, &names_and_types);
+  EXPECT_EQ(ret, RMW_RET_NODE_NAME_NON_EXISTENT);
+  rmw_reset_error();
+
+  // Clean up
+  rmw_destroy_node(node);
+  rmw_shutdown(&context);
+  rmw_context_fini(&context);
+  rmw_init_options_fini(&options);
+}
+
+TEST(TestPhase3, GraphGuardCondition) {
+  rmw_init_options_t options = rmw_get_zero_initialized_init_options();
+  rmw_context_t context = rmw_get_zero_initialized_context();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  rmw_init_options_init(&options, allocator);
+  rmw_init(&options, &context);
+
+  rmw_node_t * node = rmw_create_node(&context, "test_node", "/");
+  ASSERT_NE(node, nullptr);
+  const rmw_guard_condition_t * gc = rmw_node_get_graph_guard_condition(node);
+  ASSERT_NE(gc, nullptr);
+  auto * graph = static_cast<rmw_introspect::RecordingGuardCondition *>(gc->data);
+  graph->take();
+
+  // Creating and destroying another node changes the graph
+  rmw_node_t * other = rmw_create_node(&context, "other_node", "/");
+  ASSERT_NE(other, nullptr);
+  EXPECT_TRUE(graph->take());
+  rmw_destroy_node(other);
+  EXPECT_TRUE(graph->take());
+  EXPECT_FALSE(graph->take());
+
+  // Clean up
+  rmw_destroy_node(node);
+  rmw_shutdown(&context);
+  rmw_context_fini(&context);
+  rmw_init_options_fini(&options);
+}
+
 // Test serialization functions (no-ops)
 TEST(TestPhase3, Serialization) {
   // Test serialize - should succeed as no-op
@@ -9,6 +9,8 @@
 #include "rmw/names_and_types.h"
 #include "rmw_introspect/identifier.hpp"
 
+#include "rosidl_runtime_c/sequence_bound.h"
+#include "std_msgs/msg/int32.hpp"
 #include "std_msgs/msg/string.hpp"
 #include "std_srvs/srv/empty.hpp"
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
@@ -166,36 +168,122 @@ TEST_F(Phase4StubTest, GetSubscriptionsInfoByTopic)
 
 TEST_F(Phase4StubTest, InitPublisherAllocation)
 {
-  rmw_publisher_allocation_t allocation;
+  rmw_publisher_allocation_t allocation{nullptr, nullptr};
   rmw_ret_t ret = rmw_init_publisher_allocation(nullptr, nullptr, &allocation);
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, ret);
+  rmw_reset_error();
+
+  // Recording-only mode emulates the allocation from introspection data;
+  // a bounded type needs no bounds
+  auto type_support = rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::Int32>();
+  ret = rmw_init_publisher_allocation(type_support, nullptr, &allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
+  EXPECT_EQ(rmw_introspect_cpp_identifier, allocation.implementation_identifier);
+  EXPECT_NE(nullptr, allocation.data);
+
+  ret = rmw_fini_publisher_allocation(&allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
+  EXPECT_EQ(nullptr, allocation.data);
+}
+
+TEST_F(Phase4StubTest, InitPublisherAllocationUnbounded)
+{
+  // std_msgs/String has an unbounded string, which cannot be preallocated
+  // without bounds
+  auto type_support = rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::String>();
+  rmw_publisher_allocation_t allocation{nullptr, nullptr};
+  rmw_ret_t ret = rmw_init_publisher_allocation(type_support, nullptr, &allocation);
   EXPECT_EQ(RMW_RET_UNSUPPORTED, ret);
+  EXPECT_EQ(nullptr, allocation.implementation_identifier);
+  EXPECT_EQ(nullptr, allocation.data);
+  rmw_reset_error();
+
+  // With bounds it can
+  rosidl_runtime_c__Sequence__bound bounds{};
+  ret = rmw_init_publisher_allocation(type_support, &bounds, &allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
+  EXPECT_NE(nullptr, allocation.data);
+
+  ret = rmw_fini_publisher_allocation(&allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
 }
 
 TEST_F(Phase4StubTest, FiniPublisherAllocation)
 {
-  rmw_publisher_allocation_t allocation;
+  rmw_publisher_allocation_t allocation{nullptr, nullptr};
   rmw_ret_t ret = rmw_fini_publisher_allocation(&allocation);
-  EXPECT_EQ(RMW_RET_UNSUPPORTED, ret);
+  EXPECT_EQ(RMW_RET_INCORRECT_RMW_IMPLEMENTATION, ret);
+  rmw_reset_error();
 }
 
 TEST_F(Phase4StubTest, InitSubscriptionAllocation)
 {
-  rmw_subscription_allocation_t allocation;
+  rmw_subscription_allocation_t allocation{nullptr, nullptr};
   rmw_ret_t ret = rmw_init_subscription_allocation(nullptr, nullptr, &allocation);
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, ret);
+  rmw_reset_error();
+
+  auto type_support = rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::Int32>();
+  ret = rmw_init_subscription_allocation(type_support, nullptr, &allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
+  EXPECT_EQ(rmw_introspect_cpp_identifier, allocation.implementation_identifier);
+  EXPECT_NE(nullptr, allocation.data);
+
+  ret = rmw_fini_subscription_allocation(&allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
+  EXPECT_EQ(nullptr, allocation.data);
+}
+
+TEST_F(Phase4StubTest, InitSubscriptionAllocationUnbounded)
+{
+  auto type_support = rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::String>();
+  rmw_subscription_allocation_t allocation{nullptr, nullptr};
+  rmw_ret_t ret = rmw_init_subscription_allocation(type_support, nullptr, &allocation);
   EXPECT_EQ(RMW_RET_UNSUPPORTED, ret);
+  EXPECT_EQ(nullptr, allocation.data);
+  rmw_reset_error();
+
+  rosidl_runtime_c__Sequence__bound bounds{};
+  ret = rmw_init_subscription_allocation(type_support, &bounds, &allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
+  EXPECT_NE(nullptr, allocation.data);
+
+  ret = rmw_fini_subscription_allocation(&allocation);
+  EXPECT_EQ(RMW_RET_OK, ret);
 }
 
 TEST_F(Phase4StubTest, FiniSubscriptionAllocation)
 {
-  rmw_subscription_allocation_t allocation;
+  rmw_subscription_allocation_t allocation{nullptr, nullptr};
   rmw_ret_t ret = rmw_fini_subscription_allocation(&allocation);
-  EXPECT_EQ(RMW_RET_UNSUPPORTED, ret);
+  EXPECT_EQ(RMW_RET_INCORRECT_RMW_IMPLEMENTATION, ret);
+  rmw_reset_error();
 }
 
 TEST_F(Phase4StubTest, PublishLoanedMessage)
 {
   rmw_ret_t ret = rmw_publish_loaned_message(nullptr, nullptr, nullptr);
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, ret);
+  rmw_reset_error();
+
+  auto type_support = rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::String>();
+  rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+  auto publisher = rmw_create_publisher(
+    node_,
+    type_support,
+    "test_topic",
+    &rmw_qos_profile_default,
+    &pub_options);
+  ASSERT_NE(nullptr, publisher);
+  EXPECT_FALSE(publisher->can_loan_messages);
+
+  // Recording-only mode has no middleware to loan from
+  std_msgs::msg::String msg;
+  ret = rmw_publish_loaned_message(publisher, &msg, nullptr);
   EXPECT_EQ(RMW_RET_UNSUPPORTED, ret);
+
+  ret = rmw_destroy_publisher(node_, publisher);
+  EXPECT_EQ(RMW_RET_OK, ret);
 }
 
 // ============================================================================
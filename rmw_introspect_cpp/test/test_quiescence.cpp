@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/mode.hpp"
+#include "rmw_introspect/quiescence.hpp"
+#include "rmw_introspect/real_rmw.hpp"
+#include "rmw_introspect/stats.hpp"
+
+using rmw_introspect::IntrospectionData;
+using rmw_introspect::QuiescenceMonitor;
+using rmw_introspect::QuiescenceOptions;
+using rmw_introspect::QuietReason;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Read one byte from `fd` within `timeout_ms`
+/// @return the byte, 0 on end of file, -1 on timeout
+int read_ready(int fd, int timeout_ms) {
+  pollfd pfd = {fd, POLLIN, 0};
+  if (::poll(&pfd, 1, timeout_ms) <= 0) {
+    return -1;
+  }
+  char byte = 0;
+  return ::read(fd, &byte, 1) == 1 ? byte : 0;
+}
+
+QuiescenceOptions options(std::chrono::milliseconds window, int ready_fd) {
+  QuiescenceOptions options;
+  options.window = window;
+  options.ready_fd = ready_fd;
+  return options;
+}
+
+}  // namespace
+
+// Nothing happens before the first wait; after it the export runs once and
+// the pipe gets one byte and is closed
+TEST(TestQuiescence, SignalsAfterFirstWait) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  auto & monitor = QuiescenceMonitor::instance();
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  std::atomic<int> exports{0};
+  ASSERT_TRUE(monitor.start(options(20ms, fds[1]),
+    [&exports](QuietReason reason) {
+      EXPECT_EQ(reason, QuietReason::Quiet);
+      ++exports;
+      return true;
+    }));
+  EXPECT_FALSE(monitor.start(options(20ms, -1), nullptr));
+
+  data.record_node("talker", "/");
+  EXPECT_EQ(read_ready(fds[0], 100), -1);
+  EXPECT_EQ(exports.load(), 0);
+
+  monitor.notify_wait();
+  EXPECT_EQ(read_ready(fds[0], 2000), '1');
+  EXPECT_EQ(exports.load(), 1);
+  EXPECT_TRUE(monitor.signalled());
+  EXPECT_EQ(read_ready(fds[0], 2000), 0);
+
+  monitor.notify_wait();
+  monitor.stop();
+  EXPECT_EQ(exports.load(), 1);
+  ::close(fds[0]);
+  data.clear();
+}
+
+// Entities created after the first wait push the signal back
+TEST(TestQuiescence, ChangesExtendWindow) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  auto & monitor = QuiescenceMonitor::instance();
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  std::atomic<int64_t> exported_ns{0};
+  ASSERT_TRUE(monitor.start(options(60ms, fds[1]),
+    [&exported_ns](QuietReason) {
+      exported_ns = rmw_introspect::steady_time_ns();
+      return true;
+    }));
+  monitor.notify_wait();
+
+  for (int i = 0; i < 8; ++i) {
+    data.record_node("node_" + std::to_string(i), "/");
+    std::this_thread::sleep_for(15ms);
+    EXPECT_FALSE(monitor.signalled());
+  }
+
+  EXPECT_EQ(read_ready(fds[0], 2000), '1');
+  EXPECT_GE(exported_ns.load() - data.last_change_ns(), 60000000);
+
+  monitor.stop();
+  ::close(fds[0]);
+  data.clear();
+}
+
+// Stopping before the node goes quiet closes the pipe without a signal
+TEST(TestQuiescence, StopClosesPipe) {
+  auto & monitor = QuiescenceMonitor::instance();
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  std::atomic<int> exports{0};
+  ASSERT_TRUE(monitor.start(options(10s, fds[1]),
+    [&exports](QuietReason) {++exports; return true;}));
+  monitor.notify_wait();
+  monitor.stop();
+
+  EXPECT_EQ(read_ready(fds[0], 2000), 0);
+  EXPECT_EQ(exports.load(), 0);
+  EXPECT_FALSE(monitor.signalled());
+  ::close(fds[0]);
+}
+
+// A ready fd that is not a pipe is left alone, and the variable is not passed
+// on to spawned processes
+TEST(TestQuiescence, IgnoresNonPipeReadyFd) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  auto & monitor = QuiescenceMonitor::instance();
+
+  char path[] = "/tmp/test_quiescence_XXXXXX";
+  int fd = ::mkstemp(path);
+  ASSERT_GE(fd, 0);
+  ::unlink(path);
+  setenv("RMW_INTROSPECT_READY_FD", std::to_string(fd).c_str(), 1);
+  setenv("RMW_INTROSPECT_QUIESCENCE_MS", "10", 1);
+  std::atomic<int> exports{0};
+  ASSERT_TRUE(rmw_introspect::start_quiescence_from_env(
+    [&exports](QuietReason) {++exports; return true;}));
+  EXPECT_EQ(std::getenv("RMW_INTROSPECT_READY_FD"), nullptr);
+  unsetenv("RMW_INTROSPECT_QUIESCENCE_MS");
+
+  monitor.notify_wait();
+  for (int i = 0; i < 200 && !monitor.signalled(); ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(exports.load(), 1);
+  monitor.stop();
+
+  // Still open, and nothing was written to it
+  EXPECT_EQ(::lseek(fd, 0, SEEK_END), 0);
+  EXPECT_EQ(::close(fd), 0);
+  data.clear();
+}
+
+// A node that never waits is still exported once the deadline passes
+TEST(TestQuiescence, DeadlineWithoutWait) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  auto & monitor = QuiescenceMonitor::instance();
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  std::atomic<int> deadlines{0};
+  QuiescenceOptions deadline = options(10s, fds[1]);
+  deadline.deadline = 50ms;
+  ASSERT_TRUE(monitor.start(deadline, [&deadlines](QuietReason reason) {
+      deadlines += reason == QuietReason::Deadline;
+      return false;
+    }));
+
+  data.record_node("talker", "/");
+  EXPECT_EQ(read_ready(fds[0], 2000), '0');
+  EXPECT_EQ(deadlines.load(), 1);
+
+  monitor.stop();
+  ::close(fds[0]);
+  data.clear();
+}
+
+// Exiting after the export reports how the node finished
+TEST(TestQuiescenceDeathTest, ExitStatus) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  auto run = [&data](bool record, bool wait, bool exported) {
+      if (record) {
+        data.record_node("talker", "/");
+      }
+      QuiescenceOptions exit_options = options(10ms, -1);
+      exit_options.deadline = 200ms;
+      exit_options.exit_after_export = true;
+      QuiescenceMonitor::instance().start(exit_options,
+        [exported](QuietReason) {return exported;});
+      if (wait) {
+        QuiescenceMonitor::instance().notify_wait();
+      }
+      std::this_thread::sleep_for(10s);
+    };
+
+  EXPECT_EXIT(run(true, true, true), ::testing::ExitedWithCode(
+      rmw_introspect::kExitExported), "");
+  EXPECT_EXIT(run(true, false, true), ::testing::ExitedWithCode(
+      rmw_introspect::kExitDeadline), "");
+  EXPECT_EXIT(run(false, false, true), ::testing::ExitedWithCode(
+      rmw_introspect::kExitNoNode), "");
+  EXPECT_EXIT(run(true, true, false), ::testing::ExitedWithCode(
+      rmw_introspect::kExitExportFailed), "");
+  data.clear();
+}
+
+// Only recording-only nodes exit: an intermediate node would skip the real
+// RMW's shutdown, so it exports and keeps running
+TEST(TestQuiescenceDeathTest, ExitOnlyWhenRecordingOnly) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  constexpr int kKeptRunning = 42;
+  auto run = [](bool intermediate) {
+      rmw_introspect::RealRMW real_rmw;
+      if (intermediate) {
+        rmw_introspect::internal::g_real_rmw = &real_rmw;
+      }
+      setenv("RMW_INTROSPECT_EXIT_ON_EXPORT", "1", 1);
+      setenv("RMW_INTROSPECT_DEADLINE_MS", "10", 1);
+      std::atomic<bool> exported{false};
+      rmw_introspect::start_quiescence_from_env(
+        [&exported](QuietReason) {
+          exported = true;
+          return true;
+        });
+      for (int i = 0; i < 200 && !exported; ++i) {
+        std::this_thread::sleep_for(10ms);
+      }
+      // Leave the monitor time to exit if it were going to
+      std::this_thread::sleep_for(200ms);
+      ::_exit(exported ? kKeptRunning : 1);
+    };
+
+  EXPECT_EXIT(run(false), ::testing::ExitedWithCode(
+      rmw_introspect::kExitNoNode), "");
+  EXPECT_EXIT(run(true), ::testing::ExitedWithCode(kKeptRunning), "");
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
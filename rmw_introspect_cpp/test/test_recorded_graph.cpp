@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "rmw_introspect/recorded_graph.hpp"
+
+using rmw_introspect::EntityKind;
+using rmw_introspect::NamesAndTypes;
+using rmw_introspect::RecordedGraph;
+
+namespace {
+
+NamesAndTypes entry(const std::string & name, std::vector<std::string> types) {
+  return {{name, std::move(types)}};
+}
+
+}  // namespace
+
+// Endpoints are counted per topic and kind, and leave no trace once removed
+TEST(TestRecordedGraph, CountsEndpoints) {
+  auto & graph = RecordedGraph::instance();
+  const auto node = graph.add_node("talker", "/");
+  const auto pub1 = graph.add_endpoint(
+    EntityKind::Publisher, "talker", "/", "/chatter", "std_msgs/msg/String");
+  const auto pub2 = graph.add_endpoint(
+    EntityKind::Publisher, "talker", "/", "/chatter", "std_msgs/msg/String");
+  const auto sub = graph.add_endpoint(
+    EntityKind::Subscription, "talker", "/", "/chatter", "std_msgs/msg/String");
+  ASSERT_NE(pub1, 0u);
+  ASSERT_NE(pub2, pub1);
+
+  EXPECT_EQ(graph.count(EntityKind::Publisher, "/chatter"), 2u);
+  EXPECT_EQ(graph.count(EntityKind::Subscription, "/chatter"), 1u);
+  EXPECT_EQ(graph.count(EntityKind::Publisher, "/other"), 0u);
+  EXPECT_EQ(graph.topic_names_and_types(),
+    entry("/chatter", {"std_msgs/msg/String"}));
+
+  graph.remove(pub1);
+  EXPECT_EQ(graph.count(EntityKind::Publisher, "/chatter"), 1u);
+  graph.remove(pub2);
+  graph.remove(sub);
+  graph.remove(node);
+  EXPECT_EQ(graph.count(EntityKind::Publisher, "/chatter"), 0u);
+  EXPECT_TRUE(graph.topic_names_and_types().empty());
+  EXPECT_TRUE(graph.node_names().empty());
+
+  // Unknown and repeated ids are ignored
+  graph.remove(0);
+  graph.remove(pub1);
+}
+
+// A topic lists each type in use once, sorted, until its last user leaves
+TEST(TestRecordedGraph, TopicTypes) {
+  auto & graph = RecordedGraph::instance();
+  const auto b = graph.add_endpoint(
+    EntityKind::Publisher, "n", "/", "/mixed", "pkg/msg/B");
+  const auto a1 = graph.add_endpoint(
+    EntityKind::Subscription, "n", "/", "/mixed", "pkg/msg/A");
+  const auto a2 = graph.add_endpoint(
+    EntityKind::Publisher, "n", "/", "/mixed", "pkg/msg/A");
+  const auto z = graph.add_endpoint(
+    EntityKind::Publisher, "n", "/", "/a_first", "pkg/msg/Z");
+
+  NamesAndTypes expected = {
+    {"/a_first", {"pkg/msg/Z"}}, {"/mixed", {"pkg/msg/A", "pkg/msg/B"}}};
+  EXPECT_EQ(graph.topic_names_and_types(), expected);
+
+  graph.remove(a1);
+  EXPECT_EQ(graph.topic_names_and_types(), expected);
+  graph.remove(a2);
+  graph.remove(z);
+  EXPECT_EQ(graph.topic_names_and_types(), entry("/mixed", {"pkg/msg/B"}));
+  graph.remove(b);
+  EXPECT_TRUE(graph.topic_names_and_types().empty());
+}
+
+// Services and clients are kept apart from topics
+TEST(TestRecordedGraph, Services) {
+  auto & graph = RecordedGraph::instance();
+  const auto server = graph.add_endpoint(
+    EntityKind::Service, "srv", "/ns", "/ns/set", "std_srvs/srv/SetBool");
+  const auto client = graph.add_endpoint(
+    EntityKind::Client, "cli", "/", "/ns/set", "std_srvs/srv/SetBool");
+
+  EXPECT_EQ(graph.count(EntityKind::Service, "/ns/set"), 1u);
+  EXPECT_EQ(graph.count(EntityKind::Client, "/ns/set"), 1u);
+  EXPECT_EQ(graph.count(EntityKind::Publisher, "/ns/set"), 0u);
+  EXPECT_TRUE(graph.topic_names_and_types().empty());
+  EXPECT_EQ(graph.service_names_and_types(),
+    entry("/ns/set", {"std_srvs/srv/SetBool"}));
+
+  graph.remove(server);
+  EXPECT_EQ(graph.count(EntityKind::Service, "/ns/set"), 0u);
+  graph.remove(client);
+  EXPECT_TRUE(graph.service_names_and_types().empty());
+}
+
+// Nodes are listed once per instance and answer for their own endpoints
+TEST(TestRecordedGraph, Nodes) {
+  auto & graph = RecordedGraph::instance();
+  const auto first = graph.add_node("dup", "/a");
+  const auto second = graph.add_node("dup", "/a");
+  const auto other = graph.add_node("dup", "/b");
+  const auto pub = graph.add_endpoint(
+    EntityKind::Publisher, "dup", "/a", "/a/out", "pkg/msg/T");
+  const auto cli = graph.add_endpoint(
+    EntityKind::Client, "dup", "/b", "/b/call", "pkg/srv/S");
+
+  auto names = graph.node_names();
+  std::sort(names.begin(), names.end());
+  const std::vector<std::pair<std::string, std::string>> expected = {
+    {"dup", "/a"}, {"dup", "/a"}, {"dup", "/b"}};
+  EXPECT_EQ(names, expected);
+  EXPECT_TRUE(graph.has_node("dup", "/b"));
+  EXPECT_FALSE(graph.has_node("dup", "/c"));
+
+  EXPECT_EQ(graph.names_and_types_by_node(EntityKind::Publisher, "dup", "/a"),
+    entry("/a/out", {"pkg/msg/T"}));
+  EXPECT_TRUE(
+    graph.names_and_types_by_node(EntityKind::Publisher, "dup", "/b").empty());
+  EXPECT_EQ(graph.names_and_types_by_node(EntityKind::Client, "dup", "/b"),
+    entry("/b/call", {"pkg/srv/S"}));
+
+  // A node removed before its endpoints no longer counts as a node
+  graph.remove(other);
+  EXPECT_FALSE(graph.has_node("dup", "/b"));
+  EXPECT_EQ(graph.names_and_types_by_node(EntityKind::Client, "dup", "/b"),
+    entry("/b/call", {"pkg/srv/S"}));
+  graph.remove(cli);
+
+  graph.remove(first);
+  EXPECT_TRUE(graph.has_node("dup", "/a"));
+  graph.remove(pub);
+  graph.remove(second);
+  EXPECT_TRUE(graph.node_names().empty());
+}
+
+// Every change triggers the graph guard condition
+TEST(TestRecordedGraph, TriggersGuardCondition) {
+  auto & graph = RecordedGraph::instance();
+  auto & gc = graph.guard_condition();
+  gc.take();
+
+  const auto node = graph.add_node("watched", "/");
+  EXPECT_TRUE(gc.take());
+  EXPECT_FALSE(gc.take());
+
+  const auto sub = graph.add_endpoint(
+    EntityKind::Subscription, "watched", "/", "/in", "pkg/msg/T");
+  EXPECT_TRUE(gc.take());
+  graph.remove(sub);
+  EXPECT_TRUE(gc.take());
+  graph.remove(node);
+  EXPECT_TRUE(gc.take());
+
+  // Nothing changes for an unknown id
+  graph.remove(sub);
+  EXPECT_FALSE(gc.take());
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
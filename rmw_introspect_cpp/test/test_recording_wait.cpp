@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "rmw_introspect/recording_wait.hpp"
+#include "rmw_introspect/wrappers.hpp"
+
+using rmw_introspect::RecordingEntity;
+using rmw_introspect::RecordingGuardCondition;
+using namespace std::chrono_literals;
+
+namespace {
+
+int64_t elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+// Untriggered waits block for their timeout and clear every entry
+TEST(TestRecordingWait, TimesOut) {
+  RecordingGuardCondition gc;
+  RecordingEntity sub(1);  // No loopback: never readable
+  void * sub_entries[] = {&sub};
+  void * gc_entries[] = {&gc};
+  rmw_subscriptions_t subscriptions{1, sub_entries};
+  rmw_guard_conditions_t guard_conditions{1, gc_entries};
+
+  const auto start = std::chrono::steady_clock::now();
+  rmw_time_t timeout{0, 50000000};
+  EXPECT_EQ(rmw_introspect::recording_only_wait(&subscriptions,
+    &guard_conditions, nullptr, nullptr, nullptr, nullptr, &timeout),
+    RMW_RET_TIMEOUT);
+  EXPECT_GE(elapsed_ms(start), 45);
+  EXPECT_EQ(sub_entries[0], nullptr);
+  EXPECT_EQ(gc_entries[0], nullptr);
+
+  // A zero timeout polls
+  const auto poll_start = std::chrono::steady_clock::now();
+  rmw_time_t zero{0, 0};
+  EXPECT_EQ(rmw_introspect::recording_only_wait(nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, &zero), RMW_RET_TIMEOUT);
+  EXPECT_LT(elapsed_ms(poll_start), 20);
+}
+
+// A trigger wakes a wait without timeout; only its own entry stays set
+TEST(TestRecordingWait, TriggerWakes) {
+  RecordingGuardCondition triggered;
+  RecordingGuardCondition idle;
+  void * gc_entries[] = {&idle, &triggered, nullptr};
+  rmw_guard_conditions_t guard_conditions{3, gc_entries};
+
+  std::thread trigger([&triggered]() {
+      std::this_thread::sleep_for(50ms);
+      triggered.trigger();
+    });
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(rmw_introspect::recording_only_wait(nullptr, &guard_conditions,
+    nullptr, nullptr, nullptr, nullptr, nullptr), RMW_RET_OK);
+  EXPECT_LT(elapsed_ms(start), 2000);
+  trigger.join();
+  EXPECT_EQ(gc_entries[0], nullptr);
+  EXPECT_EQ(gc_entries[1], &triggered);
+  EXPECT_EQ(gc_entries[2], nullptr);
+
+  // The wait took the trigger
+  EXPECT_FALSE(triggered.triggered.load());
+}
+
+// A trigger before the wait is reported at once, and only once
+TEST(TestRecordingWait, PendingTrigger) {
+  RecordingGuardCondition gc;
+  gc.trigger();
+
+  void * gc_entries[] = {&gc};
+  rmw_guard_conditions_t guard_conditions{1, gc_entries};
+  rmw_time_t timeout{10, 0};
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(rmw_introspect::recording_only_wait(nullptr, &guard_conditions,
+    nullptr, nullptr, nullptr, nullptr, &timeout), RMW_RET_OK);
+  EXPECT_LT(elapsed_ms(start), 20);
+
+  gc_entries[0] = &gc;
+  rmw_time_t zero{0, 0};
+  EXPECT_EQ(rmw_introspect::recording_only_wait(nullptr, &guard_conditions,
+    nullptr, nullptr, nullptr, nullptr, &zero), RMW_RET_TIMEOUT);
+}
+
+// Another guard condition's trigger does not end the wait
+TEST(TestRecordingWait, OtherTriggerIgnored) {
+  RecordingGuardCondition mine;
+  RecordingGuardCondition other;
+  void * gc_entries[] = {&mine};
+  rmw_guard_conditions_t guard_conditions{1, gc_entries};
+
+  std::thread trigger([&other]() {
+      std::this_thread::sleep_for(10ms);
+      other.trigger();
+    });
+  const auto start = std::chrono::steady_clock::now();
+  rmw_time_t timeout{0, 100000000};
+  EXPECT_EQ(rmw_introspect::recording_only_wait(nullptr, &guard_conditions,
+    nullptr, nullptr, nullptr, nullptr, &timeout), RMW_RET_TIMEOUT);
+  EXPECT_GE(elapsed_ms(start), 90);
+  trigger.join();
+}
+
+// Racing triggers are never lost
+TEST(TestRecordingWait, NoLostWakeups) {
+  for (int round = 0; round < 200; ++round) {
+    RecordingGuardCondition gc;
+    std::thread waiter([&gc]() {
+        void * gc_entries[] = {&gc};
+        rmw_guard_conditions_t guard_conditions{1, gc_entries};
+        EXPECT_EQ(rmw_introspect::recording_only_wait(nullptr,
+          &guard_conditions, nullptr, nullptr, nullptr, nullptr, nullptr),
+          RMW_RET_OK);
+      });
+    gc.trigger();
+    waiter.join();
+  }
+}
+
+TEST(TestRecordingWait, TimeScale) {
+  EXPECT_EQ(rmw_introspect::parse_time_scale(nullptr), 1.0);
+  EXPECT_EQ(rmw_introspect::parse_time_scale(""), 1.0);
+  EXPECT_EQ(rmw_introspect::parse_time_scale("10"), 10.0);
+  EXPECT_EQ(rmw_introspect::parse_time_scale("0.5"), 0.5);
+  EXPECT_EQ(rmw_introspect::parse_time_scale("0"), 1.0);
+  EXPECT_EQ(rmw_introspect::parse_time_scale("-2"), 1.0);
+  EXPECT_EQ(rmw_introspect::parse_time_scale("fast"), 1.0);
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
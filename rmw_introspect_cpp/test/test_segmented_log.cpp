@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rmw_introspect/segmented_log.hpp"
+
+using rmw_introspect::SegmentedLog;
+
+// Records come back in append order across segment boundaries
+TEST(TestSegmentedLog, SingleThreadOrder) {
+  SegmentedLog<std::string> log;
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_GT(log.append(std::to_string(i)), 0u);
+  }
+
+  auto values = log.snapshot();
+  ASSERT_EQ(values.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(values[i], std::to_string(i));
+  }
+
+  log.clear();
+  EXPECT_EQ(log.size(), 0u);
+  EXPECT_TRUE(log.snapshot().empty());
+}
+
+// Concurrent appends are all kept, each with a distinct sequence number
+TEST(TestSegmentedLog, ConcurrentAppend) {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 2000;
+  SegmentedLog<int> log;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&log, t]() {
+      for (int i = 0; i < kPerThread; ++i) {
+        log.append(t * kPerThread + i);
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  auto entries = log.sequenced_snapshot();
+  ASSERT_EQ(entries.size(), static_cast<size_t>(kThreads * kPerThread));
+
+  std::set<int> values;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    values.insert(entries[i].value);
+    if (i > 0) {
+      EXPECT_LT(entries[i - 1].sequence, entries[i].sequence);
+    }
+  }
+  EXPECT_EQ(values.size(), entries.size());
+}
+
+// drain() only hands out records added since the cursor, and can stop early
+TEST(TestSegmentedLog, DrainFromCursor) {
+  SegmentedLog<int> log;
+  SegmentedLog<int>::Cursor cursor;
+  for (int i = 0; i < 100; ++i) {
+    log.append(i);
+  }
+
+  std::vector<int> seen;
+  EXPECT_FALSE(log.drain(cursor, [&](uint64_t, int value) {
+    seen.push_back(value);
+    return seen.size() < 10;
+  }));
+  EXPECT_EQ(seen.size(), 10u);
+
+  EXPECT_TRUE(log.drain(cursor, [&](uint64_t, int value) {
+    seen.push_back(value);
+    return true;
+  }));
+  ASSERT_EQ(seen.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(seen[i], i);
+  }
+
+  log.append(100);
+  size_t later = 0;
+  EXPECT_TRUE(log.drain(cursor, [&](uint64_t, int value) {
+    EXPECT_EQ(value, 100);
+    ++later;
+    return true;
+  }));
+  EXPECT_EQ(later, 1u);
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
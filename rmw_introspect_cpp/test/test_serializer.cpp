@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/serializer.hpp"
+
+using rmw_introspect::ClientInfo;
+using rmw_introspect::CsvSink;
+using rmw_introspect::EntityKind;
+using rmw_introspect::ExportHeader;
+using rmw_introspect::IntrospectionData;
+using rmw_introspect::JsonSink;
+using rmw_introspect::OutputBuffer;
+using rmw_introspect::PublisherInfo;
+using rmw_introspect::PublisherStats;
+using rmw_introspect::QoSReliability;
+using rmw_introspect::ServiceInfo;
+using rmw_introspect::SubscriptionInfo;
+using rmw_introspect::YamlSink;
+
+namespace {
+
+std::string read_file(const std::string & path) {
+  std::ifstream file(path);
+  return std::string((std::istreambuf_iterator<char>(file)),
+    std::istreambuf_iterator<char>());
+}
+
+void record_graph(IntrospectionData & data) {
+  data.record_node("talker", "/demo");
+
+  PublisherInfo pub;
+  pub.node_name = "talker";
+  pub.node_namespace = "/demo";
+  pub.topic_name = "/chatter";
+  pub.message_type = "std_msgs/msg/String";
+  pub.qos.reliability = QoSReliability::Reliable;
+  pub.qos.depth = 7;
+  pub.timestamp = 1.5;
+  pub.stats = std::make_shared<PublisherStats>();
+  pub.stats->record_publish(RMW_RET_OK, 32);
+  data.record_publisher(pub);
+
+  SubscriptionInfo sub;
+  sub.node_name = "talker";
+  sub.node_namespace = "/demo";
+  sub.topic_name = "/odd,\"name\"";
+  sub.message_type = "std_msgs/msg/String";
+  sub.timestamp = 2.0;
+  data.record_subscription(sub);
+
+  ServiceInfo srv;
+  srv.node_name = "talker";
+  srv.node_namespace = "/demo";
+  srv.service_name = "/reset";
+  srv.service_type = "std_srvs/srv/Empty";
+  data.record_service(srv);
+}
+
+const ExportHeader kHeader = {"1.0", "2025-01-01T00:00:00Z",
+  "rmw_introspect_cpp"};
+
+}  // namespace
+
+// The YAML export is the JSON document in block style
+TEST(TestSerializer, YamlExport) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  record_graph(data);
+
+  const std::string path = "/tmp/test_rmw_introspect.yaml";
+  ASSERT_TRUE(data.export_to_yaml(path));
+  const std::string content = read_file(path);
+
+  EXPECT_EQ(content.rfind("format_version: \"1.0\"\n", 0), 0u);
+  EXPECT_NE(content.find("nodes:\n  - \"/demo/talker\"\n"), std::string::npos);
+  EXPECT_NE(content.find("publishers:\n  - node_name: \"talker\"\n"
+    "    node_namespace: \"/demo\"\n"), std::string::npos);
+  EXPECT_NE(content.find("    qos:\n      reliability: \"reliable\"\n"),
+    std::string::npos);
+  EXPECT_NE(content.find("      messages: 1\n"), std::string::npos);
+  EXPECT_NE(content.find("topic_name: \"/odd,\\\"name\\\"\""),
+    std::string::npos);
+  EXPECT_NE(content.find("service_name: \"/reset\""), std::string::npos);
+  EXPECT_NE(content.find("clients: []\n"), std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// One table per kind, stats columns empty without stats, RFC 4180 quoting
+TEST(TestSerializer, CsvExport) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  record_graph(data);
+
+  const std::string path = "/tmp/test_rmw_introspect.json";
+  ASSERT_TRUE(data.export_to_csv(path));
+
+  EXPECT_EQ(rmw_introspect::csv_output_path(path, EntityKind::Publisher),
+    "/tmp/test_rmw_introspect.publishers.csv");
+  EXPECT_EQ(read_file("/tmp/test_rmw_introspect.nodes.csv"),
+    "name\n/demo/talker\n");
+
+  const std::string publishers =
+    read_file("/tmp/test_rmw_introspect.publishers.csv");
+  EXPECT_EQ(publishers.rfind("node_name,node_namespace,topic_name,"
+    "message_type,reliability,durability,history,depth,timestamp,messages,",
+    0), 0u);
+  EXPECT_NE(publishers.find("\ntalker,/demo,/chatter,std_msgs/msg/String,"
+    "reliable,unknown,unknown,7,1.5,1,32,0,"), std::string::npos);
+
+  const std::string subscriptions =
+    read_file("/tmp/test_rmw_introspect.subscriptions.csv");
+  EXPECT_NE(subscriptions.find("\ntalker,/demo,\"/odd,\"\"name\"\"\","
+    "std_msgs/msg/String,unknown,unknown,unknown,0,2,,,,,,,,,,,\n"),
+    std::string::npos);
+
+  const std::string services =
+    read_file("/tmp/test_rmw_introspect.services.csv");
+  EXPECT_EQ(services.rfind("node_name,node_namespace,service_name,"
+    "service_type,", 0), 0u);
+  EXPECT_NE(services.find("/reset,std_srvs/srv/Empty"), std::string::npos);
+  EXPECT_EQ(read_file("/tmp/test_rmw_introspect.clients.csv").find('\n'),
+    read_file("/tmp/test_rmw_introspect.clients.csv").size() - 1);
+
+  for (size_t i = 0; i < rmw_introspect::kEntityKindCount; ++i) {
+    std::remove(rmw_introspect::csv_output_path(path,
+      static_cast<EntityKind>(i)).c_str());
+  }
+  data.clear();
+}
+
+// A small buffer drained to a descriptor produces the same bytes as an
+// in-memory one, and one walk feeds several sinks
+TEST(TestSerializer, DrainsToDescriptor) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+  record_graph(data);
+  for (int i = 0; i < 200; ++i) {
+    ClientInfo cli;
+    cli.node_name = "client_" + std::to_string(i);
+    cli.node_namespace = "/";
+    cli.service_name = "/reset";
+    cli.service_type = "std_srvs/srv/Empty";
+    data.record_client(cli);
+  }
+  const auto snapshot = data.snapshot();
+
+  OutputBuffer memory(rmw_introspect::estimate_export_bytes(snapshot));
+  OutputBuffer yaml(1024);
+  JsonSink json_sink(memory);
+  YamlSink yaml_sink(yaml);
+  rmw_introspect::serialize(snapshot, kHeader, {&json_sink, &yaml_sink});
+  EXPECT_LE(memory.view().size(),
+    rmw_introspect::estimate_export_bytes(snapshot));
+
+  const std::string path = "/tmp/test_rmw_introspect_drain.json";
+  int fd = rmw_introspect::open_export_file(path);
+  ASSERT_GE(fd, 0);
+  {
+    OutputBuffer file(fd, 64);
+    JsonSink sink(file);
+    rmw_introspect::serialize(snapshot, kHeader, {&sink});
+    EXPECT_TRUE(file.flush());
+  }
+  ::close(fd);
+
+  EXPECT_EQ(read_file(path), memory.view());
+  EXPECT_NE(yaml.view().find("node_name: \"client_199\""), std::string::npos);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
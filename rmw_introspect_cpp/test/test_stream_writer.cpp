@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rmw_introspect/data.hpp"
+#include "rmw_introspect/stream_writer.hpp"
+
+using rmw_introspect::EntityKind;
+using rmw_introspect::IntrospectionData;
+using rmw_introspect::PublisherInfo;
+using rmw_introspect::StreamWriter;
+
+namespace {
+
+std::vector<std::string> read_lines(const std::string & path) {
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+size_t count_containing(
+  const std::vector<std::string> & lines, const std::string & needle)
+{
+  size_t count = 0;
+  for (const auto & line : lines) {
+    if (line.find(needle) != std::string::npos) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+PublisherInfo make_publisher(const char * topic) {
+  PublisherInfo info;
+  info.node_name = "stream_node";
+  info.node_namespace = "/";
+  info.topic_name = topic;
+  info.message_type = "std_msgs/msg/String";
+  info.qos.depth = 10;
+  info.timestamp = 0.0;
+  return info;
+}
+
+}  // namespace
+
+// Records are formatted once each, with their sequence numbers, and the
+// byte budget splits the drain without losing any
+TEST(TestStreamWriter, AppendStreamEvents) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  data.record_node("stream_node", "");
+  auto id = data.record_publisher(make_publisher("a"));
+  data.record_publisher(make_publisher("b"));
+  data.record_destroy(EntityKind::Publisher, id);
+
+  IntrospectionData::StreamCursor cursor;
+  std::string out;
+  size_t calls = 0;
+  while (!data.append_stream_events(cursor, out, 1)) {
+    ++calls;
+  }
+  EXPECT_EQ(calls, 4u);  // The budget stops every call after one line
+
+  std::string again;
+  EXPECT_TRUE(data.append_stream_events(cursor, again, 1 << 20));
+  EXPECT_TRUE(again.empty());
+
+  EXPECT_NE(out.find("\"event\":\"node\",\"name\":\"/stream_node\""),
+    std::string::npos);
+  EXPECT_NE(out.find("\"topic_name\":\"a\""), std::string::npos);
+  EXPECT_NE(out.find("\"topic_name\":\"b\""), std::string::npos);
+  EXPECT_NE(
+    out.find("\"event\":\"destroy\",\"kind\":\"publisher\",\"record\":" +
+    std::to_string(id)), std::string::npos);
+
+  // clear() starts the cursor over
+  data.clear();
+  data.record_node("after_clear", "");
+  std::string cleared;
+  EXPECT_TRUE(data.append_stream_events(cursor, cleared, 1 << 20));
+  EXPECT_NE(cleared.find("after_clear"), std::string::npos);
+
+  data.clear();
+}
+
+// Names are escaped, so every event stays one line of valid JSON
+TEST(TestStreamWriter, AppendStreamEventsEscapesNames) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  data.record_node("odd\"node", "");
+  PublisherInfo info = make_publisher("line\nbreak");
+  info.node_name = "back\\slash";
+  data.record_publisher(info);
+
+  IntrospectionData::StreamCursor cursor;
+  std::string out;
+  EXPECT_TRUE(data.append_stream_events(cursor, out, 1 << 20));
+
+  EXPECT_NE(out.find("\"event\":\"node\",\"name\":\"/odd\\\"node\""),
+    std::string::npos);
+  EXPECT_NE(out.find("\"node_name\":\"back\\\\slash\""), std::string::npos);
+  EXPECT_NE(out.find("\"topic_name\":\"line\\nbreak\""), std::string::npos);
+  size_t lines = 0;
+  for (char c : out) {
+    lines += c == '\n';
+  }
+  EXPECT_EQ(lines, 2u);
+
+  data.clear();
+}
+
+// The writer thread picks up new records on its own, and stop() writes out
+// the rest
+TEST(TestStreamWriter, BackgroundWriter) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  const std::string path = "/tmp/test_rmw_introspect_stream.ndjson";
+  auto & writer = StreamWriter::instance();
+  ASSERT_TRUE(writer.start(path, std::chrono::milliseconds(10), 256));
+  EXPECT_TRUE(writer.running());
+  EXPECT_FALSE(writer.start(path, std::chrono::milliseconds(10), 256));
+
+  data.record_node("stream_node", "");
+  for (int i = 0; i < 50; ++i) {
+    data.record_publisher(make_publisher("periodic"));
+  }
+
+  // Written without an explicit flush
+  bool seen = false;
+  for (int i = 0; i < 200 && !seen; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    seen = count_containing(read_lines(path), "\"periodic\"") == 50;
+  }
+  EXPECT_TRUE(seen);
+
+  data.record_publisher(make_publisher("late"));
+  writer.stop();
+  EXPECT_FALSE(writer.running());
+
+  auto lines = read_lines(path);
+  ASSERT_FALSE(lines.empty());
+  EXPECT_NE(lines[0].find("\"event\":\"header\""), std::string::npos);
+  EXPECT_EQ(count_containing(lines, "\"event\":\"node\""), 1u);
+  EXPECT_EQ(count_containing(lines, "\"event\":\"publisher\""), 51u);
+  EXPECT_EQ(count_containing(lines, "\"late\""), 1u);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+// A buffer's worth of records is written out without waiting for the
+// interval
+TEST(TestStreamWriter, SizeTriggeredFlush) {
+  auto & data = IntrospectionData::instance();
+  data.clear();
+
+  const std::string path = "/tmp/test_rmw_introspect_stream_size.ndjson";
+  auto & writer = StreamWriter::instance();
+  ASSERT_TRUE(writer.start(path, std::chrono::seconds(30), 1024));
+
+  for (int i = 0; i < 20; ++i) {
+    data.record_publisher(make_publisher("sized"));
+  }
+
+  bool seen = false;
+  for (int i = 0; i < 400 && !seen; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    seen = count_containing(read_lines(path), "\"sized\"") > 0;
+  }
+  EXPECT_TRUE(seen);
+
+  writer.stop();
+  EXPECT_EQ(count_containing(read_lines(path), "\"sized\""), 20u);
+
+  std::remove(path.c_str());
+  data.clear();
+}
+
+TEST(TestStreamWriter, OutputPath) {
+  EXPECT_EQ(rmw_introspect::stream_output_path("/tmp/graph.json"),
+    "/tmp/graph.ndjson");
+  EXPECT_EQ(rmw_introspect::stream_output_path("/tmp/graph"),
+    "/tmp/graph.ndjson");
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "rmw/event.h"
+#include "rmw_introspect/dispatch.hpp"
+#include "rmw_introspect/wrappers.hpp"
+
+using rmw_introspect::CallbackTrampoline;
+using rmw_introspect::DispatchMode;
+using rmw_introspect::EventWrapper;
+using rmw_introspect::WaitSetWrapper;
+
+// Scratch arrays are preallocated from max_conditions
+TEST(TestWrappers, WaitSetScratchPreallocated) {
+  WaitSetWrapper wrapper(nullptr, 8);
+
+  void ** first = wrapper.acquire_scratch(wrapper.subscriptions_scratch, 8);
+  void ** second = wrapper.acquire_scratch(wrapper.subscriptions_scratch, 4);
+
+  EXPECT_EQ(first, second);  // Same storage reused across waits
+  EXPECT_EQ(wrapper.allocations_avoided.load(), 2u);
+  EXPECT_EQ(wrapper.scratch_grows.load(), 0u);
+}
+
+// Scratch arrays grow when a wait exceeds the current capacity, then stay
+TEST(TestWrappers, WaitSetScratchGrowOnly) {
+  WaitSetWrapper wrapper(nullptr, 0);  // 0 = unbounded wait set
+
+  wrapper.acquire_scratch(wrapper.clients_scratch, 16);
+  EXPECT_EQ(wrapper.scratch_grows.load(), 1u);
+  EXPECT_GE(wrapper.clients_scratch.size(), 16u);
+
+  wrapper.acquire_scratch(wrapper.clients_scratch, 2);
+  wrapper.acquire_scratch(wrapper.clients_scratch, 16);
+  EXPECT_EQ(wrapper.scratch_grows.load(), 1u);
+  EXPECT_EQ(wrapper.allocations_avoided.load(), 2u);
+  EXPECT_GE(wrapper.clients_scratch.size(), 16u);
+}
+
+// Each mode has its own table and recording-only is active by default
+TEST(TestWrappers, DispatchTableSelection) {
+  using rmw_introspect::dispatch_table;
+  using rmw_introspect::internal::current_dispatch;
+
+  EXPECT_EQ(current_dispatch().mode, DispatchMode::RecordingOnly);
+  EXPECT_EQ(dispatch_table(DispatchMode::Intermediate).mode,
+            DispatchMode::Intermediate);
+  EXPECT_EQ(dispatch_table(DispatchMode::IntermediateStats).mode,
+            DispatchMode::IntermediateStats);
+  EXPECT_NE(dispatch_table(DispatchMode::Intermediate).publish,
+            dispatch_table(DispatchMode::IntermediateStats).publish);
+
+  // Recording-only hot calls never touch the handles
+  bool taken = true;
+  EXPECT_EQ(current_dispatch().take(nullptr, nullptr, &taken, nullptr),
+            RMW_RET_OK);
+  EXPECT_FALSE(taken);
+  // A null timeout would block until a trigger, so poll
+  rmw_time_t poll = {0, 0};
+  EXPECT_EQ(current_dispatch().wait(nullptr, nullptr, nullptr, nullptr, nullptr,
+                                    nullptr, &poll),
+            RMW_RET_TIMEOUT);
+}
+
+// The trampoline counts deliveries and forwards them to the application
+TEST(TestWrappers, CallbackTrampolineForwards) {
+  rmw_introspect::SubscriptionStats stats;
+  CallbackTrampoline trampoline(&stats.callbacks);
+
+  size_t delivered = 0;
+  trampoline.callback = [](const void * user_data, size_t count) {
+    *static_cast<size_t *>(const_cast<void *>(user_data)) += count;
+  };
+  trampoline.user_data = &delivered;
+
+  CallbackTrampoline::invoke(&trampoline, 2);
+  CallbackTrampoline::invoke(&trampoline, 1);
+
+  EXPECT_EQ(delivered, 3u);
+  EXPECT_EQ(stats.callbacks.invocations.load(), 2u);
+  EXPECT_EQ(stats.callbacks.events.load(), 3u);
+  EXPECT_GT(stats.callbacks.pending_since_ns.load(), 0);
+
+  // The next take closes the pending delivery, later takes do not sample
+  stats.callbacks.record_take();
+  stats.callbacks.record_take();
+  EXPECT_EQ(stats.callbacks.take_delay_samples.load(), 1u);
+  EXPECT_EQ(stats.callbacks.pending_since_ns.load(), 0);
+  EXPECT_GE(stats.callbacks.take_delay_max_ns.load(),
+            stats.callbacks.take_delay_total_ns.load());
+}
+
+// Entities without stats still forward deliveries
+TEST(TestWrappers, CallbackTrampolineWithoutStats) {
+  CallbackTrampoline trampoline(nullptr);
+
+  size_t delivered = 0;
+  trampoline.callback = [](const void * user_data, size_t count) {
+    *static_cast<size_t *>(const_cast<void *>(user_data)) += count;
+  };
+  trampoline.user_data = &delivered;
+
+  CallbackTrampoline::invoke(&trampoline, 2);
+  EXPECT_EQ(delivered, 2u);
+}
+
+// Taken QoS events are counted by type from total_count_change
+TEST(TestWrappers, EventWrapperCountsQoSEvents) {
+  auto stats = std::make_shared<rmw_introspect::QoSEventStats>();
+  EventWrapper wrapper(stats);
+
+  wrapper.real_event.event_type = RMW_EVENT_MESSAGE_LOST;
+  rmw_message_lost_status_t lost{};
+  lost.total_count = 5;
+  lost.total_count_change = 3;
+  wrapper.record_taken(&lost);
+
+  wrapper.real_event.event_type = RMW_EVENT_OFFERED_QOS_INCOMPATIBLE;
+  rmw_offered_qos_incompatible_event_status_t incompatible{};
+  incompatible.total_count = 1;
+  incompatible.total_count_change = 1;
+  wrapper.record_taken(&incompatible);
+
+  wrapper.real_event.event_type = RMW_EVENT_REQUESTED_DEADLINE_MISSED;
+  rmw_requested_deadline_missed_status_t deadline{};
+  deadline.total_count = 2;
+  deadline.total_count_change = 2;
+  wrapper.record_taken(&deadline);
+
+  EXPECT_EQ(stats->messages_lost.load(), 3u);
+  EXPECT_EQ(stats->incompatible_qos.load(), 1u);
+  EXPECT_EQ(stats->deadline_missed.load(), 2u);
+  EXPECT_EQ(stats->liveliness_lost.load(), 0u);
+}
+
+int main(int argc, char ** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -4,6 +4,7 @@ JSON schema validator for rmw_introspect_cpp output
 Validates that introspection output matches expected schema
 """
 
+import argparse
 import json
 import sys
 import re
@@ -25,6 +26,17 @@ SCHEMA = {
     }
 }
 
+# (array key, error label, name field, type field) of each endpoint kind
+ENDPOINT_KINDS = [
+    ("publishers", "Publisher", "topic_name", "message_type"),
+    ("subscriptions", "Subscription", "topic_name", "message_type"),
+    ("services", "Service", "service_name", "service_type"),
+    ("clients", "Client", "service_name", "service_type"),
+]
+
+# Errors printed before the rest are summarized
+MAX_PRINTED_ERRORS = 50
+
 def validate_message_type_format(msg_type: str) -> bool:
     """Validate message type format: package/msg/Type or package/srv/Type"""
     pattern = r'^[a-z_][a-z0-9_]*/(msg|srv)/[A-Z][a-zA-Z0-9]*$'
@@ -53,10 +65,66 @@ def validate_qos_profile(qos: dict) -> list:
 
     return errors
 
-def validate_output(json_file: str) -> tuple[bool, list]:
+def validate_stats(stats: dict) -> list:
+    """Validate that stats counters, nested groups included, are non-negative integers"""
+    errors = []
+    if not isinstance(stats, dict):
+        return ["stats must be an object"]
+    for field, value in stats.items():
+        if isinstance(value, dict):
+            errors.extend(f"{field}.{err}" for err in validate_stats(value))
+        elif isinstance(value, bool) or not isinstance(value, int) or value < 0:
+            errors.append(f"Invalid stats counter {field}: {value!r}")
+    return errors
+
+def validate_endpoint(endpoint: dict, name_field: str, type_field: str) -> list:
+    """Validate one publisher, subscription, service or client entry"""
+    if not isinstance(endpoint, dict):
+        return ["must be an object"]
+
+    errors = []
+    for field in ["node_name", "node_namespace"]:
+        if not isinstance(endpoint.get(field), str):
+            errors.append(f"missing {field}")
+
+    if not endpoint.get(name_field):
+        errors.append(f"missing {name_field}")
+
+    endpoint_type = endpoint.get(type_field)
+    if not endpoint_type:
+        errors.append(f"missing {type_field}")
+    elif not validate_message_type_format(endpoint_type):
+        errors.append(f"invalid {type_field} format: {endpoint_type}")
+
+    if "qos" in endpoint:
+        errors.extend(validate_qos_profile(endpoint["qos"]))
+
+    timestamp = endpoint.get("timestamp")
+    if timestamp is not None and (
+        isinstance(timestamp, bool) or not isinstance(timestamp, (int, float))
+    ):
+        errors.append(f"Invalid timestamp: {timestamp!r}")
+
+    if "stats" in endpoint:
+        errors.extend(validate_stats(endpoint["stats"]))
+
+    return errors
+
+def count_endpoints(data: dict) -> int:
+    """Number of publishers, subscriptions, services and clients"""
+    return sum(
+        len(data[key]) for key, *_ in ENDPOINT_KINDS if isinstance(data.get(key), list)
+    )
+
+def validate_output(json_file: str, min_endpoints: int = None) -> tuple[bool, list]:
     """
     Validate rmw_introspect JSON output
 
+    Args:
+        json_file: Path of the export
+        min_endpoints: Fail if fewer endpoints were exported, to check that
+            large graphs are written completely
+
     Returns:
         (is_valid, errors) tuple
     """
@@ -99,93 +167,47 @@ def validate_output(json_file: str) -> tuple[bool, list]:
             elif not node.startswith("/"):
                 errors.append(f"Node {i}: must start with / (got: {node})")
 
-    # Validate publishers
-    if "publishers" in data:
-        if not isinstance(data["publishers"], list):
-            errors.append("publishers must be an array")
-        else:
-            for i, pub in enumerate(data["publishers"]):
-                if not pub.get("topic_name"):
-                    errors.append(f"Publisher {i}: missing topic_name")
-
-                msg_type = pub.get("message_type")
-                if not msg_type:
-                    errors.append(f"Publisher {i}: missing message_type")
-                elif not validate_message_type_format(msg_type):
-                    errors.append(f"Publisher {i}: invalid message_type format: {msg_type}")
-
-                if "qos" in pub:
-                    qos_errors = validate_qos_profile(pub["qos"])
-                    for err in qos_errors:
-                        errors.append(f"Publisher {i}: {err}")
-
-    # Validate subscriptions
-    if "subscriptions" in data:
-        if not isinstance(data["subscriptions"], list):
-            errors.append("subscriptions must be an array")
-        else:
-            for i, sub in enumerate(data["subscriptions"]):
-                if not sub.get("topic_name"):
-                    errors.append(f"Subscription {i}: missing topic_name")
-
-                msg_type = sub.get("message_type")
-                if not msg_type:
-                    errors.append(f"Subscription {i}: missing message_type")
-                elif not validate_message_type_format(msg_type):
-                    errors.append(f"Subscription {i}: invalid message_type format: {msg_type}")
-
-                if "qos" in sub:
-                    qos_errors = validate_qos_profile(sub["qos"])
-                    for err in qos_errors:
-                        errors.append(f"Subscription {i}: {err}")
-
-    # Validate services
-    if "services" in data:
-        if not isinstance(data["services"], list):
-            errors.append("services must be an array")
-        else:
-            for i, srv in enumerate(data["services"]):
-                if not srv.get("service_name"):
-                    errors.append(f"Service {i}: missing service_name")
-
-                srv_type = srv.get("service_type")
-                if not srv_type:
-                    errors.append(f"Service {i}: missing service_type")
-                elif not validate_message_type_format(srv_type):
-                    errors.append(f"Service {i}: invalid service_type format: {srv_type}")
-
-    # Validate clients
-    if "clients" in data:
-        if not isinstance(data["clients"], list):
-            errors.append("clients must be an array")
-        else:
-            for i, client in enumerate(data["clients"]):
-                if not client.get("service_name"):
-                    errors.append(f"Client {i}: missing service_name")
-
-                srv_type = client.get("service_type")
-                if not srv_type:
-                    errors.append(f"Client {i}: missing service_type")
-                elif not validate_message_type_format(srv_type):
-                    errors.append(f"Client {i}: invalid service_type format: {srv_type}")
+    # Validate publishers, subscriptions, services and clients
+    for key, label, name_field, type_field in ENDPOINT_KINDS:
+        if key not in data:
+            continue
+        if not isinstance(data[key], list):
+            errors.append(f"{key} must be an array")
+            continue
+        for i, endpoint in enumerate(data[key]):
+            for err in validate_endpoint(endpoint, name_field, type_field):
+                errors.append(f"{label} {i}: {err}")
+
+    if min_endpoints is not None:
+        total = count_endpoints(data)
+        if total < min_endpoints:
+            errors.append(f"Expected at least {min_endpoints} endpoints, got {total}")
 
     return (len(errors) == 0, errors)
 
 def main():
-    if len(sys.argv) != 2:
-        print("Usage: validate_json.py <json_file>")
-        sys.exit(1)
-
-    json_file = sys.argv[1]
-    is_valid, errors = validate_output(json_file)
+    parser = argparse.ArgumentParser(description="Validate rmw_introspect_cpp JSON output")
+    parser.add_argument("json_file")
+    parser.add_argument(
+        "--min-endpoints",
+        type=int,
+        default=None,
+        help="fail if fewer publishers, subscriptions, services and clients were exported",
+    )
+    args = parser.parse_args()
+
+    json_file = args.json_file
+    is_valid, errors = validate_output(json_file, args.min_endpoints)
 
     if is_valid:
         print(f"✓ {json_file} is valid")
         sys.exit(0)
     else:
         print(f"✗ {json_file} validation failed:")
-        for error in errors:
+        for error in errors[:MAX_PRINTED_ERRORS]:
             print(f"  - {error}")
+        if len(errors) > MAX_PRINTED_ERRORS:
+            print(f"  ... and {len(errors) - MAX_PRINTED_ERRORS} more")
         sys.exit(1)
 
 if __name__ == "__main__":
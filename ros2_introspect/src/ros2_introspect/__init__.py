@@ -6,6 +6,17 @@ discovering ROS 2 node interfaces (publishers, subscriptions, services, clients)
 without running actual middleware communication.
 """
 
+from .batch import (
+    BatchResult,
+    BatchTarget,
+    SystemReport,
+    discover_executables,
+    introspect_batch,
+    load_manifest,
+    merge_results,
+)
+from .binary import BinaryIntrospection, read_binary
+from .cache import CacheStats, IntrospectionCache
 from .data import (
     ClientInfo,
     IntrospectionResult,
@@ -15,16 +26,29 @@ from .data import (
     SubscriptionInfo,
 )
 from .introspector import check_rmw_introspect_available, introspect_node
+from .stream import compact_event_stream
 
 __version__ = "0.1.0"
 
 __all__ = [
+    "BatchResult",
+    "BatchTarget",
+    "BinaryIntrospection",
+    "CacheStats",
     "ClientInfo",
+    "IntrospectionCache",
     "IntrospectionResult",
     "PublisherInfo",
     "QoSProfile",
     "ServiceInfo",
     "SubscriptionInfo",
+    "SystemReport",
     "check_rmw_introspect_available",
+    "compact_event_stream",
+    "discover_executables",
+    "introspect_batch",
     "introspect_node",
+    "load_manifest",
+    "merge_results",
+    "read_binary",
 ]
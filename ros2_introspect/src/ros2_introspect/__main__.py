@@ -5,7 +5,12 @@ CLI entry point for ros2-introspect tool.
 import argparse
 import json
 import sys
+from typing import Optional
 
+import yaml
+
+from .batch import discover_executables, introspect_batch, load_manifest, merge_results
+from .cache import IntrospectionCache
 from .introspector import introspect_node
 
 
@@ -15,8 +20,55 @@ def main() -> int:
         prog="ros2-introspect",
         description="Introspect ROS 2 node interfaces using rmw_introspect_cpp",
     )
-    parser.add_argument("package", help="ROS 2 package name")
-    parser.add_argument("executable", help="Executable name within the package")
+    parser.add_argument("package", nargs="?", help="ROS 2 package name")
+    parser.add_argument("executable", nargs="?", help="Executable name within the package")
+    batch = parser.add_mutually_exclusive_group()
+    batch.add_argument(
+        "--manifest",
+        "-m",
+        help="Introspect every target of a YAML or JSON manifest in parallel",
+    )
+    batch.add_argument(
+        "--all",
+        action="store_true",
+        help="Introspect every executable on AMENT_PREFIX_PATH in parallel",
+    )
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        help="Nodes introspected at once in batch mode (default: number of cores)",
+    )
+    parser.add_argument(
+        "--report",
+        "-o",
+        help="Write the merged batch report to this file instead of stdout",
+    )
+    parser.add_argument(
+        "--cache",
+        action="store_true",
+        help="Reuse results of executables, libraries and options that have not changed",
+    )
+    parser.add_argument(
+        "--cache-dir",
+        help="Cache directory (default: $ROS2_INTROSPECT_CACHE_DIR or ~/.cache/ros2_introspect)",
+    )
+    cache_command = parser.add_mutually_exclusive_group()
+    cache_command.add_argument(
+        "--cache-stats",
+        action="store_true",
+        help="Print the number and size of cached results and exit",
+    )
+    cache_command.add_argument(
+        "--cache-clear",
+        action="store_true",
+        help="Remove every cached result and exit",
+    )
+    cache_command.add_argument(
+        "--cache-invalidate",
+        metavar="PACKAGE",
+        help="Remove the cached results of one package and exit",
+    )
     parser.add_argument(
         "--namespace",
         "-n",
@@ -54,6 +106,19 @@ def main() -> int:
 
     args = parser.parse_args()
 
+    cache = None
+    if args.cache or args.cache_dir:
+        cache = IntrospectionCache(args.cache_dir)
+    if args.cache_stats or args.cache_clear or args.cache_invalidate:
+        return _run_cache_command(args, cache or IntrospectionCache())
+
+    if args.manifest or args.all:
+        if args.package or args.executable:
+            parser.error("package and executable cannot be combined with --manifest or --all")
+        return _run_batch(args, cache)
+    if not (args.package and args.executable):
+        parser.error("package and executable are required without --manifest or --all")
+
     # Parse remappings
     remappings = None
     if args.remap:
@@ -100,6 +165,7 @@ def main() -> int:
         namespace=args.namespace,
         node_name=args.node_name,
         timeout=args.timeout,
+        cache=cache,
     )
 
     # Output results
@@ -208,5 +274,80 @@ def main() -> int:
     return 0 if result.success else 1
 
 
+def _run_cache_command(args: argparse.Namespace, cache: IntrospectionCache) -> int:
+    """Report on or empty the result cache."""
+    if args.cache_stats:
+        stats = cache.stats()
+        print(f"Cache directory: {cache.directory}")
+        print(f"Entries: {stats.entries}")
+        print(f"Size: {stats.size_bytes / 1024:.1f} KiB")
+    else:
+        removed = cache.invalidate(args.cache_invalidate)
+        print(f"Removed {removed} cached results")
+    return 0
+
+
+def _run_batch(args: argparse.Namespace, cache: Optional[IntrospectionCache]) -> int:
+    """Introspect many targets, reporting each as it finishes."""
+    try:
+        targets = load_manifest(args.manifest) if args.manifest else discover_executables()
+    except (OSError, ValueError, yaml.YAMLError) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+    if not targets:
+        print("Error: No targets to introspect", file=sys.stderr)
+        return 1
+
+    results = []
+    try:
+        batch = introspect_batch(targets, jobs=args.jobs, timeout=args.timeout, cache=cache)
+        for done, batch_result in enumerate(batch, 1):
+            results.append(batch_result)
+            result = batch_result.result
+            if result.success:
+                status = "ok"
+            else:
+                # The first line of multi-line errors says what went wrong
+                error = (result.error or "unknown error").splitlines()
+                status = f"FAILED: {error[0] if error else ''}"
+            print(
+                f"[{done}/{len(targets)}] {batch_result.target.label} "
+                f"({batch_result.duration:.1f}s) {status}",
+                file=sys.stderr,
+                flush=True,
+            )
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    if cache is not None:
+        stats = cache.stats()
+        print(
+            f"Cache: {stats.hits} hits, {stats.misses} misses, {stats.entries} entries",
+            file=sys.stderr,
+        )
+
+    report = merge_results(results).to_dict()
+    if args.format == "json" or args.report:
+        output = json.dumps(report, indent=2)
+        if args.report:
+            with open(args.report, "w") as f:
+                f.write(output + "\n")
+        else:
+            print(output)
+    if args.format == "text":
+        summary = report["summary"]
+        print(
+            f"Introspected {summary['targets']} targets: "
+            f"{summary['succeeded']} succeeded, {summary['failed']} failed"
+        )
+        print(
+            f"Nodes: {summary['nodes']}, topics: {summary['topics']}, "
+            f"services: {summary['services']}"
+        )
+
+    return 0 if report["summary"]["failed"] == 0 else 1
+
+
 if __name__ == "__main__":
     sys.exit(main())
@@ -0,0 +1,300 @@
+"""
+Parallel introspection of many nodes.
+
+Each target runs through introspect_node on a bounded worker pool. Workers
+own a ROS domain ID and an output directory for as long as they run a
+target, so concurrently introspected nodes never see each other's graph or
+files. Results are yielded as they finish and can be merged into one system
+report.
+"""
+
+import os
+import queue
+import shutil
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from dataclasses import dataclass, field
+from typing import Any, Dict, Iterable, Iterator, List, Optional, Tuple
+
+import yaml
+
+from .cache import IntrospectionCache
+from .data import IntrospectionResult
+from .introspector import introspect_node
+
+# Highest ROS_DOMAIN_ID the default DDS port mapping allows
+MAX_DOMAIN_ID = 232
+
+
+@dataclass
+class BatchTarget:
+    """One executable to introspect, with the options introspect_node takes."""
+
+    package: str
+    executable: str
+    namespace: Optional[str] = None
+    node_name: Optional[str] = None
+    remappings: Optional[List[Tuple[str, str]]] = None
+    parameters: Optional[List[Dict[str, Any]]] = None
+    arguments: Optional[List[str]] = None
+    timeout: Optional[float] = None
+
+    @property
+    def label(self) -> str:
+        """package/executable, with the namespace when one is set."""
+        label = f"{self.package}/{self.executable}"
+        return f"{label} ({self.namespace})" if self.namespace else label
+
+
+@dataclass
+class BatchResult:
+    """Introspection result of one target."""
+
+    target: BatchTarget
+    result: IntrospectionResult
+    duration: float
+
+
+@dataclass
+class SystemReport:
+    """Interfaces of every introspected node, merged by topic and service."""
+
+    targets: List[Dict[str, Any]] = field(default_factory=list)
+    nodes: List[str] = field(default_factory=list)
+    topics: Dict[str, Dict[str, List[str]]] = field(default_factory=dict)
+    services: Dict[str, Dict[str, List[str]]] = field(default_factory=dict)
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Plain dict for JSON or YAML output."""
+        succeeded = sum(1 for target in self.targets if target["success"])
+        return {
+            "summary": {
+                "targets": len(self.targets),
+                "succeeded": succeeded,
+                "failed": len(self.targets) - succeeded,
+                "nodes": len(self.nodes),
+                "topics": len(self.topics),
+                "services": len(self.services),
+            },
+            "targets": self.targets,
+            "nodes": self.nodes,
+            "topics": self.topics,
+            "services": self.services,
+        }
+
+
+def _target_from_dict(entry: Dict[str, Any]) -> BatchTarget:
+    """Build a target from a manifest entry."""
+    if "package" not in entry or "executable" not in entry:
+        raise ValueError(f"Manifest entry needs package and executable: {entry}")
+
+    remappings = entry.get("remappings")
+    if isinstance(remappings, dict):
+        remappings = list(remappings.items())
+    elif remappings is not None:
+        remappings = [tuple(r.split(":=", 1)) for r in remappings]
+
+    parameters = entry.get("parameters")
+    if isinstance(parameters, dict):
+        parameters = [parameters]
+
+    timeout = entry.get("timeout")
+    return BatchTarget(
+        package=entry["package"],
+        executable=entry["executable"],
+        namespace=entry.get("namespace"),
+        node_name=entry.get("node_name"),
+        remappings=remappings,
+        parameters=parameters,
+        arguments=entry.get("arguments"),
+        timeout=float(timeout) if timeout is not None else None,
+    )
+
+
+def load_manifest(path: str) -> List[BatchTarget]:
+    """
+    Read targets from a YAML or JSON manifest.
+
+    The manifest is a list of entries, or a mapping with a ``targets`` list.
+    Each entry has ``package`` and ``executable``, and optionally
+    ``namespace``, ``node_name``, ``remappings`` ({from: to} or ["from:=to"]),
+    ``parameters`` ({name: value}), ``arguments`` and ``timeout``.
+    """
+    with open(path, "r") as f:
+        manifest = yaml.safe_load(f)
+    if isinstance(manifest, dict):
+        manifest = manifest.get("targets")
+    if not isinstance(manifest, list):
+        raise ValueError(f"Manifest {path} has no list of targets")
+    return [_target_from_dict(entry) for entry in manifest]
+
+
+def discover_executables(prefix_path: Optional[str] = None) -> List[BatchTarget]:
+    """
+    Find every executable of every package on AMENT_PREFIX_PATH.
+
+    Like ``ros2 pkg executables``, these are the executable files directly
+    in ``<prefix>/lib/<package>``. A package found in several prefixes is
+    taken from the first one, as overlays come first.
+    """
+    if prefix_path is None:
+        prefix_path = os.environ.get("AMENT_PREFIX_PATH", "")
+
+    targets: List[BatchTarget] = []
+    seen = set()
+    for prefix in prefix_path.split(os.pathsep):
+        index = os.path.join(prefix, "share", "ament_index", "resource_index", "packages")
+        if not prefix or not os.path.isdir(index):
+            continue
+        for package in sorted(os.listdir(index)):
+            if package in seen:
+                continue
+            seen.add(package)
+            lib = os.path.join(prefix, "lib", package)
+            if not os.path.isdir(lib):
+                continue
+            for name in sorted(os.listdir(lib)):
+                path = os.path.join(lib, name)
+                if os.path.isfile(path) and os.access(path, os.X_OK):
+                    targets.append(BatchTarget(package, name))
+    return targets
+
+
+def introspect_batch(
+    targets: Iterable[BatchTarget],
+    *,
+    jobs: Optional[int] = None,
+    timeout: float = 3.0,
+    domain_base: int = 1,
+    output_format: str = "json",
+    cache: Optional[IntrospectionCache] = None,
+) -> Iterator[BatchResult]:
+    """
+    Introspect targets in parallel, yielding results as they finish.
+
+    Args:
+        targets: Executables to introspect
+        jobs: Number of nodes run at once, the number of cores if None
+        timeout: Timeout of targets that do not set their own (seconds)
+        domain_base: First ROS domain ID handed to workers; worker i uses
+            domain_base + i
+        output_format: Format the RMW writes, "json" or "binary"
+        cache: Result cache shared by the workers, None to run every target
+    """
+    targets = list(targets)
+    jobs = max(1, min(jobs or os.cpu_count() or 1, len(targets) or 1))
+    if domain_base < 0 or domain_base + jobs - 1 > MAX_DOMAIN_ID:
+        raise ValueError(
+            f"Domain IDs {domain_base}..{domain_base + jobs - 1} are outside "
+            f"0..{MAX_DOMAIN_ID}; lower jobs or domain_base"
+        )
+
+    output_root = tempfile.mkdtemp(prefix="ros2_introspect_batch_")
+    slots: "queue.Queue[int]" = queue.Queue()
+    for domain_id in range(domain_base, domain_base + jobs):
+        os.makedirs(os.path.join(output_root, str(domain_id)))
+        slots.put(domain_id)
+
+    def run(target: BatchTarget) -> BatchResult:
+        domain_id = slots.get()
+        start = time.monotonic()
+        try:
+            result = introspect_node(
+                target.package,
+                target.executable,
+                parameters=target.parameters,
+                remappings=target.remappings,
+                namespace=target.namespace,
+                node_name=target.node_name,
+                arguments=target.arguments,
+                timeout=target.timeout if target.timeout is not None else timeout,
+                output_format=output_format,
+                domain_id=domain_id,
+                output_dir=os.path.join(output_root, str(domain_id)),
+                cache=cache,
+            )
+        except Exception as e:
+            result = IntrospectionResult(success=False, error=f"Introspection failed: {e}")
+        finally:
+            slots.put(domain_id)
+        return BatchResult(target, result, time.monotonic() - start)
+
+    executor = ThreadPoolExecutor(max_workers=jobs, thread_name_prefix="introspect")
+    try:
+        futures = [executor.submit(run, target) for target in targets]
+        for future in as_completed(futures):
+            yield future.result()
+    finally:
+        # A consumer that stops early leaves queued targets unstarted
+        executor.shutdown(wait=True, cancel_futures=True)
+        shutil.rmtree(output_root, ignore_errors=True)
+
+
+def _fq_name(name: str, namespace: str) -> str:
+    """Fully qualified node name ("/" + "talker" -> "/talker")."""
+    return f"{namespace.rstrip('/')}/{name}"
+
+
+def _add(entries: Dict[str, Dict[str, List[str]]], name: str, key: str, value: str) -> None:
+    values = entries.setdefault(name, {}).setdefault(key, [])
+    if value not in values:
+        values.append(value)
+
+
+def merge_results(results: Iterable[BatchResult]) -> SystemReport:
+    """
+    Merge batch results into one system report.
+
+    Topics list their types, publishing and subscribing nodes; services their
+    types, serving and calling nodes. Everything is sorted, so reports of the
+    same system compare equal whatever order the targets finished in.
+    """
+    report = SystemReport()
+    nodes = set()
+    for batch_result in results:
+        target, result = batch_result.target, batch_result.result
+        report.targets.append(
+            {
+                "package": target.package,
+                "executable": target.executable,
+                "namespace": target.namespace,
+                "success": result.success,
+                "error": result.error,
+                "duration": round(batch_result.duration, 3),
+                "nodes": list(result.nodes),
+            }
+        )
+        if not result.success:
+            continue
+
+        nodes.update(result.nodes)
+        for pub in result.publishers:
+            _add(report.topics, pub.topic_name, "types", pub.message_type)
+            _add(report.topics, pub.topic_name, "publishers",
+                 _fq_name(pub.node_name, pub.node_namespace))
+        for sub in result.subscriptions:
+            _add(report.topics, sub.topic_name, "types", sub.message_type)
+            _add(report.topics, sub.topic_name, "subscribers",
+                 _fq_name(sub.node_name, sub.node_namespace))
+        for srv in result.services:
+            _add(report.services, srv.service_name, "types", srv.service_type)
+            _add(report.services, srv.service_name, "servers",
+                 _fq_name(srv.node_name, srv.node_namespace))
+        for client in result.clients:
+            _add(report.services, client.service_name, "types", client.service_type)
+            _add(report.services, client.service_name, "clients",
+                 _fq_name(client.node_name, client.node_namespace))
+
+    report.targets.sort(key=lambda t: (t["package"], t["executable"], t["namespace"] or ""))
+    report.nodes = sorted(nodes)
+    for entries, keys in (
+        (report.topics, ("types", "publishers", "subscribers")),
+        (report.services, ("types", "servers", "clients")),
+    ):
+        for name in list(entries):
+            entries[name] = {key: sorted(entries[name].get(key, [])) for key in keys}
+        sorted_entries = dict(sorted(entries.items()))
+        entries.clear()
+        entries.update(sorted_entries)
+    return report
@@ -0,0 +1,243 @@
+"""
+Reader for the binary introspection format of rmw_introspect_cpp.
+
+With RMW_INTROSPECT_FORMAT=binary the RMW writes its output in the layout
+described in rmw_introspect/binary_format.hpp: a header, a string table,
+fixed-width node and endpoint records, and an index of endpoints by topic or
+service name. This module maps the file and reads records in place; the JSON
+document is a view derived from it.
+"""
+
+import mmap
+import struct
+import time
+from typing import Any, Dict, List
+
+MAGIC = b"RMWINTRO"
+VERSION_MAJOR = 1
+
+_HEADER = struct.Struct("<8sHHIqQQQQQQIIIIIIII")
+_STRING = struct.Struct("<II")
+_NODE = struct.Struct("<II")
+_ENDPOINT = struct.Struct("<BBBBIIIIId")
+_TOPIC_INDEX = struct.Struct("<IIII")
+_REF = struct.Struct("<I")
+
+_KINDS = ["node", "publisher", "subscription", "service", "client"]
+_KIND_LISTS = {1: "publishers", 2: "subscriptions", 3: "services", 4: "clients"}
+_RELIABILITY = ["unknown", "reliable", "best_effort"]
+_DURABILITY = ["unknown", "transient_local", "volatile"]
+_HISTORY = ["unknown", "keep_last", "keep_all"]
+
+
+class BinaryFormatError(ValueError):
+    """The file is not a readable binary introspection file."""
+
+
+def is_binary_file(path: str) -> bool:
+    """Check whether a file starts with the binary format's magic."""
+    try:
+        with open(path, "rb") as f:
+            return f.read(len(MAGIC)) == MAGIC
+    except OSError:
+        return False
+
+
+def _name(table: List[str], index: int) -> str:
+    return table[index] if index < len(table) else "unknown"
+
+
+class BinaryIntrospection:
+    """Memory-mapped view of a binary introspection file."""
+
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            try:
+                self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+            except ValueError as e:  # Empty file
+                raise BinaryFormatError(f"{path}: {e}") from e
+
+        if len(self._map) < _HEADER.size:
+            self.close()
+            raise BinaryFormatError(f"{path}: file too small for a header")
+        (
+            magic,
+            self.version_major,
+            self.version_minor,
+            header_size,
+            self.created_unix,
+            self._strings_offset,
+            self._string_data_offset,
+            self._nodes_offset,
+            self._endpoints_offset,
+            self._topic_index_offset,
+            self._topic_refs_offset,
+            self._string_count,
+            self._string_data_size,
+            self._node_count,
+            self._node_record_size,
+            self._endpoint_count,
+            self._endpoint_record_size,
+            self._topic_index_count,
+            self._topic_ref_count,
+        ) = _HEADER.unpack_from(self._map, 0)
+
+        if magic != MAGIC:
+            self.close()
+            raise BinaryFormatError(f"{path}: not an introspection file")
+        if self.version_major != VERSION_MAJOR:
+            self.close()
+            raise BinaryFormatError(
+                f"{path}: unsupported major version {self.version_major}"
+            )
+        if (
+            header_size < _HEADER.size
+            or self._node_record_size < _NODE.size
+            or self._endpoint_record_size < _ENDPOINT.size
+        ):
+            self.close()
+            raise BinaryFormatError(f"{path}: record sizes smaller than this reader's")
+
+        sections = [
+            (self._strings_offset, self._string_count, _STRING.size),
+            (self._string_data_offset, self._string_data_size, 1),
+            (self._nodes_offset, self._node_count, self._node_record_size),
+            (self._endpoints_offset, self._endpoint_count, self._endpoint_record_size),
+            (self._topic_index_offset, self._topic_index_count, _TOPIC_INDEX.size),
+            (self._topic_refs_offset, self._topic_ref_count, _REF.size),
+        ]
+        for offset, count, size in sections:
+            if offset + count * size > len(self._map):
+                self.close()
+                raise BinaryFormatError(f"{path}: section outside the file")
+
+    def close(self) -> None:
+        """Unmap the file."""
+        self._map.close()
+
+    def __enter__(self) -> "BinaryIntrospection":
+        return self
+
+    def __exit__(self, *exc: Any) -> None:
+        self.close()
+
+    def string(self, index: int) -> str:
+        """String by id, empty for an invalid id."""
+        if index >= self._string_count:
+            return ""
+        offset, length = _STRING.unpack_from(
+            self._map, self._strings_offset + index * _STRING.size
+        )
+        if offset + length >= self._string_data_size:
+            return ""
+        start = self._string_data_offset + offset
+        return self._map[start : start + length].decode("utf-8", "replace")
+
+    @property
+    def node_count(self) -> int:
+        return self._node_count
+
+    def node(self, index: int) -> str:
+        """Node as "namespace/name"."""
+        name, _ = _NODE.unpack_from(
+            self._map, self._nodes_offset + index * self._node_record_size
+        )
+        return self.string(name)
+
+    @property
+    def endpoint_count(self) -> int:
+        return self._endpoint_count
+
+    def endpoint(self, index: int) -> Dict[str, Any]:
+        """Endpoint as the dict the JSON export lists it as, plus its kind."""
+        kind, endpoint = self._endpoint(index)
+        endpoint["kind"] = _name(_KINDS, kind)
+        return endpoint
+
+    def _endpoint(self, index: int):
+        (
+            kind,
+            reliability,
+            durability,
+            history,
+            depth,
+            node_name,
+            node_namespace,
+            name,
+            type_,
+            timestamp,
+        ) = _ENDPOINT.unpack_from(
+            self._map, self._endpoints_offset + index * self._endpoint_record_size
+        )
+        is_service = kind in (3, 4)
+        return kind, {
+            "node_name": self.string(node_name),
+            "node_namespace": self.string(node_namespace),
+            "service_name" if is_service else "topic_name": self.string(name),
+            "service_type" if is_service else "message_type": self.string(type_),
+            "qos": {
+                "reliability": _name(_RELIABILITY, reliability),
+                "durability": _name(_DURABILITY, durability),
+                "history": _name(_HISTORY, history),
+                "depth": depth,
+            },
+            "timestamp": timestamp,
+        }
+
+    def endpoints_on(self, name: str) -> List[Dict[str, Any]]:
+        """Endpoints on a topic or service name, binary searched in the index."""
+        lo, hi = 0, self._topic_index_count
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self.string(self._index_entry(mid)[0]) < name:
+                lo = mid + 1
+            else:
+                hi = mid
+        i = lo
+        if i == self._topic_index_count:
+            return []
+        entry_name, first_ref, ref_count, _ = self._index_entry(i)
+        if self.string(entry_name) != name:
+            return []
+        if first_ref + ref_count > self._topic_ref_count:
+            return []
+        result = []
+        for ref in range(first_ref, first_ref + ref_count):
+            (index,) = _REF.unpack_from(
+                self._map, self._topic_refs_offset + ref * _REF.size
+            )
+            if index < self._endpoint_count:
+                result.append(self.endpoint(index))
+        return result
+
+    def _index_entry(self, i: int):
+        return _TOPIC_INDEX.unpack_from(
+            self._map, self._topic_index_offset + i * _TOPIC_INDEX.size
+        )
+
+    def to_document(self) -> Dict[str, Any]:
+        """The document export_to_json would have written."""
+        data: Dict[str, Any] = {
+            "format_version": f"{self.version_major}.{self.version_minor}",
+            "timestamp": time.strftime(
+                "%Y-%m-%dT%H:%M:%SZ", time.gmtime(self.created_unix)
+            ),
+            "rmw_implementation": "rmw_introspect_cpp",
+            "nodes": [self.node(i) for i in range(self._node_count)],
+            "publishers": [],
+            "subscriptions": [],
+            "services": [],
+            "clients": [],
+        }
+        for i in range(self._endpoint_count):
+            kind, endpoint = self._endpoint(i)
+            if kind in _KIND_LISTS:
+                data[_KIND_LISTS[kind]].append(endpoint)
+        return data
+
+
+def read_binary(path: str) -> Dict[str, Any]:
+    """Read a binary introspection file into the JSON export's document."""
+    with BinaryIntrospection(path) as binary:
+        return binary.to_document()
+
@@ -0,0 +1,274 @@
+"""
+Persistent cache of introspection results.
+
+A result is stored under a hash of everything that can change it: the
+contents of the executable and of every shared library it links, the Python
+package behind a script entry point, the rmw_introspect_cpp library, the
+parameters, remappings, namespace, node name and arguments, and the ROS
+distro. An unchanged executable is therefore never run twice, while any
+rebuild, upgrade or option change misses.
+
+File digests are memoized by path, size, mtime and inode, so a hit costs a
+few stat calls rather than re-reading every library.
+"""
+
+import glob
+import hashlib
+import json
+import os
+import subprocess
+import tempfile
+import threading
+import time
+from dataclasses import asdict, dataclass
+from typing import Any, Dict, List, Optional, Tuple
+
+from .data import IntrospectionResult
+
+# Bumped when the key or entry layout changes, orphaning older entries
+CACHE_FORMAT = 1
+
+_FILE_INDEX = "files.json"
+
+
+def default_cache_dir() -> str:
+    """$ROS2_INTROSPECT_CACHE_DIR, else $XDG_CACHE_HOME/ros2_introspect."""
+    if os.environ.get("ROS2_INTROSPECT_CACHE_DIR"):
+        return os.environ["ROS2_INTROSPECT_CACHE_DIR"]
+    base = os.environ.get("XDG_CACHE_HOME") or os.path.expanduser("~/.cache")
+    return os.path.join(base, "ros2_introspect")
+
+
+def linked_libraries(path: str) -> List[str]:
+    """Shared libraries the dynamic loader resolves for path, via ldd."""
+    try:
+        output = subprocess.run(
+            ["ldd", path], capture_output=True, text=True, timeout=30
+        ).stdout
+    except (OSError, subprocess.SubprocessError):
+        return []
+
+    libraries = []
+    for line in output.splitlines():
+        # "libfoo.so => /path/libfoo.so (0x...)" or "/lib64/ld-linux.so (0x...)"
+        line = line.split(" (0x")[0].strip()
+        library = line.split("=>", 1)[1].strip() if "=>" in line else line
+        if library.startswith("/"):
+            libraries.append(library)
+    return sorted(set(libraries))
+
+
+def _python_package_files(executable_path: str, package: str) -> List[str]:
+    """Files of the Python package a script entry point runs, if any."""
+    try:
+        with open(executable_path, "rb") as f:
+            if f.read(2) != b"#!":
+                return []
+    except OSError:
+        return []
+
+    # <prefix>/lib/<package>/<executable> -> <prefix>/lib/python3.X/site-packages
+    prefix = os.path.dirname(os.path.dirname(os.path.dirname(executable_path)))
+    files = []
+    for root in glob.glob(os.path.join(prefix, "lib", "python3*", "*-packages", package)):
+        for directory, _, names in os.walk(root):
+            files.extend(
+                os.path.join(directory, name) for name in names if not name.endswith(".pyc")
+            )
+    return sorted(files)
+
+
+def _rmw_library() -> Optional[str]:
+    """librmw_introspect_cpp.so found first on AMENT_PREFIX_PATH."""
+    for prefix in os.environ.get("AMENT_PREFIX_PATH", "").split(os.pathsep):
+        path = os.path.join(prefix, "lib", "librmw_introspect_cpp.so")
+        if prefix and os.path.exists(path):
+            return path
+    return None
+
+
+@dataclass
+class CacheStats:
+    """Entries on disk and lookups made through one IntrospectionCache."""
+
+    entries: int
+    size_bytes: int
+    hits: int
+    misses: int
+
+
+class IntrospectionCache:
+    """On-disk introspection results keyed by content hash; thread-safe."""
+
+    def __init__(self, directory: Optional[str] = None):
+        self.directory = directory or default_cache_dir()
+        self._results = os.path.join(self.directory, "results")
+        self._lock = threading.Lock()
+        self._file_digests: Optional[Dict[str, Tuple[List[int], str]]] = None
+        self._file_digests_dirty = False
+        self.hits = 0
+        self.misses = 0
+
+    def _digest_file(self, path: str) -> str:
+        """sha256 of a file, reusing the memo while its stat is unchanged."""
+        try:
+            st = os.stat(path)
+        except OSError:
+            return "missing"
+        stamp = [st.st_size, st.st_mtime_ns, st.st_ino]
+
+        with self._lock:
+            if self._file_digests is None:
+                self._file_digests = self._read_json(_FILE_INDEX) or {}
+            memo = self._file_digests.get(path)
+            if memo and memo[0] == stamp:
+                return memo[1]
+
+        digest = hashlib.sha256()
+        with open(path, "rb") as f:
+            for chunk in iter(lambda: f.read(1 << 20), b""):
+                digest.update(chunk)
+        with self._lock:
+            self._file_digests[path] = (stamp, digest.hexdigest())
+            self._file_digests_dirty = True
+        return digest.hexdigest()
+
+    def key(
+        self,
+        package: str,
+        executable_path: str,
+        *,
+        parameters: Optional[List[Dict[str, Any]]] = None,
+        remappings: Optional[List[Tuple[str, str]]] = None,
+        namespace: Optional[str] = None,
+        node_name: Optional[str] = None,
+        arguments: Optional[List[str]] = None,
+    ) -> str:
+        """Content hash of an executable and the options it is run with."""
+        files = [executable_path]
+        files += linked_libraries(executable_path)
+        files += _python_package_files(executable_path, package)
+        rmw = _rmw_library()
+        if rmw:
+            files.append(rmw)
+
+        material = {
+            "format": CACHE_FORMAT,
+            "distro": os.environ.get("ROS_DISTRO"),
+            "files": {path: self._digest_file(path) for path in files},
+            "parameters": parameters,
+            "remappings": [list(r) for r in remappings or []],
+            "namespace": namespace,
+            "node_name": node_name,
+            "arguments": arguments,
+        }
+        self._save_file_digests()
+        encoded = json.dumps(material, sort_keys=True, default=str)
+        return hashlib.sha256(encoded.encode()).hexdigest()
+
+    def _entry_path(self, key: str) -> str:
+        return os.path.join(self._results, key[:2], f"{key}.json")
+
+    def get(self, key: str) -> Optional[IntrospectionResult]:
+        """Stored result for key, None on a miss."""
+        from .introspector import _parse_introspection_data
+
+        try:
+            with open(self._entry_path(key), "r") as f:
+                entry = json.load(f)
+            result = _parse_introspection_data(entry["result"])
+        except (OSError, ValueError, KeyError, TypeError):
+            with self._lock:
+                self.misses += 1
+            return None
+        with self._lock:
+            self.hits += 1
+        return result
+
+    def put(self, key: str, result: IntrospectionResult, package: str, executable: str) -> None:
+        """Store a successful result; failures are always re-run."""
+        if not result.success:
+            return
+        entry = {
+            "format": CACHE_FORMAT,
+            "package": package,
+            "executable": executable,
+            "created": time.time(),
+            "result": asdict(result),
+        }
+        self._write_json(self._entry_path(key), entry)
+
+    def _entries(self) -> List[str]:
+        return glob.glob(os.path.join(self._results, "*", "*.json"))
+
+    def stats(self) -> CacheStats:
+        """Entries and bytes on disk, with this instance's hits and misses."""
+        entries = self._entries()
+        size = 0
+        for path in entries:
+            try:
+                size += os.path.getsize(path)
+            except OSError:
+                pass
+        return CacheStats(len(entries), size, self.hits, self.misses)
+
+    def invalidate(self, package: Optional[str] = None) -> int:
+        """
+        Remove the entries of one package, or every entry if package is None.
+
+        Returns:
+            Number of entries removed
+        """
+        removed = 0
+        for path in self._entries():
+            if package is not None:
+                try:
+                    with open(path, "r") as f:
+                        if json.load(f).get("package") != package:
+                            continue
+                except (OSError, ValueError):
+                    pass
+            try:
+                os.unlink(path)
+                removed += 1
+            except OSError:
+                pass
+        if package is None:
+            with self._lock:
+                self._file_digests = {}
+                self._file_digests_dirty = False
+            try:
+                os.unlink(os.path.join(self.directory, _FILE_INDEX))
+            except OSError:
+                pass
+        return removed
+
+    def _save_file_digests(self) -> None:
+        with self._lock:
+            if not self._file_digests_dirty:
+                return
+            self._file_digests_dirty = False
+            digests = dict(self._file_digests)
+        self._write_json(os.path.join(self.directory, _FILE_INDEX), digests)
+
+    def _read_json(self, name: str) -> Optional[Any]:
+        try:
+            with open(os.path.join(self.directory, name), "r") as f:
+                return json.load(f)
+        except (OSError, ValueError):
+            return None
+
+    @staticmethod
+    def _write_json(path: str, data: Any) -> None:
+        """Write atomically, so concurrent readers never see half a file."""
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        fd, tmp = tempfile.mkstemp(dir=os.path.dirname(path), suffix=".tmp")
+        try:
+            with os.fdopen(fd, "w") as f:
+                json.dump(data, f)
+            os.replace(tmp, path)
+        except OSError:
+            try:
+                os.unlink(tmp)
+            except OSError:
+                pass
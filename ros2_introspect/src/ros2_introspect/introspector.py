@@ -9,8 +9,10 @@ without running actual middleware communication.
 import json
 import logging
 import os
+import select
 import subprocess
 import tempfile
+import time
 from typing import Any, Dict, List, Optional, Tuple
 
 from .data import (
@@ -21,9 +23,26 @@ from .data import (
     ServiceInfo,
     SubscriptionInfo,
 )
+from .binary import is_binary_file, read_binary
+from .cache import IntrospectionCache
+from .stream import compact_event_stream, stream_output_path
 
 logger = logging.getLogger(__name__)
 
+# Exit codes of a node run with RMW_INTROSPECT_EXIT_ON_EXPORT (quiescence.hpp)
+EXIT_EXPORTED = 0
+EXIT_DEADLINE = 3
+EXIT_NO_NODE = 4
+EXIT_EXPORT_FAILED = 5
+
+# How long a node that signalled, or reached its deadline, gets to exit
+_SELF_EXIT_GRACE = 2.0
+
+# How long a node gets to shut down after SIGTERM. rclcpp's signal handler
+# triggers guard conditions that wake its executors in recording-only mode
+# too, so shutdown and the export take milliseconds rather than seconds
+_SIGTERM_GRACE = 1.0
+
 
 def check_rmw_introspect_available() -> Tuple[bool, Optional[str]]:
     """
@@ -79,6 +98,11 @@ def introspect_node(
     node_name: Optional[str] = None,
     arguments: Optional[List[str]] = None,
     timeout: float = 3.0,
+    output_format: str = "json",
+    quiescence_ms: int = 100,
+    domain_id: Optional[int] = None,
+    output_dir: Optional[str] = None,
+    cache: Optional[IntrospectionCache] = None,
 ) -> IntrospectionResult:
     """
     Introspect a ROS 2 node to discover its interfaces.
@@ -99,7 +123,15 @@ def introspect_node(
         namespace: Node namespace (e.g., "/robot1")
         node_name: Override node name
         arguments: Additional ROS arguments
-        timeout: Maximum time to wait for node initialization (seconds)
+        timeout: Maximum time to wait for node initialization (seconds). The
+            RMW signals as soon as the node has waited and then created no
+            entity for quiescence_ms, so this is only reached by nodes that
+            keep creating entities or never wait
+        output_format: Format the RMW writes, "json" or "binary"
+        quiescence_ms: Quiet time after which the node counts as initialized
+        domain_id: ROS_DOMAIN_ID for the node, the inherited one if None
+        output_dir: Directory for the RMW output files, /tmp if None
+        cache: Result cache to answer from and fill, None to always run the node
 
     Returns:
         IntrospectionResult with discovered interfaces or error information
@@ -116,13 +148,38 @@ def introspect_node(
     if not is_available:
         return IntrospectionResult(success=False, error=error_msg)
 
+    # Serve executables that have not changed from the cache
+    executable_path = _resolve_executable(package, executable)
+    cache_key = None
+    if cache is not None and executable_path:
+        cache_key = cache.key(
+            package,
+            executable_path,
+            parameters=parameters,
+            remappings=remappings,
+            namespace=namespace,
+            node_name=node_name,
+            arguments=arguments,
+        )
+        cached = cache.get(cache_key)
+        if cached is not None:
+            logger.debug(f"Cache hit for {package}/{executable}")
+            return cached
+
     # Create temporary file path for JSON output (don't open it yet)
     import uuid
 
-    output_path = f"/tmp/rmw_introspect_{uuid.uuid4().hex[:8]}.json"
+    output_path = os.path.join(
+        output_dir or "/tmp", f"rmw_introspect_{uuid.uuid4().hex[:8]}.json"
+    )
+    stream_path = stream_output_path(output_path)
+    # ros2 run closes inherited descriptors, so the ready pipe only reaches a
+    # node run directly; otherwise the node just exits after its export
+    ready_read, ready_write = os.pipe() if executable_path else (-1, -1)
 
     try:
-        # Build command
+        # Build command. The node is run directly when it can be found, as
+        # ros2 run would not pass the ready pipe on to it
         cmd = _build_ros2_command(
             package,
             executable,
@@ -131,50 +188,55 @@ def introspect_node(
             namespace=namespace,
             node_name=node_name,
             arguments=arguments,
+            executable_path=executable_path,
         )
 
-        # Use current environment (which should have ROS 2 sourced)
-        env = os.environ.copy()
-
-        # Set introspection environment variables
-        env["RMW_IMPLEMENTATION"] = "rmw_introspect_cpp"
-        env["RMW_INTROSPECT_OUTPUT"] = output_path
-        env["RMW_INTROSPECT_AUTO_EXPORT"] = "1"
+        env = _introspection_env(
+            output_path,
+            output_format,
+            quiescence_ms=quiescence_ms,
+            timeout=timeout,
+            ready_fd=ready_write if ready_write >= 0 else None,
+            domain_id=domain_id,
+        )
 
         logger.debug(f"Running command: {' '.join(cmd)}")
         logger.debug(f"Output path: {output_path}")
 
         # Run node with timeout using Popen for better control
-        import signal
-        import time
-
         proc = subprocess.Popen(
             cmd,
             env=env,
             stdout=subprocess.DEVNULL,
             stderr=subprocess.DEVNULL,
             start_new_session=True,  # Start in new process group
+            pass_fds=(ready_write,) if ready_write >= 0 else (),
         )
+        grace = _SELF_EXIT_GRACE
+        if ready_write >= 0:
+            os.close(ready_write)
+            ready_write = -1
+        else:
+            # Without the pipe, the deadline export is the latest exit
+            grace += timeout
 
         try:
-            # Wait for timeout
-            time.sleep(timeout)
-
-            # Node should still be running, send SIGTERM to entire process group
-            # This ensures both ros2 run wrapper and the actual node receive the signal
-            logger.debug(f"Sending SIGTERM to process group after {timeout}s")
-            os.killpg(os.getpgid(proc.pid), signal.SIGTERM)
-
-            # Wait for process to complete shutdown and export data (give it up to 5 seconds)
-            # ROS 2 shutdown sequence includes: signal handler → rclcpp shutdown → rmw_shutdown → export
+            # Wait for the quiescence signal, or for the timeout
+            if ready_read >= 0:
+                start = time.monotonic()
+                ready = _wait_for_ready(ready_read, timeout)
+                logger.debug(
+                    f"Node {'ready' if ready else 'not ready'} after "
+                    f"{time.monotonic() - start:.3f}s"
+                )
+
+            # The RMW exits right after its export; only a node that got
+            # neither there nor to the deadline needs to be signalled
             try:
-                returncode = proc.wait(timeout=5.0)
-                logger.debug(f"Process exited with code {returncode}")
+                returncode = proc.wait(timeout=grace)
             except subprocess.TimeoutExpired:
-                # If it doesn't exit cleanly, kill it
-                logger.debug("Process didn't exit after SIGTERM, sending SIGKILL")
-                proc.kill()
-                proc.wait()
+                returncode = _terminate(proc)
+            logger.debug(f"Process exited with code {returncode}")
 
         except Exception as e:
             # Clean up process if something goes wrong
@@ -187,7 +249,18 @@ def introspect_node(
                 success=False, error=f"Process management failed: {e}"
             )
 
-        # Read JSON output
+        if returncode == EXIT_NO_NODE:
+            return IntrospectionResult(
+                success=False,
+                error=f"Timed out after {timeout}s before any node was created",
+            )
+
+        # Read JSON output, falling back to the event stream if the node
+        # never reached its final export
+        if not os.path.exists(output_path) and os.path.exists(stream_path):
+            logger.debug(f"No final export, compacting {stream_path}")
+            return _parse_introspection_data(compact_event_stream(stream_path))
+
         if not os.path.exists(output_path):
             return IntrospectionResult(
                 success=False,
@@ -199,11 +272,17 @@ def introspect_node(
                 ),
             )
 
-        with open(output_path, "r") as f:
-            data = json.load(f)
+        if is_binary_file(output_path):
+            data = read_binary(output_path)
+        else:
+            with open(output_path, "r") as f:
+                data = json.load(f)
 
         # Parse introspection data
-        return _parse_introspection_data(data)
+        result = _parse_introspection_data(data)
+        if cache_key is not None:
+            cache.put(cache_key, result, package, executable)
+        return result
 
     except json.JSONDecodeError as e:
         return IntrospectionResult(
@@ -212,12 +291,107 @@ def introspect_node(
     except Exception as e:
         return IntrospectionResult(success=False, error=f"Introspection failed: {e}")
     finally:
-        # Cleanup temporary file
-        if os.path.exists(output_path):
-            try:
-                os.unlink(output_path)
-            except OSError:
-                pass
+        for fd in (ready_read, ready_write):
+            if fd >= 0:
+                os.close(fd)
+
+        # Cleanup temporary files
+        for path in (output_path, stream_path):
+            if os.path.exists(path):
+                try:
+                    os.unlink(path)
+                except OSError:
+                    pass
+
+
+def _terminate(proc: subprocess.Popen) -> int:
+    """Stop a node that did not exit by itself, returning its exit code."""
+    import signal
+
+    # Send SIGTERM to the entire process group. This ensures both the ros2 run
+    # wrapper and the actual node receive the signal
+    logger.debug("Sending SIGTERM to process group")
+    os.killpg(os.getpgid(proc.pid), signal.SIGTERM)
+
+    # Wait for process to complete shutdown and export data
+    # ROS 2 shutdown sequence includes: signal handler → rclcpp shutdown → rmw_shutdown → export
+    try:
+        return proc.wait(timeout=_SIGTERM_GRACE)
+    except subprocess.TimeoutExpired:
+        # If it doesn't exit cleanly, kill it
+        logger.debug("Process didn't exit after SIGTERM, sending SIGKILL")
+        proc.kill()
+        return proc.wait()
+
+
+def _resolve_executable(package: str, executable: str) -> Optional[str]:
+    """Find the file ros2 run would execute, None if it cannot be found."""
+    try:
+        from ament_index_python.packages import (
+            PackageNotFoundError,
+            get_package_prefix,
+        )
+    except ImportError:
+        return None
+    try:
+        prefix = get_package_prefix(package)
+    except (PackageNotFoundError, ValueError):
+        return None
+    path = os.path.join(prefix, "lib", package, executable)
+    if os.path.isfile(path) and os.access(path, os.X_OK):
+        return path
+    return None
+
+
+def _introspection_env(
+    output_path: str,
+    output_format: str,
+    *,
+    quiescence_ms: int,
+    timeout: float,
+    ready_fd: Optional[int],
+    domain_id: Optional[int] = None,
+) -> Dict[str, str]:
+    """
+    Build the environment of a node run under rmw_introspect_cpp.
+
+    The current environment, which should have ROS 2 sourced, plus the
+    introspection variables. RMW_INTROSPECT_READY_FD is set only when the
+    node inherits `ready_fd`; a number that names no pipe of ours could be
+    one of the node's own files.
+    """
+    env = os.environ.copy()
+    env["RMW_IMPLEMENTATION"] = "rmw_introspect_cpp"
+    env["RMW_INTROSPECT_OUTPUT"] = output_path
+    env["RMW_INTROSPECT_AUTO_EXPORT"] = "1"
+    env["RMW_INTROSPECT_FORMAT"] = output_format
+    # Also stream records as they are created, in case the node dies
+    # before its final export
+    env["RMW_INTROSPECT_STREAM"] = "1"
+    # Export and signal on the pipe once the node goes quiet, or at the
+    # timeout, then let the node exit by itself
+    env["RMW_INTROSPECT_QUIESCENCE_MS"] = str(quiescence_ms)
+    env.pop("RMW_INTROSPECT_READY_FD", None)
+    if ready_fd is not None:
+        env["RMW_INTROSPECT_READY_FD"] = str(ready_fd)
+    env["RMW_INTROSPECT_DEADLINE_MS"] = str(int(timeout * 1000))
+    env["RMW_INTROSPECT_EXIT_ON_EXPORT"] = "1"
+    if domain_id is not None:
+        env["ROS_DOMAIN_ID"] = str(domain_id)
+    return env
+
+
+def _wait_for_ready(ready_fd: int, timeout: float) -> bool:
+    """
+    Wait for the RMW's quiescence signal on the ready pipe.
+
+    Returns True when the node has exported and is idle, False on timeout
+    or when every write end closed without a signal (the node exited).
+    """
+    readable, _, _ = select.select([ready_fd], [], [], max(timeout, 0.0))
+    if not readable:
+        return False
+    return os.read(ready_fd, 1) == b"1"
 
 
 def _build_ros2_command(
@@ -229,9 +403,13 @@ def _build_ros2_command(
     namespace: Optional[str] = None,
     node_name: Optional[str] = None,
     arguments: Optional[List[str]] = None,
+    executable_path: Optional[str] = None,
 ) -> List[str]:
-    """Build ros2 run command with arguments."""
-    cmd = ["ros2", "run", package, executable]
+    """Build ros2 run command with arguments, or run executable_path directly."""
+    if executable_path:
+        cmd = [executable_path]
+    else:
+        cmd = ["ros2", "run", package, executable]
 
     # Add ROS arguments
     ros_args = []
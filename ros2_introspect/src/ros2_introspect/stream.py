@@ -0,0 +1,93 @@
+"""
+Compaction of the NDJSON event stream written by rmw_introspect_cpp.
+
+With RMW_INTROSPECT_STREAM=1 the RMW appends one JSON line per recorded
+entity to ``<output>.ndjson`` while the node runs. A node that crashes or is
+killed never writes its final document, but the stream holds everything up to
+the writer's last interval; compacting it yields the same document the RMW
+would have exported at shutdown.
+"""
+
+import json
+from typing import Any, Dict, List, Tuple
+
+_ENDPOINT_LISTS = {
+    "publisher": "publishers",
+    "subscription": "subscriptions",
+    "service": "services",
+    "client": "clients",
+}
+
+
+def stream_output_path(output_path: str) -> str:
+    """Path of the event stream next to an output path ("graph.json" -> "graph.ndjson")."""
+    if output_path.endswith(".json") and len(output_path) > len(".json"):
+        return output_path[: -len(".json")] + ".ndjson"
+    return output_path + ".ndjson"
+
+
+def read_event_stream(path: str) -> Tuple[Dict[str, Any], List[Dict[str, Any]]]:
+    """
+    Read an event stream.
+
+    A line cut short by a crash mid-write is skipped.
+
+    Returns:
+        Tuple of (header, events sorted by creation sequence)
+    """
+    header: Dict[str, Any] = {}
+    events: List[Dict[str, Any]] = []
+    with open(path, "r") as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                event = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+            if event.get("event") == "header":
+                header = event
+            elif "seq" in event:
+                events.append(event)
+    events.sort(key=lambda event: event["seq"])
+    return header, events
+
+
+def compact_event_stream(path: str) -> Dict[str, Any]:
+    """
+    Fold an event stream into the document export_to_json writes.
+
+    Like the shutdown export, every entity ever created is listed;
+    destructions are only counted, under "destroyed".
+    """
+    header, events = read_event_stream(path)
+
+    data: Dict[str, Any] = {
+        "format_version": header.get("format_version", "1.0"),
+        "timestamp": None,
+        "rmw_implementation": header.get("rmw_implementation", "rmw_introspect_cpp"),
+        "nodes": [],
+        "publishers": [],
+        "subscriptions": [],
+        "services": [],
+        "clients": [],
+        "destroyed": 0,
+        "compacted_from_stream": True,
+    }
+
+    for event in events:
+        kind = event.get("event")
+        if kind == "node":
+            data["nodes"].append(event["name"])
+        elif kind in _ENDPOINT_LISTS:
+            entry = {
+                key: value
+                for key, value in event.items()
+                if key not in ("seq", "event", "timestamp")
+            }
+            data[_ENDPOINT_LISTS[kind]].append(entry)
+        elif kind == "destroy":
+            data["destroyed"] += 1
+
+    return data
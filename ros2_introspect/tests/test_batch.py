@@ -0,0 +1,158 @@
+"""Tests for parallel batch introspection."""
+
+import threading
+import time
+
+import pytest
+
+from ros2_introspect import (
+    BatchTarget,
+    IntrospectionResult,
+    PublisherInfo,
+    QoSProfile,
+    ServiceInfo,
+    SubscriptionInfo,
+    discover_executables,
+    introspect_batch,
+    load_manifest,
+    merge_results,
+)
+from ros2_introspect import batch as batch_module
+
+QOS = QoSProfile("reliable", "volatile", "keep_last", 10)
+
+
+def _make_package(prefix, package, executables):
+    index = prefix / "share" / "ament_index" / "resource_index" / "packages"
+    index.mkdir(parents=True, exist_ok=True)
+    (index / package).write_text("")
+    lib = prefix / "lib" / package
+    lib.mkdir(parents=True, exist_ok=True)
+    for name in executables:
+        (lib / name).write_text("#!/bin/sh\n")
+        (lib / name).chmod(0o755)
+
+
+def test_discover_executables(tmp_path):
+    """Test that executables are found per package, overlays first."""
+    overlay, underlay = tmp_path / "overlay", tmp_path / "underlay"
+    _make_package(overlay, "demo", ["talker"])
+    _make_package(underlay, "demo", ["talker", "listener"])
+    _make_package(underlay, "tools", ["scan"])
+    (underlay / "lib" / "tools" / "data.yaml").write_text("")
+    (underlay / "lib" / "tools" / "plugins").mkdir()
+
+    targets = discover_executables(f"{overlay}:{underlay}:")
+    assert [(t.package, t.executable) for t in targets] == [
+        ("demo", "talker"),
+        ("tools", "scan"),
+    ]
+
+
+def test_load_manifest(tmp_path):
+    """Test both manifest layouts and the option shorthands."""
+    manifest = tmp_path / "system.yaml"
+    manifest.write_text(
+        "targets:\n"
+        "  - package: demo\n"
+        "    executable: talker\n"
+        "    namespace: /robot1\n"
+        "    remappings: {/chatter: /out}\n"
+        "    parameters: {rate: 10}\n"
+        "    timeout: 5\n"
+        "  - {package: demo, executable: listener, remappings: ['/in:=/out']}\n"
+    )
+    talker, listener = load_manifest(str(manifest))
+    assert talker.namespace == "/robot1"
+    assert talker.remappings == [("/chatter", "/out")]
+    assert talker.parameters == [{"rate": 10}]
+    assert talker.timeout == 5.0
+    assert listener.remappings == [("/in", "/out")]
+
+    manifest.write_text('[{"package": "demo", "executable": "talker"}]')
+    assert load_manifest(str(manifest))[0].label == "demo/talker"
+
+    manifest.write_text("- package: demo\n")
+    with pytest.raises(ValueError):
+        load_manifest(str(manifest))
+
+
+def test_introspect_batch_isolates_workers(monkeypatch):
+    """Test that concurrent targets never share a domain or output directory."""
+    lock = threading.Lock()
+    running = {}
+    overlaps = []
+    peak = [0]
+
+    def fake_introspect(package, executable, **kwargs):
+        key = (kwargs["domain_id"], kwargs["output_dir"])
+        with lock:
+            if any(k[0] == key[0] or k[1] == key[1] for k in running.values()):
+                overlaps.append(key)
+            running[executable] = key
+            peak[0] = max(peak[0], len(running))
+        time.sleep(0.02)
+        with lock:
+            del running[executable]
+        if executable == "broken":
+            raise RuntimeError("boom")
+        return IntrospectionResult(success=True, nodes=[f"/{executable}"])
+
+    monkeypatch.setattr(batch_module, "introspect_node", fake_introspect)
+    targets = [BatchTarget("demo", f"node_{i}") for i in range(12)]
+    targets.append(BatchTarget("demo", "broken"))
+
+    results = list(introspect_batch(targets, jobs=4, domain_base=10))
+    assert len(results) == len(targets)
+    assert not overlaps
+    assert 1 < peak[0] <= 4
+    failed = [r for r in results if not r.result.success]
+    assert [r.target.executable for r in failed] == ["broken"]
+    assert "boom" in failed[0].result.error
+
+    with pytest.raises(ValueError):
+        list(introspect_batch(targets, jobs=4, domain_base=230))
+
+
+def test_merge_results():
+    """Test that endpoints from different targets merge by name."""
+    talker = IntrospectionResult(
+        success=True,
+        nodes=["/talker"],
+        publishers=[PublisherInfo("/chatter", "std_msgs/msg/String", QOS, "talker", "/")],
+        services=[ServiceInfo("/reset", "std_srvs/srv/Empty", "talker", "/")],
+    )
+    listener = IntrospectionResult(
+        success=True,
+        nodes=["/robot/listener"],
+        subscriptions=[
+            SubscriptionInfo("/chatter", "std_msgs/msg/String", QOS, "listener", "/robot")
+        ],
+    )
+    failed = IntrospectionResult(success=False, error="timed out")
+
+    report = merge_results(
+        [
+            batch_module.BatchResult(BatchTarget("demo", "listener"), listener, 0.5),
+            batch_module.BatchResult(BatchTarget("demo", "talker"), talker, 0.25),
+            batch_module.BatchResult(BatchTarget("demo", "broken"), failed, 3.0),
+        ]
+    ).to_dict()
+
+    assert report["summary"] == {
+        "targets": 3,
+        "succeeded": 2,
+        "failed": 1,
+        "nodes": 2,
+        "topics": 1,
+        "services": 1,
+    }
+    assert report["nodes"] == ["/robot/listener", "/talker"]
+    assert report["topics"]["/chatter"] == {
+        "types": ["std_msgs/msg/String"],
+        "publishers": ["/talker"],
+        "subscribers": ["/robot/listener"],
+    }
+    assert report["services"]["/reset"]["servers"] == ["/talker"]
+    assert report["services"]["/reset"]["clients"] == []
+    assert [t["executable"] for t in report["targets"]] == ["broken", "listener", "talker"]
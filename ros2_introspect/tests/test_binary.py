@@ -0,0 +1,101 @@
+"""Tests for the binary introspection format reader."""
+
+import json
+import struct
+from pathlib import Path
+
+import pytest
+
+from ros2_introspect import BinaryIntrospection, read_binary
+from ros2_introspect.binary import BinaryFormatError, is_binary_file
+
+# export_to_json and export_to_binary output of the same recorded graph
+FIXTURES = Path(__file__).parent / "fixtures"
+
+
+def _align8(size):
+    return (size + 7) & ~7
+
+
+def _write_graph(path):
+    """Write one node with a publisher on /chatter, laid out like the RMW does."""
+    strings = ["", "/demo/talker", "talker", "/demo", "/chatter", "std_msgs/msg/String"]
+    data = b"".join(s.encode() + b"\0" for s in strings)
+    table = b""
+    offset = 0
+    for s in strings:
+        table += struct.pack("<II", offset, len(s))
+        offset += len(s) + 1
+    nodes = struct.pack("<II", 1, 0)
+    endpoints = struct.pack("<BBBBIIIIId", 1, 1, 2, 1, 10, 2, 3, 4, 5, 1.5)
+    index = struct.pack("<IIII", 4, 0, 1, 0)
+    refs = struct.pack("<I", 0)
+
+    sections = [table, data, nodes, endpoints, index, refs]
+    offsets = []
+    position = _align8(104)
+    for section in sections:
+        offsets.append(position)
+        position = _align8(position + len(section))
+
+    header = struct.pack(
+        "<8sHHIqQQQQQQIIIIIIII",
+        b"RMWINTRO", 1, 0, 104, 0, *offsets,
+        len(strings), len(data), 1, 8, 1, 32, 1, 1,
+    )
+    blob = bytearray(offsets[-1] + len(refs))
+    blob[: len(header)] = header
+    for start, section in zip(offsets, sections):
+        blob[start : start + len(section)] = section
+    path.write_bytes(bytes(blob))
+
+
+def test_read_binary(tmp_path):
+    """Test that records and the topic index read back as the JSON document."""
+    path = tmp_path / "graph.bin"
+    _write_graph(path)
+    assert is_binary_file(str(path))
+
+    data = read_binary(str(path))
+    assert data["nodes"] == ["/demo/talker"]
+    assert data["publishers"] == [
+        {
+            "node_name": "talker",
+            "node_namespace": "/demo",
+            "topic_name": "/chatter",
+            "message_type": "std_msgs/msg/String",
+            "qos": {
+                "reliability": "reliable",
+                "durability": "volatile",
+                "history": "keep_last",
+                "depth": 10,
+            },
+            "timestamp": 1.5,
+        }
+    ]
+
+    with BinaryIntrospection(str(path)) as binary:
+        assert [e["kind"] for e in binary.endpoints_on("/chatter")] == ["publisher"]
+        assert binary.endpoints_on("/other") == []
+
+
+def test_matches_json_export():
+    """Test that the binary export reads back as the JSON export's document."""
+    with open(FIXTURES / "graph.json") as f:
+        expected = json.load(f)
+    assert read_binary(str(FIXTURES / "graph.bin")) == expected
+
+
+def test_rejects_json_and_truncated_files(tmp_path):
+    """Test that files that are not binary introspection files are refused."""
+    json_path = tmp_path / "graph.json"
+    json_path.write_text('{"format_version": "1.0"}' + " " * 200)
+    assert not is_binary_file(str(json_path))
+    with pytest.raises(BinaryFormatError):
+        read_binary(str(json_path))
+
+    path = tmp_path / "graph.bin"
+    _write_graph(path)
+    path.write_bytes(path.read_bytes()[:-8])
+    with pytest.raises(BinaryFormatError):
+        read_binary(str(path))
@@ -0,0 +1,97 @@
+"""Tests for the content-addressed result cache."""
+
+import os
+import shutil
+
+from ros2_introspect import IntrospectionResult, PublisherInfo, QoSProfile
+from ros2_introspect.cache import IntrospectionCache, linked_libraries
+
+QOS = QoSProfile("reliable", "volatile", "keep_last", 10)
+
+
+def _install(tmp_path, package="demo", executable="talker"):
+    """Copy a real dynamic executable into an ament-style prefix."""
+    lib = tmp_path / "install" / "lib" / package
+    lib.mkdir(parents=True)
+    path = lib / executable
+    shutil.copy(shutil.which("true"), path)
+    return str(path)
+
+
+def _result():
+    return IntrospectionResult(
+        success=True,
+        nodes=["/talker"],
+        publishers=[PublisherInfo("/chatter", "std_msgs/msg/String", QOS, "talker", "/")],
+        format_version="1.0",
+    )
+
+
+def test_linked_libraries():
+    """Test that ldd output resolves to absolute library paths."""
+    libraries = linked_libraries(shutil.which("true"))
+    assert libraries
+    assert all(os.path.isabs(lib) for lib in libraries)
+    assert linked_libraries("/nonexistent") == []
+
+
+def test_key_tracks_inputs(tmp_path, monkeypatch):
+    """Test that the key changes with the binary, options and distro only."""
+    monkeypatch.setenv("ROS_DISTRO", "humble")
+    path = _install(tmp_path)
+    cache = IntrospectionCache(str(tmp_path / "cache"))
+
+    key = cache.key("demo", path, namespace="/a")
+    assert cache.key("demo", path, namespace="/a") == key
+    assert cache.key("demo", path, namespace="/b") != key
+    assert cache.key("demo", path, namespace="/a", remappings=[("/x", "/y")]) != key
+    assert cache.key("demo", path, namespace="/a", parameters=[{"rate": 1}]) != key
+
+    monkeypatch.setenv("ROS_DISTRO", "jazzy")
+    assert cache.key("demo", path, namespace="/a") != key
+    monkeypatch.setenv("ROS_DISTRO", "humble")
+
+    with open(path, "ab") as f:
+        f.write(b"\0")
+    assert cache.key("demo", path, namespace="/a") != key
+
+    # Digests survive in the cache directory for the next process
+    assert path in IntrospectionCache(str(tmp_path / "cache"))._read_json("files.json")
+
+
+def test_key_tracks_python_package(tmp_path):
+    """Test that script entry points hash the package code they run."""
+    lib = tmp_path / "lib" / "demo_py"
+    lib.mkdir(parents=True)
+    script = lib / "talker"
+    script.write_text("#!/usr/bin/python3\nfrom demo_py.talker import main\n")
+    module = tmp_path / "lib" / "python3.10" / "site-packages" / "demo_py"
+    module.mkdir(parents=True)
+    (module / "talker.py").write_text("TOPIC = '/chatter'\n")
+
+    cache = IntrospectionCache(str(tmp_path / "cache"))
+    key = cache.key("demo_py", str(script))
+    (module / "talker.py").write_text("TOPIC = '/other_topic'\n")
+    assert cache.key("demo_py", str(script)) != key
+
+
+def test_round_trip(tmp_path):
+    """Test hits, misses, failures and invalidation."""
+    cache = IntrospectionCache(str(tmp_path / "cache"))
+    assert cache.get("ab" * 32) is None
+
+    cache.put("ab" * 32, _result(), "demo", "talker")
+    cache.put("cd" * 32, _result(), "other", "node")
+    cache.put("ef" * 32, IntrospectionResult(success=False, error="boom"), "demo", "x")
+
+    hit = cache.get("ab" * 32)
+    assert hit == _result()
+    stats = cache.stats()
+    assert (stats.entries, stats.hits, stats.misses) == (2, 1, 1)
+    assert stats.size_bytes > 0
+
+    assert cache.invalidate("demo") == 1
+    assert cache.get("ab" * 32) is None
+    assert cache.get("cd" * 32) is not None
+    assert cache.invalidate() == 1
+    assert cache.stats().entries == 0
@@ -0,0 +1,98 @@
+"""Tests for the quiescence signal handling of introspect_node."""
+
+import os
+import signal
+import subprocess
+import time
+
+from ros2_introspect.introspector import (
+    _build_ros2_command,
+    _introspection_env,
+    _terminate,
+    _wait_for_ready,
+)
+
+
+def test_ready_signal():
+    """A '1' on the pipe returns right away."""
+    r, w = os.pipe()
+    try:
+        os.write(w, b"1")
+        start = time.monotonic()
+        assert _wait_for_ready(r, 5.0)
+        assert time.monotonic() - start < 1.0
+    finally:
+        os.close(r)
+        os.close(w)
+
+
+def test_ready_timeout():
+    """No signal waits for the whole timeout."""
+    r, w = os.pipe()
+    try:
+        start = time.monotonic()
+        assert not _wait_for_ready(r, 0.1)
+        assert time.monotonic() - start >= 0.1
+    finally:
+        os.close(r)
+        os.close(w)
+
+
+def test_ready_node_exited():
+    """A node that exits closes the pipe without signalling."""
+    r, w = os.pipe()
+    try:
+        os.close(w)
+        assert not _wait_for_ready(r, 5.0)
+    finally:
+        os.close(r)
+
+
+def test_command_runs_executable_directly():
+    """A resolved executable replaces ros2 run so the pipe is inherited."""
+    cmd = _build_ros2_command(
+        "demo_nodes_cpp",
+        "talker",
+        namespace="/demo",
+        executable_path="/opt/ros/lib/demo_nodes_cpp/talker",
+    )
+    assert cmd[0] == "/opt/ros/lib/demo_nodes_cpp/talker"
+    assert "--ros-args" in cmd
+    assert cmd[:3] != ["ros2", "run", "demo_nodes_cpp"]
+
+    cmd = _build_ros2_command("demo_nodes_cpp", "talker")
+    assert cmd[:4] == ["ros2", "run", "demo_nodes_cpp", "talker"]
+
+
+def test_env_ready_fd_only_with_pipe(monkeypatch):
+    """The ready fd is only passed to a node that inherits the pipe."""
+    monkeypatch.setenv("RMW_INTROSPECT_READY_FD", "7")
+    env = _introspection_env(
+        "/tmp/out.json", "json", quiescence_ms=100, timeout=2.0, ready_fd=None
+    )
+    assert "RMW_INTROSPECT_READY_FD" not in env
+    assert env["RMW_INTROSPECT_DEADLINE_MS"] == "2000"
+
+    env = _introspection_env(
+        "/tmp/out.json", "json", quiescence_ms=100, timeout=2.0, ready_fd=5
+    )
+    assert env["RMW_INTROSPECT_READY_FD"] == "5"
+
+
+def test_terminate_process_group():
+    """A node that never exits by itself is stopped with SIGTERM."""
+    proc = subprocess.Popen(["sleep", "30"], start_new_session=True)
+    start = time.monotonic()
+    assert _terminate(proc) == -signal.SIGTERM
+    assert time.monotonic() - start < 5.0
+
+
+def test_terminate_kills_after_grace():
+    """A node ignoring SIGTERM is killed once the short grace period passes."""
+    proc = subprocess.Popen(
+        ["sh", "-c", 'trap "" TERM; exec sleep 30'], start_new_session=True
+    )
+    time.sleep(0.2)
+    start = time.monotonic()
+    assert _terminate(proc) == -signal.SIGKILL
+    assert time.monotonic() - start < 3.0
@@ -0,0 +1,40 @@
+"""Tests for compacting the NDJSON event stream."""
+
+from ros2_introspect import compact_event_stream
+from ros2_introspect.introspector import _parse_introspection_data
+from ros2_introspect.stream import stream_output_path
+
+QOS = '{"reliability":"reliable","durability":"volatile","history":"keep_last","depth":10}'
+
+
+def test_compact_event_stream(tmp_path):
+    """Test that a stream cut off mid-line still yields its complete records."""
+    stream = tmp_path / "graph.ndjson"
+    stream.write_text(
+        '{"event":"header","format_version":"1.0","rmw_implementation":"rmw_introspect_cpp","pid":1}\n'
+        # Out of sequence order, as the writer drains one log at a time
+        '{"seq":3,"event":"subscription","node_name":"talker","node_namespace":"/",'
+        f'"topic_name":"/in","message_type":"std_msgs/msg/String","qos":{QOS},"timestamp":0.0}}\n'
+        '{"seq":1,"event":"node","name":"//talker"}\n'
+        '{"seq":2,"event":"publisher","node_name":"talker","node_namespace":"/",'
+        f'"topic_name":"/chatter","message_type":"std_msgs/msg/String","qos":{QOS},"timestamp":0.0}}\n'
+        '{"seq":4,"event":"destroy","kind":"subscription","record":3,"time_ns":5}\n'
+        '{"seq":5,"event":"publisher","node_name":"tal'
+    )
+
+    data = compact_event_stream(str(stream))
+    assert data["nodes"] == ["//talker"]
+    assert data["destroyed"] == 1
+    assert data["compacted_from_stream"] is True
+
+    result = _parse_introspection_data(data)
+    assert result.success
+    assert [p.topic_name for p in result.publishers] == ["/chatter"]
+    assert [s.topic_name for s in result.subscriptions] == ["/in"]
+    assert result.publishers[0].qos.depth == 10
+
+
+def test_stream_output_path():
+    """Test that the stream sits next to the output like the RMW puts it."""
+    assert stream_output_path("/tmp/graph.json") == "/tmp/graph.ndjson"
+    assert stream_output_path("/tmp/graph") == "/tmp/graph.ndjson"